@@ -1,10 +1,18 @@
 # bulk Si via Stillinger-Weber
 
+variable	x index 1
+variable	y index 1
+variable	z index 1
+
+variable	xx equal 20*$x
+variable	yy equal 20*$y
+variable	zz equal 10*$z
+
 units		metal
 atom_style	atomic
 
 lattice		diamond 5.431
-region		box block 0 20 0 20 0 10
+region		box block 0 ${xx} 0 ${yy} 0 ${zz}
 create_box	1 box
 create_atoms	1 box
 
@@ -0,0 +1,50 @@
+# LJ melt with frequent trajectory, restart, and data file I/O
+
+variable        x index 1
+variable        y index 1
+variable        z index 1
+variable        iodir index .
+
+variable        xx equal 20*$x
+variable        yy equal 20*$y
+variable        zz equal 20*$z
+
+units           lj
+atom_style      atomic
+
+lattice         fcc 0.8442
+region          box block 0 ${xx} 0 ${yy} 0 ${zz}
+create_box      1 box
+create_atoms    1 box
+mass            1 1.0
+
+velocity        all create 1.44 87287 loop geom
+
+pair_style      lj/cut 2.5
+pair_coeff      1 1 1.0 1.0 2.5
+
+neighbor        0.3 bin
+neigh_modify    delay 0 every 20 check no
+
+fix             1 all nve
+
+dump            1 all atom 10 ${iodir}/dump.bench.lammpstrj
+dump            2 all custom 10 ${iodir}/dump.bench.bin id type x y z vx vy vz
+restart         50 ${iodir}/restart.bench.*
+
+run             100
+
+undump          1
+undump          2
+write_data      ${iodir}/data.bench.io
+write_restart   ${iodir}/restart.bench.final
+
+# read data back and continue with a short run
+
+clear
+units           lj
+atom_style      atomic
+pair_style      lj/cut 2.5
+read_data       ${iodir}/data.bench.io
+fix             1 all nve
+run             10
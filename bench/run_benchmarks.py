@@ -0,0 +1,406 @@
+#!/usr/bin/env python3
+# ----------------------------------------------------------------------
+#   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+#   https://www.lammps.org/ Sandia National Laboratories
+#   LAMMPS development team: developers@lammps.org
+#
+#   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+#   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+#   certain rights in this software.  This software is distributed under
+#   the GNU General Public License.
+#
+#   See the README file in the top-level LAMMPS directory.
+# ----------------------------------------------------------------------
+"""
+Run the LAMMPS benchmark suite and write the results as JSON.
+
+The driver runs the inputs in this folder and in the POTENTIALS
+sub-folder in one of three modes:
+
+  fixed   the same problem size on the requested number of MPI tasks
+  scaled  the problem size grows with the number of MPI tasks
+  strong  the fixed size problem on a list of MPI task counts, with
+          speedup and parallel efficiency relative to the first entry
+
+For each run, the loop time, the performance line (ns/day or tau/day,
+timesteps/s, katom-step/s), the memory use per MPI rank, and the MPI
+task timing breakdown are extracted from the log file.  Benchmarks that
+require styles or style keywords which are not supported by the LAMMPS
+executable are reported as skipped.
+
+Example:
+
+  python3 run_benchmarks.py --lmp ../build/lmp --mode scaled --np 8 \\
+          --output results.json
+"""
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+
+BENCHDIR = os.path.dirname(os.path.abspath(__file__))
+POTDIR = os.path.join(BENCHDIR, 'POTENTIALS')
+
+class Benchmark:
+    """Description of a single benchmark problem"""
+    def __init__(self, name, folder, fixed, scaled, styles, dims=3, variables=None, info='',
+                 commands=None):
+        self.name = name
+        self.folder = folder
+        self.fixed = fixed
+        self.scaled = scaled
+        self.styles = styles
+        self.dims = dims
+        self.variables = variables if variables else {}
+        self.info = info
+        self.commands = commands if commands else []
+
+BENCHMARKS = [
+    Benchmark('lj', BENCHDIR, 'in.lj', 'in.lj', {'pair': ['lj/cut']},
+              info='atomic fluid, Lennard-Jones'),
+    Benchmark('chain', BENCHDIR, 'in.chain', 'in.chain.scaled',
+              {'pair': ['lj/cut'], 'bond': ['fene'], 'fix': ['langevin']},
+              info='bead-spring polymer melt, FENE bonds'),
+    Benchmark('eam', BENCHDIR, 'in.eam', 'in.eam', {'pair': ['eam']},
+              info='metallic solid, Cu EAM'),
+    Benchmark('eam-packed', BENCHDIR, 'in.eam.packed', 'in.eam.packed', {'pair': ['eam']},
+              info='metallic solid, Cu EAM with packed spline tables',
+              commands=['pair_style eam packed yes']),
+    Benchmark('chute', BENCHDIR, 'in.chute', 'in.chute.scaled',
+              {'pair': ['gran/hooke/history'], 'fix': ['nve/sphere']}, dims=2,
+              info='granular chute flow'),
+    Benchmark('rhodo', BENCHDIR, 'in.rhodo', 'in.rhodo.scaled',
+              {'pair': ['lj/charmm/coul/long'], 'kspace': ['pppm'], 'fix': ['shake']},
+              info='rhodopsin protein, CHARMM with PPPM'),
+    Benchmark('tersoff', POTDIR, 'in.tersoff', 'in.tersoff', {'pair': ['tersoff']},
+              info='Si, Tersoff manybody potential'),
+    Benchmark('sw', POTDIR, 'in.sw', 'in.sw', {'pair': ['sw']},
+              info='Si, Stillinger-Weber manybody potential'),
+    Benchmark('snap', POTDIR, 'in.snap', 'in.snap', {'pair': ['snap']},
+              info='Cu, SNAP machine learning potential'),
+    Benchmark('pace', POTDIR, 'in.pace', 'in.pace', {'pair': ['pace']},
+              info='Cu, ACE machine learning potential'),
+    Benchmark('reaxff', POTDIR, 'in.reaxc', 'in.reaxc',
+              {'pair': ['reaxff'], 'fix': ['qeq/reaxff']},
+              info='PETN crystal, ReaxFF with charge equilibration'),
+    Benchmark('pppm-1e-5', BENCHDIR, 'in.rhodo', 'in.rhodo.scaled',
+              {'pair': ['lj/charmm/coul/long'], 'kspace': ['pppm'], 'fix': ['shake']},
+              variables={'accuracy': '1e-5'}, info='rhodopsin with PPPM accuracy 1e-5'),
+    Benchmark('pppm-1e-6', BENCHDIR, 'in.rhodo', 'in.rhodo.scaled',
+              {'pair': ['lj/charmm/coul/long'], 'kspace': ['pppm'], 'fix': ['shake']},
+              variables={'accuracy': '1e-6'}, info='rhodopsin with PPPM accuracy 1e-6'),
+    Benchmark('granular', POTDIR, 'in.granular', 'in.granular',
+              {'pair': ['gran/hooke/history'], 'fix': ['nve/sphere', 'freeze']}, dims=2,
+              info='granular chute flow with frozen bottom layer'),
+    Benchmark('rigid', BENCHDIR, 'in.rigid', 'in.rigid',
+              {'atom': ['molecular'], 'fix': ['rigid/small']},
+              info='LJ fluid of rigid tetrahedral clusters'),
+    Benchmark('io', BENCHDIR, 'in.io', 'in.io', {'pair': ['lj/cut']},
+              info='LJ melt with dump, restart, write_data, and read_data'),
+]
+
+# ----------------------------------------------------------------------
+
+def get_styles(lmp):
+    """Collect the names of all styles from the help message of the LAMMPS executable"""
+    try:
+        output = subprocess.run(lmp + ['-h'], stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                                universal_newlines=True, check=False).stdout
+    except OSError as e:
+        sys.exit(f"Cannot run LAMMPS executable {' '.join(lmp)}: {e}")
+
+    styles = {}
+    section = None
+    for line in output.splitlines():
+        m = re.match(r'^\* (\S+) styles:?', line)
+        if m:
+            section = m.group(1).lower()
+            styles[section] = set()
+        elif line.startswith('*'):
+            section = None
+        elif section:
+            styles[section].update(line.split())
+    version = re.search(r'^Large-scale Atomic/Molecular Massively Parallel Simulator - (.*)$',
+                        output, re.MULTILINE)
+    return styles, version.group(1).strip() if version else 'unknown'
+
+def missing_styles(bench, styles):
+    """Return list of styles required by a benchmark that are not available"""
+    missing = []
+    for kind, names in bench.styles.items():
+        for name in names:
+            if name not in styles.get(kind, set()):
+                missing.append(f'{kind} style {name}')
+    return missing
+
+def unsupported_commands(args, bench, workdir):
+    """Return list of commands required by a benchmark that the LAMMPS executable rejects"""
+    rejected = []
+    for num, command in enumerate(bench.commands):
+        infile = os.path.join(workdir, f'in.{bench.name}.probe{num}')
+        with open(infile, 'w', encoding='utf-8') as f:
+            f.write(command + '\n')
+        cmd = args.lmp + ['-in', infile, '-log', 'none', '-nocite'] + shlex.split(args.extra)
+        try:
+            proc = subprocess.run(cmd, cwd=workdir, stdout=subprocess.PIPE,
+                                  stderr=subprocess.PIPE, universal_newlines=True,
+                                  timeout=args.timeout, check=False)
+            if proc.returncode != 0 or re.search(r'^ERROR', proc.stdout + proc.stderr,
+                                                 re.MULTILINE):
+                rejected.append(f"support for '{command}'")
+        except subprocess.TimeoutExpired:
+            rejected.append(f"support for '{command}'")
+        os.remove(infile)
+    return rejected
+
+def factorize(nprocs, dims):
+    """Split the number of MPI tasks into a near cubic (or square) grid"""
+    best = None
+    for px in range(1, nprocs + 1):
+        if nprocs % px: continue
+        rest = nprocs // px
+        for py in range(1, rest + 1):
+            if rest % py: continue
+            pz = rest // py
+            if dims == 2 and pz != 1: continue
+            grid = (px, py, pz)
+            spread = max(grid[:dims]) - min(grid[:dims])
+            if best is None or spread < best[0]:
+                best = (spread, grid)
+    return best[1]
+
+# ----------------------------------------------------------------------
+
+def parse_log(text):
+    """Extract performance data of the first run from the text of a log file"""
+    data = {}
+    m = re.search(r'^LAMMPS \((.*)\)', text, re.MULTILINE)
+    if m: data['version'] = m.group(1)
+
+    m = re.search(r'^Loop time of (\S+) on (\d+) procs for (\d+) steps with (\d+) atoms',
+                  text, re.MULTILINE)
+    if not m: return data
+    data['loop_time'] = float(m.group(1))
+    data['nprocs'] = int(m.group(2))
+    data['nsteps'] = int(m.group(3))
+    data['natoms'] = int(m.group(4))
+    head, tail = text[:m.start()], text[m.end():]
+
+    # memory use is printed before the run starts
+
+    mem = re.findall(r'Per MPI rank memory allocation \(min/avg/max\) = (\S+) \| (\S+) \| (\S+) Mbytes',
+                     head)
+    if mem:
+        data['memory'] = dict(zip(['min', 'avg', 'max'], [float(x) for x in mem[-1]]))
+
+    m = re.search(r'^Performance: (.*)$', tail, re.MULTILINE)
+    if m:
+        perf = {}
+        for item in m.group(1).split(','):
+            val = item.split()
+            if len(val) == 2: perf[val[1]] = float(val[0])
+        data['performance'] = perf
+
+    m = re.search(r'^(\S+)% CPU use with (\d+) MPI tasks x (\d+) OpenMP threads', tail,
+                  re.MULTILINE)
+    if m:
+        data['cpu_use'] = float(m.group(1))
+        data['nthreads'] = int(m.group(3))
+
+    # MPI task timing breakdown table. rows end at the first empty line.
+
+    lines = tail.splitlines()
+    for i, line in enumerate(lines):
+        if line.startswith('MPI task timing breakdown:'):
+            header = [c.strip() for c in lines[i + 1].split('|')]
+            timers = {}
+            for row in lines[i + 3:]:
+                if not row.strip(): break
+                cols = [c.strip() for c in row.split('|')]
+                entry = {}
+                for key, val in zip(header[1:], cols[1:]):
+                    key = key.replace(' time', '').lstrip('%')
+                    entry[key] = float(val) if val else None
+                timers[cols[0]] = entry
+            data['timers'] = timers
+            break
+
+    m = re.search(r'^Neighbor list builds = (\d+)', tail, re.MULTILINE)
+    if m: data['neighbor_builds'] = int(m.group(1))
+    m = re.search(r'^Dangerous builds = (\d+)', tail, re.MULTILINE)
+    if m: data['dangerous_builds'] = int(m.group(1))
+
+    m = re.search(r'^Total wall time: (\d+):(\d+):(\d+)', text, re.MULTILINE)
+    if m:
+        data['wall_time'] = int(m.group(1)) * 3600 + int(m.group(2)) * 60 + int(m.group(3))
+    return data
+
+def run_benchmark(args, bench, mode, nprocs, workdir):
+    """Run a single benchmark and return a dictionary with its results"""
+    result = {'name': bench.name, 'mode': mode, 'nprocs': nprocs, 'info': bench.info}
+    variables = dict(bench.variables)
+    if mode == 'scaled':
+        grid = factorize(nprocs, bench.dims)
+        variables.update(dict(zip(['x', 'y', 'z'], [str(p) for p in grid[:bench.dims]])))
+        infile = bench.scaled
+    else:
+        infile = bench.fixed
+    if bench.name == 'io':
+        variables['iodir'] = workdir
+
+    logfile = os.path.join(workdir, f'log.{bench.name}.{mode}.{nprocs}')
+    cmd = []
+    if args.mpicmd:
+        cmd += shlex.split(args.mpicmd.format(np=nprocs))
+    elif nprocs > 1:
+        result.update({'status': 'skipped', 'reason': 'no MPI launcher for parallel run'})
+        return result
+    cmd += args.lmp + ['-in', infile, '-log', logfile, '-screen', 'none', '-nocite']
+    for key, val in variables.items():
+        cmd += ['-var', key, val]
+    cmd += shlex.split(args.extra)
+    result['command'] = ' '.join(shlex.quote(c) for c in cmd)
+
+    try:
+        proc = subprocess.run(cmd, cwd=bench.folder, stdout=subprocess.PIPE,
+                              stderr=subprocess.PIPE, universal_newlines=True,
+                              timeout=args.timeout, check=False)
+    except subprocess.TimeoutExpired:
+        result.update({'status': 'failed', 'reason': f'timeout after {args.timeout} seconds'})
+        return result
+
+    text = ''
+    if os.path.exists(logfile):
+        with open(logfile, encoding='utf-8', errors='replace') as f:
+            text = f.read()
+    data = parse_log(text)
+    if proc.returncode != 0 or 'loop_time' not in data:
+        error = re.findall(r'^ERROR.*$', text + proc.stdout + proc.stderr, re.MULTILINE)
+        reason = error[-1] if error else f'exit code {proc.returncode}'
+        result.update({'status': 'failed', 'reason': reason})
+        return result
+    if 'performance' not in data:
+        result.update({'status': 'failed', 'reason': 'no Performance line in log file'})
+        return result
+    result['status'] = 'ok'
+    result.update(data)
+    return result
+
+# ----------------------------------------------------------------------
+
+def main():
+    parser = argparse.ArgumentParser(description='Run the LAMMPS benchmark suite')
+    parser.add_argument('--lmp', default='lmp',
+                        help='LAMMPS executable with optional flags (default: lmp)')
+    parser.add_argument('--mpicmd', default='mpirun -np {np}',
+                        help="MPI launcher, {np} is replaced by the number of MPI tasks. "
+                        "Use '' to run without launcher (default: 'mpirun -np {np}')")
+    parser.add_argument('--mode', choices=['fixed', 'scaled', 'strong'], default='fixed',
+                        help='benchmark mode (default: fixed)')
+    parser.add_argument('--np', type=int, default=1,
+                        help='number of MPI tasks for fixed and scaled mode (default: 1)')
+    parser.add_argument('--np-list', default='1,2,4',
+                        help='comma separated MPI task counts for strong mode (default: 1,2,4)')
+    parser.add_argument('--only', default='',
+                        help='comma separated list of benchmarks to run (default: all)')
+    parser.add_argument('--extra', default='',
+                        help="additional LAMMPS command line flags, e.g. '-sf omp -pk omp 2'")
+    parser.add_argument('--timeout', type=float, default=3600.0,
+                        help='timeout per run in seconds (default: 3600)')
+    parser.add_argument('--workdir', default=None,
+                        help='folder for log and output files (default: temporary folder)')
+    parser.add_argument('--output', default='bench-results.json',
+                        help='name of JSON output file (default: bench-results.json)')
+    parser.add_argument('--list', action='store_true', help='list benchmarks and exit')
+    args = parser.parse_args()
+
+    if args.list:
+        for bench in BENCHMARKS:
+            print(f'{bench.name:<12s} {bench.info}')
+        return 0
+
+    args.lmp = shlex.split(args.lmp)
+    args.lmp[0] = os.path.abspath(shutil.which(args.lmp[0]) or args.lmp[0])
+    benchmarks = BENCHMARKS
+    if args.only:
+        names = args.only.split(',')
+        unknown = [n for n in names if n not in [b.name for b in BENCHMARKS]]
+        if unknown: sys.exit(f"Unknown benchmark(s): {', '.join(unknown)}")
+        benchmarks = [b for b in BENCHMARKS if b.name in names]
+
+    if args.mode == 'strong':
+        nplist = [int(n) for n in args.np_list.split(',')]
+    else:
+        nplist = [args.np]
+
+    # potential files not in the bench folders are taken from the potentials folder
+    potentials = os.path.join(os.path.dirname(BENCHDIR), 'potentials')
+    if os.path.isdir(potentials) and 'LAMMPS_POTENTIALS' not in os.environ:
+        os.environ['LAMMPS_POTENTIALS'] = potentials
+
+    styles, version = get_styles(args.lmp)
+    workdir = args.workdir if args.workdir else tempfile.mkdtemp(prefix='lammps-bench-')
+    os.makedirs(workdir, exist_ok=True)
+    workdir = os.path.abspath(workdir)
+
+    results = []
+    print(f'{"Benchmark":<12s} {"Mode":<7s} {"Procs":>5s} {"Atoms":>9s} {"Loop time":>10s} '
+          f'{"Performance":>22s}  Status')
+    for bench in benchmarks:
+        missing = missing_styles(bench, styles)
+        if not missing: missing = unsupported_commands(args, bench, workdir)
+        reference = None
+        for nprocs in nplist:
+            if missing:
+                result = {'name': bench.name, 'mode': args.mode, 'nprocs': nprocs,
+                          'info': bench.info, 'status': 'skipped',
+                          'reason': 'missing ' + ', '.join(missing)}
+            else:
+                result = run_benchmark(args, bench, args.mode, nprocs, workdir)
+            if args.mode == 'strong' and result['status'] == 'ok':
+                if reference is None: reference = result
+                speedup = reference['loop_time'] / result['loop_time']
+                result['speedup'] = speedup
+                result['efficiency'] = speedup * reference['nprocs'] / nprocs
+            results.append(result)
+
+            perf = ''
+            if result['status'] == 'ok':
+                performance = result.get('performance', {})
+                unit = 'ns/day' if 'ns/day' in performance else 'tau/day'
+                perf = f"{performance.get(unit, 0.0):.4g} {unit}"
+                print(f"{bench.name:<12s} {args.mode:<7s} {nprocs:>5d} {result['natoms']:>9d} "
+                      f"{result['loop_time']:>10.4g} {perf:>22s}  ok")
+            else:
+                print(f"{bench.name:<12s} {args.mode:<7s} {nprocs:>5d} {'':>9s} {'':>10s} "
+                      f"{'':>22s}  {result['status']}: {result['reason']}")
+
+    report = {
+        'lammps_version': version,
+        'executable': ' '.join(args.lmp),
+        'mpicmd': args.mpicmd,
+        'extra': args.extra,
+        'mode': args.mode,
+        'date': datetime.datetime.now().isoformat(timespec='seconds'),
+        'host': platform.node(),
+        'machine': platform.machine(),
+        'system': platform.platform(),
+        'results': results,
+    }
+    with open(args.output, 'w', encoding='utf-8') as f:
+        json.dump(report, f, indent=2)
+    print(f'Wrote results to {args.output}')
+
+    if not args.workdir: shutil.rmtree(workdir, ignore_errors=True)
+    return 1 if any(r['status'] == 'failed' for r in results) else 0
+
+if __name__ == '__main__':
+    sys.exit(main())
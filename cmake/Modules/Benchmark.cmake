@@ -0,0 +1,33 @@
+###############################################################################
+# Benchmark suite
+###############################################################################
+find_package(Python3 COMPONENTS Interpreter)
+
+if(Python3_EXECUTABLE)
+  if(Python3_VERSION VERSION_GREATER_EQUAL 3.6)
+    set(BENCH_MODE_VALUES fixed scaled strong)
+    set(BENCH_MODE fixed CACHE STRING "Mode of the 'bench' target (fixed, scaled, strong)")
+    set_property(CACHE BENCH_MODE PROPERTY STRINGS ${BENCH_MODE_VALUES})
+    validate_option(BENCH_MODE BENCH_MODE_VALUES)
+    set(BENCH_NUM_PROCS 1 CACHE STRING "Number of MPI tasks for the 'bench' target in fixed and scaled mode")
+    set(BENCH_NUM_PROCS_LIST "1,2,4" CACHE STRING "Comma separated MPI task counts for the 'bench' target in strong mode")
+    set(BENCH_ARGS "" CACHE STRING "Additional LAMMPS command line flags for the 'bench' target")
+    mark_as_advanced(BENCH_NUM_PROCS BENCH_NUM_PROCS_LIST BENCH_ARGS)
+
+    if(BUILD_MPI)
+      set(BENCH_MPICMD "${MPIEXEC_EXECUTABLE} ${MPIEXEC_NUMPROC_FLAG} {np} ${MPIEXEC_PREFLAGS}")
+    else()
+      set(BENCH_MPICMD "")
+    endif()
+    add_custom_target(
+      bench
+      ${Python3_EXECUTABLE} ${LAMMPS_DIR}/bench/run_benchmarks.py --lmp $<TARGET_FILE:lmp>
+      --mpicmd "${BENCH_MPICMD}" --mode ${BENCH_MODE} --np ${BENCH_NUM_PROCS}
+      --np-list ${BENCH_NUM_PROCS_LIST} --extra "${BENCH_ARGS}"
+      --output ${CMAKE_BINARY_DIR}/bench-results.json
+      DEPENDS lmp
+      WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+      COMMENT "Run LAMMPS benchmark suite"
+      VERBATIM)
+  endif()
+endif()
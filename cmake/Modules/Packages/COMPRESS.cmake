@@ -5,6 +5,7 @@ if(NOT ZLIB_FOUND)
   return()
 endif()
 target_link_libraries(lammps PRIVATE ZLIB::ZLIB)
+target_compile_definitions(lammps PRIVATE -DLAMMPS_ZLIB)
 
 find_package(PkgConfig QUIET)
 if(PkgConfig_FOUND)
@@ -275,6 +275,9 @@ class lammps(object):
     self.lib.lammps_last_thermo.argtypes = [c_void_p, c_char_p, c_int]
     self.lib.lammps_last_thermo.restype = c_void_p
 
+    self.lib.lammps_get_instance_time.argtypes = [c_void_p, c_char_p, c_char_p]
+    self.lib.lammps_get_instance_time.restype = c_double
+
     self.lib.lammps_encode_image_flags.restype = self.c_imageint
 
     self.lib.lammps_config_has_package.argtypes = [c_char_p]
@@ -817,6 +820,25 @@ class lammps(object):
 
   # -------------------------------------------------------------------------
 
+  def get_instance_time(self, category, id):
+    """Get wall time spent in a fix or compute on this MPI process
+
+    This is a wrapper around the :cpp:func:`lammps_get_instance_time`
+    function of the C-library interface.  Times are only collected
+    after enabling them with the "timer instance" command.
+
+    :param category: either "fix" or "compute"
+    :type category: string
+    :param id: ID of the fix or compute
+    :type id: string
+    :return: accumulated wall time or -1.0 if the fix or compute does not exist
+    :rtype: double
+    """
+    with ExceptionCheck(self):
+      return self.lib.lammps_get_instance_time(self.lmp, category.encode(), id.encode())
+
+  # -------------------------------------------------------------------------
+
   def extract_setting(self, name):
     """Query LAMMPS about global settings that can be expressed as an integer.
 
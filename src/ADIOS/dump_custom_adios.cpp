@@ -60,6 +60,9 @@ class DumpCustomADIOSInternal {
 
 DumpCustomADIOS::DumpCustomADIOS(LAMMPS *lmp, int narg, char **arg) : DumpCustom(lmp, narg, arg)
 {
+  async_allow = 0;
+  mpiio_allow = 0;
+
   // create a default adios2_config.xml if it doesn't exist yet.
   FILE *cfgfp = fopen("adios2_config.xml", "r");
   if (!cfgfp) {
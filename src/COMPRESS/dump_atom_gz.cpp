@@ -25,6 +25,8 @@ using namespace LAMMPS_NS;
 DumpAtomGZ::DumpAtomGZ(LAMMPS *lmp, int narg, char **arg) : DumpAtom(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump atom/gz only writes compressed files");
+  async_allow = 0;
+  mpiio_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -147,13 +149,19 @@ void DumpAtomGZ::write_data(int n, double *mybuf)
 
 void DumpAtomGZ::write()
 {
-  DumpAtom::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
+  // the writer reports failures of its compression threads via exceptions
+
+  try {
+    DumpAtom::write();
+    if (filewriter) {
+      if (multifile) {
+        writer.close();
+      } else {
+        if (flush_flag && writer.isopen()) { writer.flush(); }
+      }
     }
+  } catch (FileWriterException &e) {
+    error->one(FLERR, "Error writing dump {}: {}", id, e.what());
   }
 }
 
@@ -169,6 +177,10 @@ int DumpAtomGZ::modify_param(int narg, char **arg)
         int compression_level = utils::inumeric(FLERR, arg[1], false, lmp);
         writer.setCompressionLevel(compression_level);
         return 2;
+      } else if (strcmp(arg[0], "compression_threads") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        writer.setNumThreads(utils::inumeric(FLERR, arg[1], false, lmp));
+        return 2;
       }
     } catch (FileWriterException &e) {
       error->one(FLERR, "Illegal dump_modify command: {}", e.what());
@@ -31,6 +31,8 @@ using namespace LAMMPS_NS;
 DumpAtomZstd::DumpAtomZstd(LAMMPS *lmp, int narg, char **arg) : DumpAtom(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump atom/zstd only writes compressed files");
+  async_allow = 0;
+  mpiio_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -178,6 +180,10 @@ int DumpAtomZstd::modify_param(int narg, char **arg)
         if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
         writer.setCompressionLevel(utils::inumeric(FLERR, arg[1], false, lmp));
         return 2;
+      } else if (strcmp(arg[0], "compression_threads") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        writer.setNumThreads(utils::inumeric(FLERR, arg[1], false, lmp));
+        return 2;
       }
     } catch (FileWriterException &e) {
       error->one(FLERR, "Illegal dump_modify command: {}", e.what());
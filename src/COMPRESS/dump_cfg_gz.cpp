@@ -27,6 +27,8 @@ static constexpr double UNWRAPEXPAND = 10.0;
 DumpCFGGZ::DumpCFGGZ(LAMMPS *lmp, int narg, char **arg) : DumpCFG(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump cfg/gz only writes compressed files");
+  async_allow = 0;
+  mpiio_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -190,13 +192,19 @@ void DumpCFGGZ::write_data(int n, double *mybuf)
 
 void DumpCFGGZ::write()
 {
-  DumpCFG::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
+  // the writer reports failures of its compression threads via exceptions
+
+  try {
+    DumpCFG::write();
+    if (filewriter) {
+      if (multifile) {
+        writer.close();
+      } else {
+        if (flush_flag && writer.isopen()) { writer.flush(); }
+      }
     }
+  } catch (FileWriterException &e) {
+    error->one(FLERR, "Error writing dump {}: {}", id, e.what());
   }
 }
 
@@ -212,6 +220,10 @@ int DumpCFGGZ::modify_param(int narg, char **arg)
         int compression_level = utils::inumeric(FLERR, arg[1], false, lmp);
         writer.setCompressionLevel(compression_level);
         return 2;
+      } else if (strcmp(arg[0], "compression_threads") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        writer.setNumThreads(utils::inumeric(FLERR, arg[1], false, lmp));
+        return 2;
       }
     } catch (FileWriterException &e) {
       error->one(FLERR, "Illegal dump_modify command: {}", e.what());
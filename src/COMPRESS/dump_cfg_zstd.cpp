@@ -33,6 +33,8 @@ static constexpr double UNWRAPEXPAND = 10.0;
 DumpCFGZstd::DumpCFGZstd(LAMMPS *lmp, int narg, char **arg) : DumpCFG(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump cfg/zstd only writes compressed files");
+  async_allow = 0;
+  mpiio_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -223,6 +225,10 @@ int DumpCFGZstd::modify_param(int narg, char **arg)
         if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
         writer.setCompressionLevel(utils::inumeric(FLERR, arg[1], false, lmp));
         return 2;
+      } else if (strcmp(arg[0], "compression_threads") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        writer.setNumThreads(utils::inumeric(FLERR, arg[1], false, lmp));
+        return 2;
       }
     } catch (FileWriterException &e) {
       error->one(FLERR, e.what());
@@ -0,0 +1,215 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "dump_custom_quant.h"
+
+#include "domain.h"
+#include "error.h"
+#include "update.h"
+
+#include <cmath>
+#include <cstring>
+#include <zlib.h>
+
+using namespace LAMMPS_NS;
+
+// largest quantized value, so that differences of two values fit into int64_t
+
+static constexpr double MAXQUANT = 4.0e18;
+
+/* ---------------------------------------------------------------------- */
+
+DumpCustomQuant::DumpCustomQuant(LAMMPS *lmp, int narg, char **arg) :
+  DumpCustom(lmp, narg, arg), tolerance(1.0e-4), compression_level(Z_DEFAULT_COMPRESSION)
+{
+  if (compressed)
+    error->all(FLERR,"Dump custom/quant cannot write to a compressed file");
+  if (multiproc)
+    error->all(FLERR,"Dump custom/quant cannot write multi-processor files");
+
+  // snapshots are written as binary data, so data is never converted to strings
+
+  binary = 1;
+  buffer_allow = 0;
+  buffer_flag = 0;
+  async_allow = 0;
+  mpiio_allow = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpCustomQuant::init_style()
+{
+  DumpCustom::init_style();
+
+  if (triclinic_general)
+    error->all(FLERR,"Dump custom/quant does not support general triclinic output");
+
+  // atom coordinates are quantized relative to the box length
+
+  quantdim.assign(size_one,-1);
+  int icol = 0;
+  for (const auto &name : utils::split_words(columns_default)) {
+    if (vtype[icol] == Dump::STRING)
+      error->all(FLERR,"Dump custom/quant does not support string column {}", name);
+    if ((name == "x") || (name == "xu")) quantdim[icol] = 0;
+    else if ((name == "y") || (name == "yu")) quantdim[icol] = 1;
+    else if ((name == "z") || (name == "zu")) quantdim[icol] = 2;
+    ++icol;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   nothing to do, since every snapshot needs its header to be read back
+   it is written together with the data in write_footer()
+   so this is independent of the dump_modify header setting
+------------------------------------------------------------------------- */
+
+void DumpCustomQuant::write_header(bigint /*n*/) {}
+
+/* ----------------------------------------------------------------------
+   collect per-atom data of all procs, frame is empty at start of a snapshot
+------------------------------------------------------------------------- */
+
+void DumpCustomQuant::write_data(int n, double *mybuf)
+{
+  if (frame.empty()) frame.reserve(ntotal*size_one);
+  frame.insert(frame.end(),mybuf,mybuf + (bigint) n*size_one);
+}
+
+/* ----------------------------------------------------------------------
+   quantize, encode and write the snapshot collected from all procs
+   columns are quantized with step = tolerance * box length for coordinates
+     and step = tolerance * range of values for other floating point columns
+   integer columns are stored exactly
+   quantized values are delta encoded along the atom order, which follows
+     the spatial sorting of atoms, then stored as zigzag varints per column
+     and compressed with zlib
+------------------------------------------------------------------------- */
+
+void DumpCustomQuant::write_footer()
+{
+  const bigint natoms = frame.size() / size_one;
+  if (natoms != ntotal) error->one(FLERR,"Dump custom/quant snapshot size mismatch");
+
+  const double boxlo[3] = {boxxlo, boxylo, boxzlo};
+  const double prd[3] = {boxxhi - boxxlo, boxyhi - boxylo, boxzhi - boxzlo};
+
+  std::vector<int> kind(size_one);
+  std::vector<double> origin(size_one), step(size_one);
+  std::vector<uint8_t> raw;
+  raw.reserve(natoms*size_one*2);
+
+  for (int icol = 0; icol < size_one; icol++) {
+    if ((vtype[icol] == Dump::INT) || (vtype[icol] == Dump::BIGINT)) {
+      kind[icol] = EXACT;
+      origin[icol] = 0.0;
+      step[icol] = 1.0;
+    } else if (quantdim[icol] >= 0) {
+      kind[icol] = QUANT;
+      origin[icol] = boxlo[quantdim[icol]];
+      step[icol] = tolerance * prd[quantdim[icol]];
+    } else {
+      double vmin = 0.0, vmax = 0.0;
+      if (natoms) vmin = vmax = frame[icol];
+      for (bigint i = 1; i < natoms; i++) {
+        vmin = MIN(vmin,frame[i*size_one+icol]);
+        vmax = MAX(vmax,frame[i*size_one+icol]);
+      }
+      kind[icol] = QUANT;
+      origin[icol] = vmin;
+      step[icol] = tolerance * (vmax - vmin);
+    }
+    if (!(step[icol] > 0.0) || !std::isfinite(step[icol])) step[icol] = 1.0;
+
+    int64_t prev = 0;
+    for (bigint i = 0; i < natoms; i++) {
+      const double q = std::round((frame[i*size_one+icol] - origin[icol]) / step[icol]);
+      if (!(fabs(q) < MAXQUANT))
+        error->one(FLERR,"Dump custom/quant value out of range for tolerance {}", tolerance);
+      const auto iq = static_cast<int64_t>(q);
+      const int64_t delta = iq - prev;
+      prev = iq;
+      auto zz = ((uint64_t) delta << 1) ^ (uint64_t) (delta >> 63);
+      while (zz >= 0x80) {
+        raw.push_back(static_cast<uint8_t>(zz | 0x80));
+        zz >>= 7;
+      }
+      raw.push_back(static_cast<uint8_t>(zz));
+    }
+  }
+
+  uLongf ncomp = compressBound(raw.size());
+  std::vector<Bytef> comp(ncomp);
+  if (compress2(comp.data(),&ncomp,raw.data(),raw.size(),compression_level) != Z_OK)
+    error->one(FLERR,"Dump custom/quant compression failed");
+
+  // write snapshot
+
+  const int revision = REVISION;
+  const bigint ntimestep = update->ntimestep;
+  const int triclinic = domain->triclinic;
+  const double box[9] = {boxxlo, boxxhi, boxylo, boxyhi, boxzlo, boxzhi,
+                         triclinic ? boxxy : 0.0, triclinic ? boxxz : 0.0, triclinic ? boxyz : 0.0};
+  const int len = strlen(columns);
+  const bigint nraw = raw.size();
+  const bigint ncompressed = ncomp;
+
+  fwrite(MAGIC,sizeof(char),strlen(MAGIC),fp);
+  fwrite(&revision,sizeof(int),1,fp);
+  fwrite(&ntimestep,sizeof(bigint),1,fp);
+  fwrite(&natoms,sizeof(bigint),1,fp);
+  fwrite(&triclinic,sizeof(int),1,fp);
+  fwrite(&domain->boundary[0][0],sizeof(int),6,fp);
+  fwrite(box,sizeof(double),9,fp);
+  fwrite(&size_one,sizeof(int),1,fp);
+  fwrite(&len,sizeof(int),1,fp);
+  fwrite(columns,sizeof(char),len,fp);
+  for (int icol = 0; icol < size_one; icol++) {
+    fwrite(&kind[icol],sizeof(int),1,fp);
+    fwrite(&origin[icol],sizeof(double),1,fp);
+    fwrite(&step[icol],sizeof(double),1,fp);
+  }
+  fwrite(&nraw,sizeof(bigint),1,fp);
+  fwrite(&ncompressed,sizeof(bigint),1,fp);
+  fwrite(comp.data(),sizeof(Bytef),ncomp,fp);
+
+  frame.clear();
+}
+
+/* ---------------------------------------------------------------------- */
+
+int DumpCustomQuant::modify_param(int narg, char **arg)
+{
+  int consumed = DumpCustom::modify_param(narg, arg);
+  if (consumed == 0) {
+    if (strcmp(arg[0], "tolerance") == 0) {
+      if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify tolerance", error);
+      tolerance = utils::numeric(FLERR, arg[1], false, lmp);
+      if (tolerance <= 0.0 || tolerance >= 1.0)
+        error->all(FLERR, "Illegal dump_modify tolerance value {}", tolerance);
+      return 2;
+    } else if (strcmp(arg[0], "compression_level") == 0) {
+      if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify compression_level", error);
+      int level = utils::inumeric(FLERR, arg[1], false, lmp);
+      if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION)
+        error->all(FLERR, "Compression level must be in the range of [{}, {}]",
+                   Z_DEFAULT_COMPRESSION, Z_BEST_COMPRESSION);
+      compression_level = level;
+      return 2;
+    }
+  }
+  return consumed;
+}
+
@@ -0,0 +1,54 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef DUMP_CLASS
+// clang-format off
+DumpStyle(custom/quant,DumpCustomQuant);
+// clang-format on
+#else
+
+#ifndef LMP_DUMP_CUSTOM_QUANT_H
+#define LMP_DUMP_CUSTOM_QUANT_H
+
+#include "dump_custom.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class DumpCustomQuant : public DumpCustom {
+ public:
+  DumpCustomQuant(class LAMMPS *, int, char **);
+
+  static constexpr const char *MAGIC = "LMPQUANT";
+  static constexpr int REVISION = 1;
+  enum { EXACT, QUANT };
+
+ protected:
+  double tolerance;           // max quantization error relative to box length or value range
+  int compression_level;      // zlib compression level
+  std::vector<int> quantdim;  // dimension for coordinate columns, -1 for others
+  std::vector<double> frame;  // per-atom data of current snapshot
+
+  void init_style() override;
+  void write_header(bigint) override;
+  void write_data(int, double *) override;
+  void write_footer() override;
+  int modify_param(int, char **) override;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
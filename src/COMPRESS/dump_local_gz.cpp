@@ -25,6 +25,7 @@ using namespace LAMMPS_NS;
 DumpLocalGZ::DumpLocalGZ(LAMMPS *lmp, int narg, char **arg) : DumpLocal(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump local/gz only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -147,13 +148,19 @@ void DumpLocalGZ::write_data(int n, double *mybuf)
 
 void DumpLocalGZ::write()
 {
-  DumpLocal::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
+  // the writer reports failures of its compression threads via exceptions
+
+  try {
+    DumpLocal::write();
+    if (filewriter) {
+      if (multifile) {
+        writer.close();
+      } else {
+        if (flush_flag && writer.isopen()) { writer.flush(); }
+      }
     }
+  } catch (FileWriterException &e) {
+    error->one(FLERR, "Error writing dump {}: {}", id, e.what());
   }
 }
 
@@ -169,6 +176,10 @@ int DumpLocalGZ::modify_param(int narg, char **arg)
         int compression_level = utils::inumeric(FLERR, arg[1], false, lmp);
         writer.setCompressionLevel(compression_level);
         return 2;
+      } else if (strcmp(arg[0], "compression_threads") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        writer.setNumThreads(utils::inumeric(FLERR, arg[1], false, lmp));
+        return 2;
       }
     } catch (FileWriterException &e) {
       error->one(FLERR, "Illegal dump_modify command: {}", e.what());
@@ -31,6 +31,7 @@ using namespace LAMMPS_NS;
 DumpLocalZstd::DumpLocalZstd(LAMMPS *lmp, int narg, char **arg) : DumpLocal(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump local/zstd only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -180,6 +181,10 @@ int DumpLocalZstd::modify_param(int narg, char **arg)
         if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
         writer.setCompressionLevel(utils::inumeric(FLERR, arg[1], false, lmp));
         return 2;
+      } else if (strcmp(arg[0], "compression_threads") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        writer.setNumThreads(utils::inumeric(FLERR, arg[1], false, lmp));
+        return 2;
       }
     } catch (FileWriterException &e) {
       error->one(FLERR, "Illegal dump_modify command: {}", e.what());
@@ -30,6 +30,8 @@ using namespace LAMMPS_NS;
 DumpXYZZstd::DumpXYZZstd(LAMMPS *lmp, int narg, char **arg) : DumpXYZ(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump xyz/zstd only writes compressed files");
+  async_allow = 0;
+  mpiio_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -149,6 +151,10 @@ int DumpXYZZstd::modify_param(int narg, char **arg)
         if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
         writer.setCompressionLevel(utils::inumeric(FLERR, arg[1], false, lmp));
         return 2;
+      } else if (strcmp(arg[0], "compression_threads") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        writer.setNumThreads(utils::inumeric(FLERR, arg[1], false, lmp));
+        return 2;
       }
     } catch (FileWriterException &e) {
       error->one(FLERR, "Illegal dump_modify command: {}", e.what());
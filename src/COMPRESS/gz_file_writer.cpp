@@ -17,17 +17,31 @@
 
 #include "gz_file_writer.h"
 #include "fmt/format.h"
+#include <algorithm>
 #include <cstdio>
+#include <thread>
 
 using namespace LAMMPS_NS;
 
-GzFileWriter::GzFileWriter() : compression_level(Z_BEST_COMPRESSION), gzFp(nullptr) {}
+// size of blocks of uncompressed data that are compressed independently by threads
+
+static constexpr size_t BLOCKSIZE = 1048576;
+
+GzFileWriter::GzFileWriter() :
+    compression_level(Z_BEST_COMPRESSION), nthreads(1), gzFp(nullptr), fp(nullptr)
+{
+}
 
 /* ---------------------------------------------------------------------- */
 
 GzFileWriter::~GzFileWriter()
 {
-  GzFileWriter::close();
+  // errors cannot be reported from a destructor
+
+  try {
+    GzFileWriter::close();
+  } catch (FileWriterException &) {
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -36,6 +50,14 @@ void GzFileWriter::open(const std::string &path, bool append)
 {
   if (isopen()) return;
 
+  // with multiple threads, data is written as a sequence of complete gzip members
+
+  if (nthreads > 1) {
+    fp = fopen(path.c_str(), append ? "ab" : "wb");
+    if (fp == nullptr) throw FileWriterException(fmt::format("Could not open file '{}'", path));
+    return;
+  }
+
   std::string mode;
   if (append) {
     mode = fmt::format("ab{}", mode, compression_level);
@@ -54,15 +76,84 @@ size_t GzFileWriter::write(const void *buffer, size_t length)
 {
   if (!isopen()) return 0;
 
+  if (fp) {
+    const char *data = static_cast<const char *>(buffer);
+    pending.insert(pending.end(), data, data + length);
+    if (pending.size() >= nthreads * BLOCKSIZE) compress_pending();
+    return length;
+  }
+
   return gzwrite(gzFp, buffer, length);
 }
 
+/* ----------------------------------------------------------------------
+   compress pending data in blocks of BLOCKSIZE with nthreads threads
+   each block becomes a complete gzip member, written to the file in order
+   concatenated members are a valid gzip file for gunzip and zlib
+   failures of the threads are collected and reported after they are joined
+------------------------------------------------------------------------- */
+
+void GzFileWriter::compress_pending()
+{
+  if (pending.empty()) return;
+
+  const size_t nblocks = (pending.size() + BLOCKSIZE - 1) / BLOCKSIZE;
+  std::vector<std::vector<unsigned char>> members(nblocks);
+  std::vector<char> failed(nblocks, 0);
+
+  auto compress_blocks = [&](size_t first) {
+    for (size_t iblock = first; iblock < nblocks; iblock += nthreads) {
+      const size_t offset = iblock * BLOCKSIZE;
+      const size_t length = std::min(BLOCKSIZE, pending.size() - offset);
+      auto &member = members[iblock];
+
+      // windowBits of 15+16 selects a gzip header and trailer
+
+      z_stream strm = {};
+      if (deflateInit2(&strm, compression_level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) !=
+          Z_OK) {
+        failed[iblock] = 1;
+        continue;
+      }
+      member.resize(deflateBound(&strm, length));
+      strm.next_in = reinterpret_cast<Bytef *>(pending.data() + offset);
+      strm.avail_in = length;
+      strm.next_out = member.data();
+      strm.avail_out = member.size();
+      if (deflate(&strm, Z_FINISH) == Z_STREAM_END)
+        member.resize(member.size() - strm.avail_out);
+      else
+        failed[iblock] = 1;
+      deflateEnd(&strm);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (int i = 1; i < nthreads && (size_t) i < nblocks; ++i) workers.emplace_back(compress_blocks, i);
+  compress_blocks(0);
+  for (auto &worker : workers) worker.join();
+  pending.clear();
+
+  if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+    throw FileWriterException("Compression of gzip member failed");
+
+  for (const auto &member : members)
+    if (fwrite(member.data(), 1, member.size(), fp) != member.size())
+      throw FileWriterException("Error writing gzip member to file");
+}
+
 /* ---------------------------------------------------------------------- */
 
 void GzFileWriter::flush()
 {
   if (!isopen()) return;
 
+  if (fp) {
+    compress_pending();
+    fflush(fp);
+    return;
+  }
+
   gzflush(gzFp, Z_SYNC_FLUSH);
 }
 
@@ -72,6 +163,19 @@ void GzFileWriter::close()
 {
   if (!GzFileWriter::isopen()) return;
 
+  if (fp) {
+    try {
+      compress_pending();
+    } catch (FileWriterException &) {
+      fclose(fp);
+      fp = nullptr;
+      throw;
+    }
+    fclose(fp);
+    fp = nullptr;
+    return;
+  }
+
   gzclose(gzFp);
   gzFp = nullptr;
 }
@@ -80,7 +184,7 @@ void GzFileWriter::close()
 
 bool GzFileWriter::isopen() const
 {
-  return gzFp;
+  return gzFp || fp;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -99,3 +203,15 @@ void GzFileWriter::setCompressionLevel(int level)
 
   compression_level = level;
 }
+
+/* ---------------------------------------------------------------------- */
+
+void GzFileWriter::setNumThreads(int num)
+{
+  if (isopen())
+    throw FileWriterException("Number of compression threads can not be changed while file is open");
+
+  if (num < 1) throw FileWriterException("Number of compression threads must be at least 1");
+
+  nthreads = num;
+}
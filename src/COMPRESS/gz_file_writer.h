@@ -20,15 +20,23 @@
 
 #include "file_writer.h"
 
+#include <cstdio>
 #include <string>
+#include <vector>
 #include <zlib.h>
 
 namespace LAMMPS_NS {
 
 class GzFileWriter : public FileWriter {
   int compression_level;
+  int nthreads;
+
+  gzFile gzFp;                  // file pointer for the compressed output stream
+  FILE *fp;                     // file pointer for multi-threaded output of gzip members
+  std::vector<char> pending;    // uncompressed data for multi-threaded output
+
+  void compress_pending();
 
-  gzFile gzFp;    // file pointer for the compressed output stream
  public:
   GzFileWriter();
   ~GzFileWriter() override;
@@ -39,6 +47,7 @@ class GzFileWriter : public FileWriter {
   bool isopen() const override;
 
   void setCompressionLevel(int level);
+  void setNumThreads(int num);
 };
 }    // namespace LAMMPS_NS
 
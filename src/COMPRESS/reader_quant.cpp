@@ -0,0 +1,214 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "reader_quant.h"
+
+#include "dump_custom_quant.h"
+#include "error.h"
+
+#include <cstring>
+#include <zlib.h>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+ReaderQuant::ReaderQuant(LAMMPS *lmp) : ReaderNative(lmp)
+{
+  natoms = iatom = 0;
+  ncol = 0;
+  nraw = ncompressed = 0;
+}
+
+/* ----------------------------------------------------------------------
+   open dump custom/quant file, always binary and not compressed externally
+------------------------------------------------------------------------- */
+
+void ReaderQuant::open_file(const std::string &file)
+{
+  if (fp != nullptr) close_file();
+
+  if (platform::has_compress_extension(file))
+    error->one(FLERR, "Cannot read compressed dump custom/quant file {}", file);
+  compressed = false;
+  binary = true;
+  fp = fopen(file.c_str(), "rb");
+  if (!fp) error->one(FLERR, "Cannot open file {}: {}", file, utils::getsyserror());
+
+  has_index = false;
+  if (indexflag) build_index(file);
+}
+
+/* ----------------------------------------------------------------------
+   read and return time stamp from dump file
+   if first read reaches end-of-file, return 1 so caller can open next file
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+int ReaderQuant::read_time(bigint &ntimestep)
+{
+  const std::size_t nmagic = strlen(DumpCustomQuant::MAGIC);
+  std::string magic(nmagic, '\0');
+  if (fread(&magic[0], sizeof(char), nmagic, fp) != nmagic) return 1;
+  if (magic != DumpCustomQuant::MAGIC)
+    error->one(FLERR, "Dump file is not a dump custom/quant file or is corrupted");
+
+  read_buf(&revision, sizeof(int), 1);
+  if (revision != DumpCustomQuant::REVISION)
+    error->one(FLERR, "Unsupported dump custom/quant format revision {}", revision);
+  read_buf(&ntimestep, sizeof(bigint), 1);
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   skip snapshot from timestamp onward
+   the compressed per-atom data is skipped without decompressing it
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderQuant::skip()
+{
+  if (skip_index()) return;
+
+  double box[3][3];
+  int boxinfo, triclinic;
+  read_frame_header(box, boxinfo, triclinic);
+  if (platform::fseek(fp, platform::ftell(fp) + ncompressed) != 0)
+    error->one(FLERR, "Dump file is invalid or corrupted");
+}
+
+/* ----------------------------------------------------------------------
+   read remaining header info and per-atom data of snapshot
+   return natoms, box bounds, triclinic, and match fields like ReaderNative
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+bigint ReaderQuant::read_header(double box[3][3], int &boxinfo, int &triclinic, int fieldinfo,
+                                int nfield, int *fieldtype, char **fieldlabel, int scaleflag,
+                                int wrapflag, int &fieldflag, int &xflag, int &yflag, int &zflag)
+{
+  std::string labelline = read_frame_header(box, boxinfo, triclinic);
+
+  // decode per-atom data right away, so the file is positioned at the next snapshot
+
+  decode();
+  iatom = 0;
+
+  if (!fieldinfo) return natoms;
+  if (!match_fields(labelline, nfield, fieldtype, fieldlabel, scaleflag, wrapflag, fieldflag,
+                    xflag, yflag, zflag))
+    return 1;
+
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   read snapshot header up to the compressed per-atom data
+   return box bounds, triclinic, and the line with the column labels
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+std::string ReaderQuant::read_frame_header(double box[3][3], int &boxinfo, int &triclinic)
+{
+  int boundary[3][2];
+  double boxvalues[9];
+  int len;
+
+  read_buf(&natoms, sizeof(bigint), 1);
+  read_buf(&triclinic, sizeof(int), 1);
+  read_buf(&boundary[0][0], sizeof(int), 6);
+  read_buf(boxvalues, sizeof(double), 9);
+
+  boxinfo = 1;
+  for (int i = 0; i < 3; i++) {
+    box[i][0] = boxvalues[2 * i];
+    box[i][1] = boxvalues[2 * i + 1];
+    box[i][2] = triclinic ? boxvalues[6 + i] : 0.0;
+  }
+
+  read_buf(&ncol, sizeof(int), 1);
+  read_buf(&len, sizeof(int), 1);
+  if ((ncol <= 0) || (len < 0)) error->one(FLERR, "Dump file is invalid or corrupted");
+  std::string labelline = read_binary_str(len);
+
+  kind.resize(ncol);
+  origin.resize(ncol);
+  step.resize(ncol);
+  for (int icol = 0; icol < ncol; icol++) {
+    read_buf(&kind[icol], sizeof(int), 1);
+    read_buf(&origin[icol], sizeof(double), 1);
+    read_buf(&step[icol], sizeof(double), 1);
+  }
+  read_buf(&nraw, sizeof(bigint), 1);
+  read_buf(&ncompressed, sizeof(bigint), 1);
+  if ((nraw < 0) || (ncompressed < 0)) error->one(FLERR, "Dump file is invalid or corrupted");
+
+  return labelline;
+}
+
+/* ----------------------------------------------------------------------
+   read N atoms from decoded snapshot
+   stores appropriate values in fields array
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderQuant::read_atoms(int n, int nfield, double **fields)
+{
+  if (iatom + n > natoms) error->one(FLERR, "Unexpected end of dump file");
+
+  for (int i = 0; i < n; i++) {
+    for (int k = 0; k < nfield; k++) fields[i][k] = values[fieldindex[k] * natoms + iatom];
+    ++iatom;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   read and decompress per-atom data of snapshot
+   undo zigzag varint and delta encoding and quantization of each column
+------------------------------------------------------------------------- */
+
+void ReaderQuant::decode()
+{
+  std::vector<Bytef> comp(ncompressed);
+  std::vector<Bytef> raw(nraw);
+  read_buf(comp.data(), sizeof(Bytef), ncompressed);
+
+  uLongf n = nraw;
+  if ((uncompress(raw.data(), &n, comp.data(), ncompressed) != Z_OK) || ((bigint) n != nraw))
+    error->one(FLERR, "Dump file is invalid or corrupted: decompression failed");
+
+  values.resize(natoms * ncol);
+  std::size_t pos = 0;
+  for (int icol = 0; icol < ncol; icol++) {
+    int64_t prev = 0;
+    for (bigint i = 0; i < natoms; i++) {
+      uint64_t zz = 0;
+      int shift = 0;
+      while (true) {
+        if ((pos >= raw.size()) || (shift > 63))
+          error->one(FLERR, "Dump file is invalid or corrupted: bad encoding");
+        const Bytef byte = raw[pos++];
+        zz |= (uint64_t) (byte & 0x7f) << shift;
+        if (!(byte & 0x80)) break;
+        shift += 7;
+      }
+      prev += (int64_t) (zz >> 1) ^ -(int64_t) (zz & 1);
+      if (kind[icol] == DumpCustomQuant::EXACT)
+        values[icol * natoms + i] = (double) prev;
+      else
+        values[icol * natoms + i] = origin[icol] + prev * step[icol];
+    }
+  }
+}
+
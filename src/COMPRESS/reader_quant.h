@@ -0,0 +1,57 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef READER_CLASS
+// clang-format off
+ReaderStyle(quant,ReaderQuant);
+// clang-format on
+#else
+
+#ifndef LMP_READER_QUANT_H
+#define LMP_READER_QUANT_H
+
+#include "reader_native.h"
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class ReaderQuant : public ReaderNative {
+ public:
+  ReaderQuant(class LAMMPS *);
+
+  void open_file(const std::string &) override;
+  int read_time(bigint &) override;
+  void skip() override;
+  bigint read_header(double[3][3], int &, int &, int, int, int *, char **, int, int, int &, int &,
+                     int &, int &) override;
+  void read_atoms(int, int, double **) override;
+
+ private:
+  bigint natoms;                 // # of atoms in current snapshot
+  bigint iatom;                  // index of next atom to return
+  int ncol;                      // # of columns in current snapshot
+  std::vector<int> kind;         // EXACT or QUANT for each column
+  std::vector<double> origin;    // origin of quantized values for each column
+  std::vector<double> step;      // quantization step for each column
+  bigint nraw, ncompressed;      // size of encoded and compressed data
+  std::vector<double> values;    // decoded values, column by column
+
+  std::string read_frame_header(double[3][3], int &, int &);
+  void decode();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
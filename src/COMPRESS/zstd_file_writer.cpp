@@ -24,7 +24,7 @@
 using namespace LAMMPS_NS;
 
 ZstdFileWriter::ZstdFileWriter() :
-    compression_level(0), checksum_flag(1), cctx(nullptr), fp(nullptr)
+    compression_level(0), checksum_flag(1), nthreads(1), cctx(nullptr), fp(nullptr)
 {
   out_buffer_size = ZSTD_CStreamOutSize();
   out_buffer = new char[out_buffer_size];
@@ -65,6 +65,18 @@ void ZstdFileWriter::open(const std::string &path, bool append)
 
   ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, compression_level);
   ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, checksum_flag);
+
+  // compress with nthreads worker threads in the background, output is still a single frame
+
+  if (nthreads > 1) {
+    if (ZSTD_isError(ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, nthreads))) {
+      ZSTD_freeCCtx(cctx);
+      cctx = nullptr;
+      fclose(fp);
+      fp = nullptr;
+      throw FileWriterException("Zstd library does not support multi-threaded compression");
+    }
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -158,4 +170,16 @@ void ZstdFileWriter::setChecksum(bool enabled)
   checksum_flag = enabled ? 1 : 0;
 }
 
+/* ---------------------------------------------------------------------- */
+
+void ZstdFileWriter::setNumThreads(int num)
+{
+  if (isopen())
+    throw FileWriterException("Number of compression threads can not be changed while file is open");
+
+  if (num < 1) throw FileWriterException("Number of compression threads must be at least 1");
+
+  nthreads = num;
+}
+
 #endif
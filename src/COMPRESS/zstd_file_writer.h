@@ -34,6 +34,7 @@ namespace LAMMPS_NS {
 class ZstdFileWriter : public FileWriter {
   int compression_level;
   int checksum_flag;
+  int nthreads;
 
   ZSTD_CCtx *cctx;
   FILE *fp;
@@ -51,6 +52,7 @@ class ZstdFileWriter : public FileWriter {
 
   void setCompressionLevel(int level);
   void setChecksum(bool enabled);
+  void setNumThreads(int num);
 };
 }    // namespace LAMMPS_NS
 
@@ -311,6 +311,31 @@ int GranularModel::mix_coeffs(GranularModel *g1, GranularModel *g2)
   return -1;
 }
 
+/* ----------------------------------------------------------------------
+   make this model an independent copy of an initialized model
+   used to give each thread its own scratch state for contact calculations
+------------------------------------------------------------------------- */
+
+void GranularModel::copy_model(GranularModel *g)
+{
+  for (int i = 0; i < NSUBMODELS; i++) {
+    construct_sub_model(g->sub_models[i]->name, (SubModelType) i);
+    for (int k = 0; k < sub_models[i]->num_coeffs; k++)
+      sub_models[i]->coeffs[k] = g->sub_models[i]->coeffs[k];
+    sub_models[i]->coeffs_to_local();
+  }
+
+  limit_damping = g->limit_damping;
+  contact_type = g->contact_type;
+  classic_model = g->classic_model;
+  dt = g->dt;
+
+  init();
+
+  for (int i = 0; i < NSUBMODELS; i++)
+    sub_models[i]->history_index = g->sub_models[i]->history_index;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void GranularModel::write_restart(FILE *fp)
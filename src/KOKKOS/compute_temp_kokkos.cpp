@@ -35,6 +35,9 @@ ComputeTempKokkos<DeviceType>::ComputeTempKokkos(LAMMPS *lmp, int narg, char **a
 
   datamask_read = V_MASK | MASK_MASK | RMASS_MASK | TYPE_MASK;
   datamask_modify = EMPTY_MASK;
+
+  // temperature is computed on the device in overridden methods only
+  size_partial_scalar = size_partial_vector = 0;
 }
 
 /* ---------------------------------------------------------------------- */
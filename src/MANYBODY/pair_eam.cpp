@@ -26,6 +26,7 @@
 #include "neighbor.h"
 #include "neigh_list.h"
 #include "potential_file_reader.h"
+#include "suffix.h"
 #include "update.h"
 
 #include <cmath>
@@ -65,6 +66,12 @@ PairEAM::PairEAM(LAMMPS *lmp) : Pair(lmp)
   rhor_spline = nullptr;
   z2r_spline = nullptr;
 
+  packed_flag = 0;
+  rho_packed = nullptr;
+  force_packed = nullptr;
+  type2packed = nullptr;
+  type2swap = nullptr;
+
   // set comm size needed by this Pair
 
   comm_forward = 1;
@@ -90,6 +97,8 @@ PairEAM::~PairEAM()
     type2frho = nullptr;
     memory->destroy(type2rhor);
     memory->destroy(type2z2r);
+    memory->destroy(type2packed);
+    memory->destroy(type2swap);
     memory->destroy(scale);
   }
 
@@ -133,6 +142,9 @@ PairEAM::~PairEAM()
   memory->destroy(frho_spline);
   memory->destroy(rhor_spline);
   memory->destroy(z2r_spline);
+
+  memory->destroy(rho_packed);
+  memory->destroy(force_packed);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -184,7 +196,8 @@ void PairEAM::compute(int eflag, int vflag)
   // rho = density at each atom
   // loop over neighbors of my atoms
 
-  for (ii = 0; ii < inum; ii++) {
+  if (packed_flag) compute_rho_packed();
+  else for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
     xtmp = x[i][0];
     ytmp = x[i][1];
@@ -257,7 +270,8 @@ void PairEAM::compute(int eflag, int vflag)
   // compute forces on each atom
   // loop over neighbors of my atoms
 
-  for (ii = 0; ii < inum; ii++) {
+  if (packed_flag) compute_force_packed(eflag);
+  else for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
     xtmp = x[i][0];
     ytmp = x[i][1];
@@ -363,6 +377,8 @@ void PairEAM::allocate()
   type2frho = new int[n+1];
   memory->create(type2rhor,n+1,n+1,"pair:type2rhor");
   memory->create(type2z2r,n+1,n+1,"pair:type2z2r");
+  memory->create(type2packed,n+1,n+1,"pair:type2packed");
+  memory->create(type2swap,n+1,n+1,"pair:type2swap");
   memory->create(scale,n+1,n+1,"pair:scale");
 }
 
@@ -370,9 +386,23 @@ void PairEAM::allocate()
    global settings
 ------------------------------------------------------------------------- */
 
-void PairEAM::settings(int narg, char **/*arg*/)
+void PairEAM::settings(int narg, char **arg)
 {
-  if (narg > 0) error->all(FLERR,"Illegal pair_style command");
+  packed_flag = 0;
+
+  int iarg = 0;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"packed") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"pair_style eam packed",error);
+      packed_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else error->all(FLERR,"Unknown pair_style {} keyword: {}",force->pair_style,arg[iarg]);
+  }
+
+  // accelerated variants have their own compute() and do not use the packed tables
+
+  if (packed_flag && ((suffix_flag != Suffix::NONE) || kokkosable))
+    error->all(FLERR,"Pair style {} does not support the packed keyword",force->pair_style);
 }
 
 /* ----------------------------------------------------------------------
@@ -777,6 +807,218 @@ void PairEAM::array2spline()
 
   for (int i = 0; i < nz2r; i++)
     interpolate(nr,dr,z2r[i],z2r_spline[i]);
+
+  if (packed_flag) pack_splines();
+}
+
+/* ----------------------------------------------------------------------
+   copy rhor and z2r splines into packed per type pair tables
+   only type pairs I <= J are stored, J,I uses the I,J record with swapped halves
+   rho_packed record (8 doubles) = value coeffs of rho_J->I, then rho_I->J
+   force_packed record (16 doubles) = derivative coeffs of rho_I->J and rho_J->I,
+     followed by all 7 z2r coeffs and padding
+   record sizes are multiples of 64 bytes, so with the aligned allocation of
+     memory->create() each knot lookup touches a minimal number of cache lines
+------------------------------------------------------------------------- */
+
+void PairEAM::pack_splines()
+{
+  const int ntypes = atom->ntypes;
+
+  int npairs = 0;
+  for (int i = 1; i <= ntypes; i++) {
+    for (int j = 1; j <= ntypes; j++) {
+      type2packed[i][j] = 0;
+      type2swap[i][j] = 0;
+    }
+    if (map[i] < 0) continue;
+    for (int j = i; j <= ntypes; j++)
+      if (map[j] >= 0) npairs++;
+  }
+
+  npairs = MAX(npairs,1);
+  if ((bigint)npairs*(nr+1)*16 > MAXSMALLINT)
+    error->all(FLERR,"Too many EAM spline knots for pair_style {} packed tables",
+               force->pair_style);
+
+  memory->destroy(rho_packed);
+  memory->destroy(force_packed);
+  memory->create(rho_packed,npairs*(nr+1)*8,"pair:rho_packed");
+  memory->create(force_packed,npairs*(nr+1)*16,"pair:force_packed");
+
+  int n = 0;
+  for (int i = 1; i <= ntypes; i++) {
+    if (map[i] < 0) continue;
+    for (int j = i; j <= ntypes; j++) {
+      if (map[j] < 0) continue;
+      type2packed[i][j] = type2packed[j][i] = n;
+      type2swap[i][j] = 0;
+      type2swap[j][i] = 1;
+
+      double **rij = rhor_spline[type2rhor[i][j]];
+      double **rji = rhor_spline[type2rhor[j][i]];
+      double **z2 = z2r_spline[type2z2r[i][j]];
+      double *rec;
+      for (int m = 0; m <= nr; m++) {
+        rec = rho_packed + (n*(nr+1) + m)*8;
+        for (int k = 0; k < 4; k++) {
+          rec[k] = rji[m][k+3];
+          rec[k+4] = rij[m][k+3];
+        }
+        rec = force_packed + (n*(nr+1) + m)*16;
+        for (int k = 0; k < 3; k++) {
+          rec[k] = rij[m][k];
+          rec[k+3] = rji[m][k];
+        }
+        for (int k = 0; k < 7; k++) rec[k+6] = z2[m][k];
+        rec[13] = rec[14] = rec[15] = 0.0;
+      }
+      n++;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   accumulate densities from packed spline tables
+------------------------------------------------------------------------- */
+
+void PairEAM::compute_rho_packed()
+{
+  const double * const * const x = atom->x;
+  const int * const type = atom->type;
+  const int nlocal = atom->nlocal;
+  const int newton_pair = force->newton_pair;
+  const int inum = list->inum;
+  const int * const ilist = list->ilist;
+  const int * const numneigh = list->numneigh;
+  int * const * const firstneigh = list->firstneigh;
+  const int nrec = nr+1;
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    const double xtmp = x[i][0];
+    const double ytmp = x[i][1];
+    const double ztmp = x[i][2];
+    const int itype = type[i];
+    const int * const jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+    const int * const packi = type2packed[itype];
+    const int * const swapi = type2swap[itype];
+    double rhoi = 0.0;
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int j = jlist[jj] & NEIGHMASK;
+      const double delx = xtmp - x[j][0];
+      const double dely = ytmp - x[j][1];
+      const double delz = ztmp - x[j][2];
+      const double rsq = delx*delx + dely*dely + delz*delz;
+
+      if (rsq < cutforcesq) {
+        const int jtype = type[j];
+        double p = sqrt(rsq)*rdr + 1.0;
+        int m = static_cast<int> (p);
+        m = MIN(m,nr-1);
+        p -= m;
+        p = MIN(p,1.0);
+        const double *rec = rho_packed + (packi[jtype]*nrec + m)*8;
+        const int s = 4*swapi[jtype];
+        const double *coeff = rec + s;
+        rhoi += ((coeff[0]*p + coeff[1])*p + coeff[2])*p + coeff[3];
+        if (newton_pair || j < nlocal) {
+          coeff = rec + 4 - s;
+          rho[j] += ((coeff[0]*p + coeff[1])*p + coeff[2])*p + coeff[3];
+        }
+      }
+    }
+    rho[i] += rhoi;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compute pairwise forces from packed spline tables
+   requires fp to be current on owned and ghost atoms
+------------------------------------------------------------------------- */
+
+void PairEAM::compute_force_packed(int eflag)
+{
+  const double * const * const x = atom->x;
+  double * const * const f = atom->f;
+  const int * const type = atom->type;
+  const int nlocal = atom->nlocal;
+  const int newton_pair = force->newton_pair;
+  const int inum = list->inum;
+  const int * const ilist = list->ilist;
+  const int * const numneigh = list->numneigh;
+  int * const * const firstneigh = list->firstneigh;
+  const int nrec = nr+1;
+  double evdwl = 0.0;
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    const double xtmp = x[i][0];
+    const double ytmp = x[i][1];
+    const double ztmp = x[i][2];
+    const int itype = type[i];
+    const int * const jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+    const int * const packi = type2packed[itype];
+    const int * const swapi = type2swap[itype];
+    const double fpi = fp[i];
+    double fxtmp = 0.0, fytmp = 0.0, fztmp = 0.0;
+    numforce[i] = 0;
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int j = jlist[jj] & NEIGHMASK;
+      const double delx = xtmp - x[j][0];
+      const double dely = ytmp - x[j][1];
+      const double delz = ztmp - x[j][2];
+      const double rsq = delx*delx + dely*dely + delz*delz;
+
+      if (rsq < cutforcesq) {
+        ++numforce[i];
+        const int jtype = type[j];
+        const double r = sqrt(rsq);
+        double p = r*rdr + 1.0;
+        int m = static_cast<int> (p);
+        m = MIN(m,nr-1);
+        p -= m;
+        p = MIN(p,1.0);
+
+        // same quantities as in compute(), see comments there
+
+        const double *rec = force_packed + (packi[jtype]*nrec + m)*16;
+        const int s = 3*swapi[jtype];
+        const double *coeff = rec + s;
+        const double rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
+        coeff = rec + 3 - s;
+        const double rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
+        coeff = rec + 6;
+        const double z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
+        const double z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+
+        const double recip = 1.0/r;
+        const double phi = z2*recip;
+        const double phip = z2p*recip - phi*recip;
+        const double psip = fpi*rhojp + fp[j]*rhoip + phip;
+        const double fpair = -scale[itype][jtype]*psip*recip;
+
+        fxtmp += delx*fpair;
+        fytmp += dely*fpair;
+        fztmp += delz*fpair;
+        if (newton_pair || j < nlocal) {
+          f[j][0] -= delx*fpair;
+          f[j][1] -= dely*fpair;
+          f[j][2] -= delz*fpair;
+        }
+
+        if (eflag) evdwl = scale[itype][jtype]*phi;
+        if (evflag) ev_tally(i,j,nlocal,newton_pair,evdwl,0.0,fpair,delx,dely,delz);
+      }
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -924,6 +1166,13 @@ double PairEAM::memory_usage()
   double bytes = (double)maxeatom * sizeof(double);
   bytes += (double)maxvatom*6 * sizeof(double);
   bytes += (double)2 * nmax * sizeof(double);
+  if (packed_flag && rho_packed) {
+    int npairs = 0;
+    for (int i = 1; i <= atom->ntypes; i++)
+      for (int j = i; j <= atom->ntypes; j++)
+        if ((map[i] >= 0) && (map[j] >= 0)) npairs++;
+    bytes += (double)npairs * (nr+1) * 24 * sizeof(double);
+  }
   return bytes;
 }
 
@@ -44,6 +44,12 @@ class PairEAM : public Pair {
   double dr, rdr, drho, rdrho, rhomax, rhomin;
   double ***rhor_spline, ***frho_spline, ***z2r_spline;
 
+  // optional packed spline tables with one aligned record per type pair and knot
+
+  int packed_flag;
+  double *rho_packed, *force_packed;
+  int **type2packed, **type2swap;
+
   PairEAM(class LAMMPS *);
   ~PairEAM() override;
   void compute(int, int) override;
@@ -108,6 +114,9 @@ class PairEAM : public Pair {
   virtual void allocate();
   virtual void array2spline();
   void interpolate(int, double, double *, double **);
+  void pack_splines();
+  void compute_rho_packed();
+  void compute_force_packed(int);
 
   virtual void read_file(char *);
   virtual void file2array();
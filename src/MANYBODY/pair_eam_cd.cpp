@@ -439,6 +439,17 @@ void PairEAMCD::compute(int eflag, int vflag)
 
 /* ---------------------------------------------------------------------- */
 
+void PairEAMCD::settings(int narg, char **arg)
+{
+  PairEAMAlloy::settings(narg, arg);
+
+  // compute() of this style does not use the packed spline tables
+
+  if (packed_flag) error->all(FLERR,"Pair style {} does not support the packed keyword",force->pair_style);
+}
+
+/* ---------------------------------------------------------------------- */
+
 void PairEAMCD::coeff(int narg, char **arg)
 {
   PairEAMAlloy::coeff(narg, arg);
@@ -36,6 +36,9 @@ class PairEAMCD : public PairEAMAlloy {
   /// Calculates the energies and forces for all atoms in the system.
   void compute(int, int) override;
 
+  /// Parses the pair_style command parameters for this pair style.
+  void settings(int, char **) override;
+
   /// Parses the pair_coeff command parameters for this pair style.
   void coeff(int, char **) override;
 
@@ -81,7 +81,8 @@ void PairEAMHE::compute(int eflag, int vflag)
   // rho = density at each atom
   // loop over neighbors of my atoms
 
-  for (ii = 0; ii < inum; ii++) {
+  if (packed_flag) compute_rho_packed();
+  else for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
     xtmp = x[i][0];
     ytmp = x[i][1];
@@ -163,7 +164,8 @@ void PairEAMHE::compute(int eflag, int vflag)
   // compute forces on each atom
   // loop over neighbors of my atoms
 
-  for (ii = 0; ii < inum; ii++) {
+  if (packed_flag) compute_force_packed(eflag);
+  else for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
     xtmp = x[i][0];
     ytmp = x[i][1];
@@ -52,6 +52,7 @@ PairSW::PairSW(LAMMPS *lmp) : Pair(lmp)
 
   maxshort = 10;
   neighshort = nullptr;
+  delrshort = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -69,6 +70,7 @@ PairSW::~PairSW()
     memory->destroy(setflag);
     memory->destroy(cutsq);
     memory->destroy(neighshort);
+    memory->destroy(delrshort);
   }
 }
 
@@ -81,7 +83,7 @@ void PairSW::compute(int eflag, int vflag)
   tagint itag,jtag;
   double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
   double rsq,rsq1,rsq2;
-  double delr1[3],delr2[3],fj[3],fk[3];
+  double *delr1,*delr2,fj[3],fk[3];
   int *ilist,*jlist,*numneigh,**firstneigh;
 
   evdwl = 0.0;
@@ -132,10 +134,17 @@ void PairSW::compute(int eflag, int vflag)
       if (rsq >= params[ijparam].cutsq) {
         continue;
       } else {
+        double *delrj = delrshort[numshort];
+        delrj[0] = -delx;
+        delrj[1] = -dely;
+        delrj[2] = -delz;
+        delrj[3] = rsq;
+
         neighshort[numshort++] = j;
         if (numshort >= maxshort) {
           maxshort += maxshort/2;
           memory->grow(neighshort,maxshort,"pair:neighshort");
+          memory->grow(delrshort,maxshort,4,"pair:delrshort");
         }
       }
 
@@ -175,10 +184,8 @@ void PairSW::compute(int eflag, int vflag)
       j = neighshort[jj];
       jtype = map[type[j]];
       ijparam = elem3param[itype][jtype][jtype];
-      delr1[0] = x[j][0] - xtmp;
-      delr1[1] = x[j][1] - ytmp;
-      delr1[2] = x[j][2] - ztmp;
-      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
+      delr1 = delrshort[jj];
+      rsq1 = delr1[3];
 
       double fjxtmp,fjytmp,fjztmp;
       fjxtmp = fjytmp = fjztmp = 0.0;
@@ -189,10 +196,8 @@ void PairSW::compute(int eflag, int vflag)
         ikparam = elem3param[itype][ktype][ktype];
         ijkparam = elem3param[itype][jtype][ktype];
 
-        delr2[0] = x[k][0] - xtmp;
-        delr2[1] = x[k][1] - ytmp;
-        delr2[2] = x[k][2] - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
+        delr2 = delrshort[kk];
+        rsq2 = delr2[3];
 
         threebody(&params[ijparam],&params[ikparam],&params[ijkparam],
                   rsq1,rsq2,delr1,delr2,fj,fk,eflag,evdwl);
@@ -231,6 +236,7 @@ void PairSW::allocate()
   memory->create(setflag, np1, np1, "pair:setflag");
   memory->create(cutsq, np1, np1, "pair:cutsq");
   memory->create(neighshort, maxshort, "pair:neighshort");
+  memory->create(delrshort,maxshort,4,"pair:delrshort");
   map = new int[np1];
 }
 
@@ -53,6 +53,7 @@ class PairSW : public Pair {
   Param *params;              // parameter set for an I-J-K interaction
   int maxshort;               // size of short neighbor list array
   int *neighshort;            // short neighbor list array
+  double **delrshort;         // cached j-i vector and rsq of short neighbors
   int skip_threebody_flag;    // whether to run threebody loop
   int params_mapped;          // whether parameters have been read and mapped to elements
 
@@ -57,6 +57,7 @@ PairTersoff::PairTersoff(LAMMPS *lmp) : Pair(lmp)
 
   maxshort = 10;
   neighshort = nullptr;
+  delrshort = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -74,6 +75,7 @@ PairTersoff::~PairTersoff()
     memory->destroy(setflag);
     memory->destroy(cutsq);
     memory->destroy(neighshort);
+    memory->destroy(delrshort);
   }
 }
 
@@ -117,8 +119,8 @@ void PairTersoff::eval()
   double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
   double fforce;
   double rsq,rsq1,rsq2;
-  double delr1[3],delr2[3],fi[3],fj[3],fk[3];
-  double r1_hat[3],r2_hat[3];
+  double *delr1,*delr2,fi[3],fj[3],fk[3];
+  double *r1_hat,*r2_hat;
   double zeta_ij,prefactor;
   double forceshiftfac;
   int *ilist,*jlist,*numneigh,**firstneigh;
@@ -165,6 +167,7 @@ void PairTersoff::eval()
       dely = ytmp - x[j][1];
       delz = ztmp - x[j][2];
       rsq = delx*delx + dely*dely + delz*delz;
+      const double rsqorig = rsq;
 
       // shift rsq and store correction for force
 
@@ -174,11 +177,24 @@ void PairTersoff::eval()
         rsq = rsqtmp;
       }
 
+      // store short neighbor and cache the values needed by the three-body loops,
+      // so they are computed once per I-J pair and not once per I-J-K triplet
+
       if (rsq < cutshortsq) {
+        double *delrj = delrshort[numshort];
+        delrj[0] = -delx;
+        delrj[1] = -dely;
+        delrj[2] = -delz;
+        delrj[3] = rsqorig;
+        if (SHIFT_FLAG) delrj[3] += shift*shift + 2*sqrt(rsqorig)*shift;
+        delrj[4] = 1.0/sqrt(rsqorig);
+        scale3(delrj[4], delrj, &delrj[5]);
+
         neighshort[numshort++] = j;
         if (numshort >= maxshort) {
           maxshort += maxshort/2;
           memory->grow(neighshort,maxshort,"pair:neighshort");
+          memory->grow(delrshort,maxshort,8,"pair:delrshort");
         }
       }
 
@@ -223,18 +239,12 @@ void PairTersoff::eval()
       jtype = map[type[j]];
       iparam_ij = elem3param[itype][jtype][jtype];
 
-      delr1[0] = x[j][0] - xtmp;
-      delr1[1] = x[j][1] - ytmp;
-      delr1[2] = x[j][2] - ztmp;
-      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
-
-      if (SHIFT_FLAG)
-        rsq1 += shift*shift + 2*sqrt(rsq1)*shift;
-
+      delr1 = delrshort[jj];
+      rsq1 = delr1[3];
       if (rsq1 >= params[iparam_ij].cutsq) continue;
 
-      const double r1inv = 1.0/sqrt(dot3(delr1, delr1));
-      scale3(r1inv, delr1, r1_hat);
+      const double r1inv = delr1[4];
+      r1_hat = &delr1[5];
 
       // accumulate bondorder zeta for each i-j interaction via loop over k
 
@@ -247,18 +257,11 @@ void PairTersoff::eval()
         ktype = map[type[k]];
         iparam_ijk = elem3param[itype][jtype][ktype];
 
-        delr2[0] = x[k][0] - xtmp;
-        delr2[1] = x[k][1] - ytmp;
-        delr2[2] = x[k][2] - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
-
-        if (SHIFT_FLAG)
-          rsq2 += shift*shift + 2*sqrt(rsq2)*shift;
-
+        delr2 = delrshort[kk];
+        rsq2 = delr2[3];
         if (rsq2 >= params[iparam_ijk].cutsq) continue;
 
-        double r2inv = 1.0/sqrt(dot3(delr2, delr2));
-        scale3(r2inv, delr2, r2_hat);
+        r2_hat = &delr2[5];
 
         zeta_ij += zeta(&params[iparam_ijk],rsq1,rsq2,r1_hat,r2_hat);
       }
@@ -287,18 +290,11 @@ void PairTersoff::eval()
         ktype = map[type[k]];
         iparam_ijk = elem3param[itype][jtype][ktype];
 
-        delr2[0] = x[k][0] - xtmp;
-        delr2[1] = x[k][1] - ytmp;
-        delr2[2] = x[k][2] - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
-
-        if (SHIFT_FLAG)
-          rsq2 += shift*shift + 2*sqrt(rsq2)*shift;
-
+        delr2 = delrshort[kk];
+        rsq2 = delr2[3];
         if (rsq2 >= params[iparam_ijk].cutsq) continue;
 
-        double r2inv = 1.0/sqrt(dot3(delr2, delr2));
-        scale3(r2inv, delr2, r2_hat);
+        r2_hat = &delr2[5];
 
         attractive(&params[iparam_ijk],prefactor,
                    rsq1,rsq2,r1_hat,r2_hat,fi,fj,fk);
@@ -337,6 +333,7 @@ void PairTersoff::allocate()
   memory->create(setflag,n+1,n+1,"pair:setflag");
   memory->create(cutsq,n+1,n+1,"pair:cutsq");
   memory->create(neighshort,maxshort,"pair:neighshort");
+  memory->create(delrshort,maxshort,8,"pair:delrshort");
   map = new int[n+1];
 }
 
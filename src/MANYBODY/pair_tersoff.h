@@ -56,10 +56,11 @@ class PairTersoff : public Pair {
   };
 
  protected:
-  Param *params;      // parameter set for an I-J-K interaction
-  double cutmax;      // max cutoff for all elements
-  int maxshort;       // size of short neighbor list array
-  int *neighshort;    // short neighbor list array
+  Param *params;         // parameter set for an I-J-K interaction
+  double cutmax;         // max cutoff for all elements
+  int maxshort;          // size of short neighbor list array
+  int *neighshort;       // short neighbor list array
+  double **delrshort;    // cached j-i vector, rsq, 1/r and unit vector of short neighbors
 
   int shift_flag;    // flag to turn on/off shift
   double shift;      // negative change in equilibrium bond length
@@ -51,6 +51,7 @@ PairVashishta::PairVashishta(LAMMPS *lmp) : Pair(lmp)
   r0max = 0.0;
   maxshort = 10;
   neighshort = nullptr;
+  delrshort = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -68,6 +69,7 @@ PairVashishta::~PairVashishta()
     memory->destroy(setflag);
     memory->destroy(cutsq);
     memory->destroy(neighshort);
+    memory->destroy(delrshort);
   }
 }
 
@@ -80,7 +82,7 @@ void PairVashishta::compute(int eflag, int vflag)
   tagint itag,jtag;
   double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
   double rsq,rsq1,rsq2;
-  double delr1[3],delr2[3],fj[3],fk[3];
+  double *delr1,*delr2,fj[3],fk[3];
   int *ilist,*jlist,*numneigh,**firstneigh;
 
   evdwl = 0.0;
@@ -128,10 +130,17 @@ void PairVashishta::compute(int eflag, int vflag)
       rsq = delx*delx + dely*dely + delz*delz;
 
       if (rsq < cutshortsq) {
+        double *delrj = delrshort[numshort];
+        delrj[0] = -delx;
+        delrj[1] = -dely;
+        delrj[2] = -delz;
+        delrj[3] = rsq;
+
         neighshort[numshort++] = j;
         if (numshort >= maxshort) {
           maxshort += maxshort/2;
           memory->grow(neighshort,maxshort,"pair:neighshort");
+          memory->grow(delrshort,maxshort,4,"pair:delrshort");
         }
       }
 
@@ -169,10 +178,8 @@ void PairVashishta::compute(int eflag, int vflag)
       j = neighshort[jj];
       jtype = map[type[j]];
       ijparam = elem3param[itype][jtype][jtype];
-      delr1[0] = x[j][0] - xtmp;
-      delr1[1] = x[j][1] - ytmp;
-      delr1[2] = x[j][2] - ztmp;
-      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
+      delr1 = delrshort[jj];
+      rsq1 = delr1[3];
       if (rsq1 >= params[ijparam].cutsq2) continue;
 
       double fjxtmp,fjytmp,fjztmp;
@@ -184,10 +191,8 @@ void PairVashishta::compute(int eflag, int vflag)
         ikparam = elem3param[itype][ktype][ktype];
         ijkparam = elem3param[itype][jtype][ktype];
 
-        delr2[0] = x[k][0] - xtmp;
-        delr2[1] = x[k][1] - ytmp;
-        delr2[2] = x[k][2] - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
+        delr2 = delrshort[kk];
+        rsq2 = delr2[3];
         if (rsq2 >= params[ikparam].cutsq2) continue;
 
         threebody(&params[ijparam],&params[ikparam],&params[ijkparam],
@@ -227,6 +232,7 @@ void PairVashishta::allocate()
   memory->create(setflag,n+1,n+1,"pair:setflag");
   memory->create(cutsq,n+1,n+1,"pair:cutsq");
   memory->create(neighshort,maxshort,"pair:neighshort");
+  memory->create(delrshort,maxshort,4,"pair:delrshort");
 
   map = new int[n+1];
 }
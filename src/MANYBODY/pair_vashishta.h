@@ -48,11 +48,12 @@ class PairVashishta : public Pair {
   };
 
  protected:
-  double cutmax;      // max cutoff for all elements
-  Param *params;      // parameter set for an I-J-K interaction
-  double r0max;       // largest value of r0
-  int maxshort;       // size of short neighbor list array
-  int *neighshort;    // short neighbor list array
+  double cutmax;         // max cutoff for all elements
+  Param *params;         // parameter set for an I-J-K interaction
+  double r0max;          // largest value of r0
+  int maxshort;          // size of short neighbor list array
+  int *neighshort;       // short neighbor list array
+  double **delrshort;    // cached j-i vector and rsq of short neighbors
 
   void allocate();
   void read_file(char *);
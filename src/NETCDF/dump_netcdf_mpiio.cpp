@@ -81,6 +81,9 @@ static constexpr int THIS_IS_A_VARIABLE = -3;
 DumpNetCDFMPIIO::DumpNetCDFMPIIO(LAMMPS *lmp, int narg, char **arg) :
   DumpCustom(lmp, narg, arg)
 {
+  async_allow = 0;
+  mpiio_allow = 0;
+
   // arrays for data rearrangement
 
   sort_flag = 1;
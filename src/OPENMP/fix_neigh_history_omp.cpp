@@ -221,6 +221,7 @@ void FixNeighHistoryOMP::pre_exchange_newton()
     // calculate npartner for each owned+ghost atom
 
     tagint *tag = atom->tag;
+    int *type = atom->type;
 
     NeighList *list = pair->list;
     inum = list->inum;
@@ -234,6 +235,10 @@ void FixNeighHistoryOMP::pre_exchange_newton()
     const int lmax = lfrom + ldelta;
     const int lto = (lmax > nlocal_neigh) ? nlocal_neigh : lmax;
 
+    // ghost atoms are handled by the master thread
+
+    const int ghostflag = (tid == 0);
+
     for (ii = 0; ii < inum; ii++) {
       i = ilist[ii];
       jlist = firstneigh[i];
@@ -246,7 +251,7 @@ void FixNeighHistoryOMP::pre_exchange_newton()
 
           j = jlist[jj];
           j &= NEIGHMASK;
-          if ((j >= lfrom) && (j < lto)) npartner[j]++;
+          if (((j >= lfrom) && (j < lto)) || (ghostflag && (j >= nlocal_neigh))) npartner[j]++;
         }
       }
     }
@@ -265,6 +270,10 @@ void FixNeighHistoryOMP::pre_exchange_newton()
       comm->reverse_comm(this, 0);
     }
 
+#if defined(_OPENMP)
+#pragma omp barrier
+#endif
+
     // get page chunks to store atom IDs and shear history for my atoms
 
     for (ii = 0; ii < inum; ii++) {
@@ -289,6 +298,7 @@ void FixNeighHistoryOMP::pre_exchange_newton()
         if (partner[i] == nullptr || valuepartner[i] == nullptr) {
           error->one(FLERR, "Neighbor history overflow, boost neigh_modify one");
         }
+        npartner[i] = 0;
       }
     }
 
@@ -317,11 +327,14 @@ void FixNeighHistoryOMP::pre_exchange_newton()
             memcpy(&valuepartner[i][dnum * m], onevalues, dnumbytes);
           }
 
-          if ((j >= lfrom) && (j < lto)) {
+          if (((j >= lfrom) && (j < lto)) || (ghostflag && (j >= nlocal_neigh))) {
             m = npartner[j]++;
             partner[j][m] = tag[i];
             jvalues = &valuepartner[j][dnum * m];
-            for (n = 0; n < dnum; n++) jvalues[n] = -onevalues[n];
+            if (pair->nondefault_history_transfer)
+              pair->transfer_history(onevalues, jvalues, type[i], type[j]);
+            else
+              for (n = 0; n < dnum; n++) jvalues[n] = -onevalues[n];
           }
         }
       }
@@ -344,6 +357,10 @@ void FixNeighHistoryOMP::pre_exchange_newton()
       comm->reverse_comm_variable(this);
     }
 
+#if defined(_OPENMP)
+#pragma omp barrier
+#endif
+
     // set maxpartner = max # of partners of any owned atom
     // maxexchange = max # of values for any Comm::exchange() atom
     m = 0;
@@ -396,6 +413,7 @@ void FixNeighHistoryOMP::pre_exchange_no_newton()
     // calculate npartner for each owned atom
 
     tagint *tag = atom->tag;
+    int *type = atom->type;
 
     NeighList *list = pair->list;
     inum = list->inum;
@@ -473,7 +491,10 @@ void FixNeighHistoryOMP::pre_exchange_no_newton()
             m = npartner[j]++;
             partner[j][m] = tag[i];
             jvalues = &valuepartner[j][dnum * m];
-            for (n = 0; n < dnum; n++) jvalues[n] = -onevalues[n];
+            if (pair->nondefault_history_transfer)
+              pair->transfer_history(onevalues, jvalues, type[i], type[j]);
+            else
+              for (n = 0; n < dnum; n++) jvalues[n] = -onevalues[n];
           }
         }
       }
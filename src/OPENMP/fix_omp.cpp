@@ -189,11 +189,12 @@ void FixOMP::init()
     }
   }
 
-  // reset per thread timer
+  // reset per thread timer and record trace events like the global timer
   for (int i=0; i < nthreads; ++i) {
     thr[i]->_timer_active=1;
     thr[i]->timer(Timer::RESET);
     thr[i]->_timer_active=-1;
+    thr[i]->_timer->init_trace(timer);
   }
 
   if (utils::strmatch(update->integrate_style,"^respa")
@@ -302,6 +303,16 @@ void FixOMP::setup(int)
 
 /* ---------------------------------------------------------------------- */
 
+void FixOMP::post_run()
+{
+  // hand over trace events of the per thread timers to the global timer,
+  // which writes them at the end of the run
+  for (int i=0; i < _nthr; ++i)
+    timer->merge_trace(thr[i]->_timer,i);
+}
+
+/* ---------------------------------------------------------------------- */
+
 // adjust size and clear out per thread accumulator arrays
 void FixOMP::pre_force(int)
 {
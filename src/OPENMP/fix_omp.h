@@ -38,6 +38,7 @@ class FixOMP : public Fix {
   void setup(int) override;
   void min_setup(int flag) override { setup(flag); }
   void pre_force(int) override;
+  void post_run() override;
 
   void setup_pre_force(int vflag) override { pre_force(vflag); }
   virtual void min_setup_pre_force(int vflag) { pre_force(vflag); }
@@ -279,6 +279,10 @@ void FixQEqReaxFFOMP::pre_force(int /* vflag */)
 
   if (dual_enabled) {
     matvecs = dual_CG(b_s, b_t, s, t);
+  } else if (pipelined_enabled) {
+    matvecs_s = pipelined_CG(b_s, s);
+    matvecs_t = pipelined_CG(b_t, t);
+    matvecs = matvecs_s + matvecs_t;
   } else {
     matvecs_s = CG(b_s, s);     // CG on s - parallel
     matvecs_t = CG(b_t, t);     // CG on t - parallel
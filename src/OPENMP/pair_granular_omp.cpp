@@ -0,0 +1,346 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_granular_omp.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "fix.h"
+#include "fix_neigh_history.h"
+#include "force.h"
+#include "granular_model.h"
+#include "math_extra.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+#include "update.h"
+
+#include "omp_compat.h"
+#include "suffix.h"
+
+using namespace LAMMPS_NS;
+using namespace Granular_NS;
+using namespace MathExtra;
+
+/* ---------------------------------------------------------------------- */
+
+PairGranularOMP::PairGranularOMP(LAMMPS *lmp) :
+  PairGranular(lmp), ThrOMP(lmp, THR_PAIR)
+{
+  suffix_flag |= Suffix::OMP;
+  respa_enable = 0;
+
+  nthr_models = 0;
+  thr_models_stale = 1;
+  thr_models = nullptr;
+  heatflow_thr = nullptr;
+  nmax_heat = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairGranularOMP::~PairGranularOMP()
+{
+  destroy_thr_models();
+  memory->destroy(heatflow_thr);
+}
+
+/* ----------------------------------------------------------------------
+   model coefficients may change between runs, so the per-thread
+   copies are rebuilt on the first compute() after any init
+------------------------------------------------------------------------- */
+
+void PairGranularOMP::init_style()
+{
+  PairGranular::init_style();
+  thr_models_stale = 1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairGranularOMP::reset_dt()
+{
+  PairGranular::reset_dt();
+  for (int t = 0; t < nthr_models; t++)
+    for (int m = 0; m < nmodels; m++) thr_models[t][m]->dt = update->dt;
+}
+
+/* ----------------------------------------------------------------------
+   each GranularModel stores the state of the contact being computed,
+   so every thread works on its own copy of all models
+------------------------------------------------------------------------- */
+
+void PairGranularOMP::create_thr_models()
+{
+  destroy_thr_models();
+
+  nthr_models = comm->nthreads;
+  thr_models = new GranularModel **[nthr_models];
+  for (int t = 0; t < nthr_models; t++) {
+    thr_models[t] = new GranularModel *[nmodels];
+    for (int m = 0; m < nmodels; m++) {
+      thr_models[t][m] = new GranularModel(Pointers::lmp);
+      thr_models[t][m]->copy_model(models_list[m]);
+    }
+  }
+  thr_models_stale = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairGranularOMP::destroy_thr_models()
+{
+  if (!thr_models) return;
+
+  for (int t = 0; t < nthr_models; t++) {
+    for (int m = 0; m < nmodels; m++) delete thr_models[t][m];
+    delete[] thr_models[t];
+  }
+  delete[] thr_models;
+  thr_models = nullptr;
+  nthr_models = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairGranularOMP::compute(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  if (thr_models_stale || (nthr_models != comm->nthreads)) create_thr_models();
+
+  const int history_update = update->setupflag == 0;
+  for (int t = 0; t < nthr_models; t++)
+    for (int m = 0; m < nmodels; m++) thr_models[t][m]->history_update = history_update;
+
+  // update rigid body info for owned & ghost atoms if using FixRigid masses
+  // body[i] = which body atom I is in, -1 if none
+  // mass_body = mass of each rigid body
+
+  if (fix_rigid && neighbor->ago == 0) {
+    int tmp;
+    int *body = (int *) fix_rigid->extract("body",tmp);
+    auto mass_body = (double *) fix_rigid->extract("masstotal",tmp);
+    if (atom->nmax > nmax) {
+      memory->destroy(mass_rigid);
+      nmax = atom->nmax;
+      memory->create(mass_rigid,nmax,"pair:mass_rigid");
+    }
+    int nlocal = atom->nlocal;
+    for (int i = 0; i < nlocal; i++)
+      if (body[i] >= 0) mass_rigid[i] = mass_body[body[i]];
+      else mass_rigid[i] = 0.0;
+    comm->forward_comm(this);
+  }
+
+  const int nall = atom->nlocal + atom->nghost;
+  const int nthreads = comm->nthreads;
+  const int inum = list->inum;
+
+  // heatflow is not part of the per-thread data managed by fix omp,
+  // so it is accumulated in a private buffer and reduced at the end
+
+  if (heat_flag && (nthreads * atom->nmax > nmax_heat)) {
+    memory->destroy(heatflow_thr);
+    nmax_heat = nthreads * atom->nmax;
+    memory->create(heatflow_thr,nmax_heat,"pair:heatflow_thr");
+  }
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
+#endif
+  {
+    int ifrom, ito, tid;
+
+    loop_setup_thr(ifrom, ito, tid, inum, nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+    ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
+    if (heat_flag)
+      for (int i = 0; i < nall; i++) heatflow_thr[tid*nall+i] = 0.0;
+
+    if (evflag) {
+      if (force->newton_pair) eval<1,1>(ifrom, ito, thr);
+      else eval<1,0>(ifrom, ito, thr);
+    } else {
+      if (force->newton_pair) eval<0,1>(ifrom, ito, thr);
+      else eval<0,0>(ifrom, ito, thr);
+    }
+
+    if (heat_flag) data_reduce_thr(heatflow_thr, nall, nthreads, 1, tid);
+
+    thr->timer(Timer::PAIR);
+    reduce_thr(this, eflag, vflag, thr);
+  } // end of omp parallel region
+
+  if (heat_flag) {
+    double *heatflow = atom->heatflow;
+    for (int i = 0; i < nall; i++) heatflow[i] += heatflow_thr[i];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   threads are partitioned over I, and the contact history of a pair is
+   stored in the neighbor list row of I, so each thread only ever writes
+   its own history slots and no locking is needed
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int NEWTON_PAIR>
+void PairGranularOMP::eval(int iifrom, int iito, ThrData * const thr)
+{
+  int i,j,k,ii,jj,jnum,itype,jtype;
+  double factor_lj,mi,mj,meff;
+  double *forces, *torquesi, *torquesj, dq;
+
+  int *jlist;
+  int *touch = nullptr, **firsttouch = nullptr;
+  double *history, *allhistory = nullptr, **firsthistory = nullptr;
+
+  GranularModel *model;
+  GranularModel **models = thr_models[thr->get_tid()];
+
+  double * const * const x = atom->x;
+  double * const * const v = atom->v;
+  double * const * const omega = atom->omega;
+  const double * const radius = atom->radius;
+  const double * const rmass = atom->rmass;
+  const int * const type = atom->type;
+  const int * const mask = atom->mask;
+  double * const * const f = thr->get_f();
+  double * const * const torque = thr->get_torque();
+  const int nlocal = atom->nlocal;
+  const double * const special_lj = force->special_lj;
+
+  const double *temperature = nullptr;
+  double *heatflow = nullptr;
+  if (heat_flag) {
+    temperature = atom->temperature;
+    heatflow = heatflow_thr + thr->get_tid() * (atom->nlocal + atom->nghost);
+  }
+
+  const int * const ilist = list->ilist;
+  const int * const numneigh = list->numneigh;
+  int ** const firstneigh = list->firstneigh;
+  if (use_history) {
+    firsttouch = fix_history->firstflag;
+    firsthistory = fix_history->firstvalue;
+  }
+
+  for (ii = iifrom; ii < iito; ++ii) {
+    i = ilist[ii];
+    itype = type[i];
+    if (use_history) {
+      touch = firsttouch[i];
+      allhistory = firsthistory[i];
+    }
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      if (factor_lj == 0) continue;
+
+      jtype = type[j];
+      model = models[types_indices[itype][jtype]];
+
+      // Reset model and copy initial geometric data
+      model->xi = x[i];
+      model->xj = x[j];
+      model->radi = radius[i];
+      model->radj = radius[j];
+      if (use_history) model->touch = touch[jj];
+
+      if (!model->check_contact()) {
+        // unset non-touching neighbors
+        if (use_history) {
+          touch[jj] = 0;
+          history = &allhistory[size_history * jj];
+          for (k = 0; k < size_history; k++) history[k] = 0.0;
+        }
+        continue;
+      }
+
+      if (use_history) touch[jj] = 1;
+
+      // meff = effective mass of pair of particles
+      // if I or J part of rigid body, use body mass
+      // if I or J is frozen, meff is other particle
+      mi = rmass[i];
+      mj = rmass[j];
+      if (fix_rigid) {
+        if (mass_rigid[i] > 0.0) mi = mass_rigid[i];
+        if (mass_rigid[j] > 0.0) mj = mass_rigid[j];
+      }
+      meff = mi * mj / (mi + mj);
+      if (mask[i] & freeze_group_bit) meff = mj;
+      if (mask[j] & freeze_group_bit) meff = mi;
+
+      // Copy additional information and prepare force calculations
+      model->meff = meff;
+      model->vi = v[i];
+      model->vj = v[j];
+      model->omegai = omega[i];
+      model->omegaj = omega[j];
+      if (use_history) {
+        history = &allhistory[size_history * jj];
+        model->history = history;
+      }
+
+      if (heat_flag) {
+        model->Ti = temperature[i];
+        model->Tj = temperature[j];
+      }
+
+      model->calculate_forces();
+
+      forces = model->forces;
+      torquesi = model->torquesi;
+      torquesj = model->torquesj;
+
+      // apply forces & torques
+      scale3(factor_lj, forces);
+      add3(f[i], forces, f[i]);
+
+      scale3(factor_lj, torquesi);
+      add3(torque[i], torquesi, torque[i]);
+
+      if (NEWTON_PAIR || j < nlocal) {
+        sub3(f[j], forces, f[j]);
+        scale3(factor_lj, torquesj);
+        add3(torque[j], torquesj, torque[j]);
+      }
+
+      if (heat_flag) {
+        dq = model->dq;
+        heatflow[i] += dq;
+        if (NEWTON_PAIR || j < nlocal) heatflow[j] -= dq;
+      }
+
+      if (EVFLAG)
+        ev_tally_xyz_thr(this,i,j,nlocal,NEWTON_PAIR,0.0,0.0,forces[0],forces[1],forces[2],
+                         model->dx[0],model->dx[1],model->dx[2],thr);
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairGranularOMP::memory_usage()
+{
+  double bytes = memory_usage_thr();
+  bytes += PairGranular::memory_usage();
+  bytes += (double) nmax_heat * sizeof(double);
+
+  return bytes;
+}
@@ -0,0 +1,56 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(granular/omp,PairGranularOMP);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_GRANULAR_OMP_H
+#define LMP_PAIR_GRANULAR_OMP_H
+
+#include "pair_granular.h"
+#include "thr_omp.h"
+
+namespace LAMMPS_NS {
+
+class PairGranularOMP : public PairGranular, public ThrOMP {
+
+ public:
+  PairGranularOMP(class LAMMPS *);
+  ~PairGranularOMP() override;
+
+  void compute(int, int) override;
+  void init_style() override;
+  void reset_dt() override;
+  double memory_usage() override;
+
+ private:
+  int nthr_models;                                    // # of threads with model copies
+  int thr_models_stale;                               // 1 if copies must be rebuilt
+  class Granular_NS::GranularModel ***thr_models;    // per-thread copies of models_list
+  double *heatflow_thr;                               // per-thread heatflow accumulators
+  int nmax_heat;                                      // allocated size of heatflow_thr
+
+  void create_thr_models();
+  void destroy_thr_models();
+
+  template <int EVFLAG, int NEWTON_PAIR>
+  void eval(int ifrom, int ito, ThrData *const thr);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
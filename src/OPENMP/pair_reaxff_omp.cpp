@@ -84,6 +84,8 @@ PairReaxFFOMP::PairReaxFFOMP(LAMMPS *lmp) : PairReaxFF(lmp), ThrOMP(lmp, THR_PAI
   api->system->omp_active = 1;
 
   num_nbrs_offset = nullptr;
+  max_nbrs_offset = 0;
+  num_far_nbrs = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -153,12 +155,6 @@ void PairReaxFFOMP::setup()
   api->system->N = atom->nlocal + atom->nghost; // mine + ghosts
   oldN = api->system->N;
 
-  if (api->system->N > nmax) {
-    memory->destroy(num_nbrs_offset);
-    // Don't update nmax here. It is updated at end of compute().
-    memory->create(num_nbrs_offset, api->system->N, "pair:num_nbrs_offset");
-  }
-
   if (setup_flag == 0) {
 
     setup_flag = 1;
@@ -181,6 +177,7 @@ void PairReaxFFOMP::setup()
     int num_nbrs = estimate_reax_lists();
     if (num_nbrs < 0)
       error->all(FLERR,"Too many neighbors for pair style reaxff");
+    num_nbrs = MAX(num_nbrs, mincap*REAX_MIN_NBRS);
 
     Make_List(api->system->total_cap,num_nbrs,TYP_FAR_NEIGHBOR,api->lists+FAR_NBRS);
     (api->lists+FAR_NBRS)->error_ptr=error;
@@ -204,9 +201,11 @@ void PairReaxFFOMP::setup()
     for (int k = oldN; k < api->system->N; ++k)
       Set_End_Index(k, Start_Index(k, api->lists+BONDS), api->lists+BONDS);
 
-    // estimate far neighbor list size
+    // estimate far neighbor list size only for a new neighbor list.
+    // between reneighborings the neighbor offsets include the skin distance.
     // Not present in MPI-only version
-    api->workspace->realloc.num_far = estimate_reax_lists();
+
+    if (neighbor->ago == 0) api->workspace->realloc.num_far = estimate_reax_lists();
 
     // check if I need to shrink/extend my data-structs
 
@@ -372,36 +371,80 @@ void PairReaxFFOMP::write_reax_atoms()
 
 int PairReaxFFOMP::estimate_reax_lists()
 {
-  int i;
+  double d_sqr, cutoff_sqr;
+  rvec dvec;
+
+  double **x = atom->x;
   int *ilist = list->ilist;
   int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  int inum = list->inum;
   int numall = list->inum + list->gnum;
-  int mincap = api->system->mincap;
 
   // for good performance in the OpenMP implementation, each thread needs
   // to know where to place the neighbors of the atoms it is responsible for.
-  // The sumscan values for the list->numneigh will be used to determine the
-  // neighbor offset of each atom. Note that this may cause some significant
-  // memory overhead if delayed neighboring is used - so it may be desirable
-  // to work on this part to reduce the memory footprint of the far_nbrs list.
+  // count the neighbors with the same cutoffs as in write_reax_lists(),
+  // so that ghost atom neighbors beyond the bond cutoff are not included,
+  // and store the sumscan of the counts as neighbor offset of each atom.
+  // the cutoffs are extended by the neighbor skin, so that the offsets
+  // remain valid until the next reneighboring. offsets from the exact
+  // counts would overflow and trigger a recount on almost every step.
 
-  int num_nbrs = 0;
+  const double skin = neighbor->skin;
+
+  // the offsets must persist between reneighborings,
+  // so the array only grows here, where it is filled
 
+  if (api->system->N > max_nbrs_offset) {
+    memory->destroy(num_nbrs_offset);
+    max_nbrs_offset = api->system->N;
+    memory->create(num_nbrs_offset, max_nbrs_offset, "pair:num_nbrs_offset");
+  }
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic,50) default(shared)           \
+  private(cutoff_sqr, d_sqr, dvec)
+#endif
   for (int itr_i = 0; itr_i < numall; ++itr_i) {
-    i = ilist[itr_i];
-    num_nbrs += numneigh[i];
+    int i = ilist[itr_i];
+    int *jlist = firstneigh[i];
+
+    if (i < inum)
+      cutoff_sqr = SQR(api->control->nonb_cut + skin);
+    else
+      cutoff_sqr = SQR(api->control->bond_cut + skin);
+
+    int num_mynbrs = 0;
+
+    for (int itr_j = 0; itr_j < numneigh[i]; ++itr_j) {
+      int j = jlist[itr_j];
+      j &= NEIGHMASK;
+      get_distance(x[j], x[i], &d_sqr, &dvec);
+
+      if (d_sqr <= cutoff_sqr)
+        ++num_mynbrs;
+    }
+    num_nbrs_offset[i] = num_mynbrs;
   }
 
-  int new_estimate = MAX(num_nbrs, mincap*REAX_MIN_NBRS);
+  int num_nbrs = 0;
+
+  for (int itr_i = 0; itr_i < numall; ++itr_i) {
+    int i = ilist[itr_i];
+    int num_mynbrs = num_nbrs_offset[i];
+    num_nbrs_offset[i] = num_nbrs;
+    num_nbrs += num_mynbrs;
+  }
+  num_far_nbrs = num_nbrs;
 
-  return new_estimate;
+  return num_nbrs;
 }
 
 /* ---------------------------------------------------------------------- */
 
 int PairReaxFFOMP::write_reax_lists()
 {
-  int num_mynbrs;
+  int num_mynbrs, max_mynbrs, overflow;
   double d_sqr, dist, cutoff_sqr;
   rvec dvec;
 
@@ -410,56 +453,70 @@ int PairReaxFFOMP::write_reax_lists()
   int *numneigh = list->numneigh;
   int **firstneigh = list->firstneigh;
   reax_list *far_nbrs = api->lists + FAR_NBRS;
-  far_neighbor_data *far_list = far_nbrs->select.far_nbr_list;
 
-  int num_nbrs = 0;
   int inum = list->inum;
   int gnum = list->gnum;
   int numall = inum + gnum;
 
-  // sumscan of the number of neighbors per atom to determine the offsets
-  // most likely, we are overallocating. desirable to work on this part
-  // to reduce the memory footprint of the far_nbrs list.
-
-  num_nbrs = 0;
-
-  for (int itr_i = 0; itr_i < numall; ++itr_i) {
-    int i = ilist[itr_i];
-    num_nbrs_offset[i] = num_nbrs;
-    num_nbrs += numneigh[i];
-  }
+  // the neighbor offsets were computed by estimate_reax_lists()
+  // during setup() for the current neighbor list.
+  // if an atom has more neighbors than fit between its offset and the
+  // offset of the next atom, e.g. because atoms moved further than the
+  // skin distance, count the neighbors again and repeat.
+
+  do {
+    if (num_far_nbrs > far_nbrs->num_intrs) {
+      const int num_nbrs = MAX(num_far_nbrs, api->system->mincap*REAX_MIN_NBRS);
+      Delete_List(far_nbrs);
+      Make_List(api->system->total_cap,num_nbrs,TYP_FAR_NEIGHBOR,far_nbrs);
+      far_nbrs->error_ptr=error;
+    }
+    far_neighbor_data *far_list = far_nbrs->select.far_nbr_list;
+    overflow = 0;
 
 #if defined(_OPENMP)
 #pragma omp parallel for schedule(dynamic,50) default(shared)           \
-  private(cutoff_sqr, num_mynbrs, d_sqr, dvec, dist)
+  private(cutoff_sqr, num_mynbrs, max_mynbrs, d_sqr, dvec, dist) reduction(+:overflow)
 #endif
-  for (int itr_i = 0; itr_i < numall; ++itr_i) {
-    int i = ilist[itr_i];
-    auto jlist = firstneigh[i];
-    Set_Start_Index(i, num_nbrs_offset[i], far_nbrs);
-
-    if (i < inum)
-      cutoff_sqr = SQR(api->control->nonb_cut);
-    else
-      cutoff_sqr = SQR(api->control->bond_cut);
-
-    num_mynbrs = 0;
-
-    for (int itr_j = 0; itr_j < numneigh[i]; ++itr_j) {
-      int j = jlist[itr_j];
-      j &= NEIGHMASK;
-      get_distance(x[j], x[i], &d_sqr, &dvec);
-
-      if (d_sqr <= cutoff_sqr) {
-        dist = sqrt(d_sqr);
-        set_far_nbr(&far_list[num_nbrs_offset[i] + num_mynbrs], j, dist, dvec);
-        ++num_mynbrs;
+    for (int itr_i = 0; itr_i < numall; ++itr_i) {
+      int i = ilist[itr_i];
+      auto jlist = firstneigh[i];
+      Set_Start_Index(i, num_nbrs_offset[i], far_nbrs);
+
+      if (itr_i+1 < numall)
+        max_mynbrs = num_nbrs_offset[ilist[itr_i+1]] - num_nbrs_offset[i];
+      else
+        max_mynbrs = num_far_nbrs - num_nbrs_offset[i];
+
+      if (i < inum)
+        cutoff_sqr = SQR(api->control->nonb_cut);
+      else
+        cutoff_sqr = SQR(api->control->bond_cut);
+
+      num_mynbrs = 0;
+
+      for (int itr_j = 0; itr_j < numneigh[i]; ++itr_j) {
+        int j = jlist[itr_j];
+        j &= NEIGHMASK;
+        get_distance(x[j], x[i], &d_sqr, &dvec);
+
+        if (d_sqr <= cutoff_sqr) {
+          if (num_mynbrs == max_mynbrs) {
+            ++overflow;
+            break;
+          }
+          dist = sqrt(d_sqr);
+          set_far_nbr(&far_list[num_nbrs_offset[i] + num_mynbrs], j, dist, dvec);
+          ++num_mynbrs;
+        }
       }
+      Set_End_Index(i, num_nbrs_offset[i] + num_mynbrs, far_nbrs);
     }
-    Set_End_Index(i, num_nbrs_offset[i] + num_mynbrs, far_nbrs);
-  }
 
-  return num_nbrs;
+    if (overflow) api->workspace->realloc.num_far = estimate_reax_lists();
+  } while (overflow);
+
+  return num_far_nbrs;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -106,6 +106,8 @@ class PairReaxFFOMP : public PairReaxFF, public ThrOMP {
 
   // work array used in write_reax_lists()
   int *num_nbrs_offset;
+  int max_nbrs_offset;    // allocated length of num_nbrs_offset
+  int num_far_nbrs;    // total number of far neighbors for num_nbrs_offset
 };
 
 }    // namespace LAMMPS_NS
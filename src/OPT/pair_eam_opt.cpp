@@ -27,6 +27,7 @@
 #include "force.h"
 #include "memory.h"
 #include "neigh_list.h"
+#include "suffix.h"
 #include "update.h"
 
 #include <cmath>
@@ -35,7 +36,10 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-PairEAMOpt::PairEAMOpt(LAMMPS *lmp) : PairEAM(lmp) {}
+PairEAMOpt::PairEAMOpt(LAMMPS *lmp) : PairEAM(lmp)
+{
+  suffix_flag |= Suffix::OPT;
+}
 
 /* ---------------------------------------------------------------------- */
 
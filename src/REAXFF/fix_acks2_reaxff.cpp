@@ -118,7 +118,9 @@ void FixACKS2ReaxFF::post_constructor()
 
   pertype_parameters(pertype_option);
   if (dual_enabled)
-    error->all(FLERR,"Dual keyword only supported with fix qeq/reax/omp");
+    error->all(FLERR,"Fix acks2/reaxff does not support the dual keyword");
+  if (pipelined_enabled)
+    error->all(FLERR,"Fix acks2/reaxff does not support the pipelined keyword");
 }
 
 /* ---------------------------------------------------------------------- */
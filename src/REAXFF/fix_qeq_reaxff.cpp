@@ -74,7 +74,7 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
   imax = 200;
   maxwarn = 1;
 
-  if ((narg < 8) || (narg > 12)) error->all(FLERR,"Illegal fix qeq/reaxff command");
+  if ((narg < 8) || (narg > 13)) error->all(FLERR,"Illegal fix qeq/reaxff command");
 
   nevery = utils::inumeric(FLERR,arg[3],false,lmp);
   if (nevery <= 0) error->all(FLERR,"Illegal fix qeq/reaxff command");
@@ -84,14 +84,16 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
   tolerance = utils::numeric(FLERR,arg[6],false,lmp);
   pertype_option = utils::strdup(arg[7]);
 
-  // dual CG support only available for OPENMP variant
+  // dual CG support is not available for the KOKKOS variant
   // check for compatibility is in Fix::post_constructor()
 
   dual_enabled = 0;
+  pipelined_enabled = 0;
 
   int iarg = 8;
   while (iarg < narg) {
     if (strcmp(arg[iarg],"dual") == 0) dual_enabled = 1;
+    else if (strcmp(arg[iarg],"pipelined") == 0) pipelined_enabled = 1;
     else if (strcmp(arg[iarg],"nowarn") == 0) maxwarn = 0;
     else if (strcmp(arg[iarg],"maxiter") == 0) {
       if (iarg+1 > narg-1)
@@ -101,6 +103,8 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
     } else error->all(FLERR,"Illegal fix {} command", style);
     iarg++;
   }
+  if (dual_enabled && pipelined_enabled)
+    error->all(FLERR,"Fix {} keywords dual and pipelined cannot be used together", style);
   shld = nullptr;
 
   nn = n_cap = 0;
@@ -125,6 +129,14 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
   r = nullptr;
   d = nullptr;
 
+  // pipelined CG
+
+  u = nullptr;
+  w = nullptr;
+  z = nullptr;
+  ap = nullptr;
+  mp = nullptr;
+
   // H matrix
 
   H.firstnbr = nullptr;
@@ -186,8 +198,10 @@ void FixQEqReaxFF::post_constructor()
       s_hist[i][j] = t_hist[i][j] = 0;
 
   pertype_parameters(pertype_option);
-  if (dual_enabled)
-    error->all(FLERR,"Dual keyword only supported with fix qeq/reaxff/omp");
+  if (dual_enabled && kokkosable)
+    error->all(FLERR,"Dual keyword is not supported with fix {}", style);
+  if (pipelined_enabled && kokkosable)
+    error->all(FLERR,"Pipelined keyword is not supported with fix {}", style);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -285,6 +299,14 @@ void FixQEqReaxFF::allocate_storage()
   memory->create(q,size,"qeq:q");
   memory->create(r,size,"qeq:r");
   memory->create(d,size,"qeq:d");
+
+  if (pipelined_enabled) {
+    memory->create(u,nmax,"qeq:u");
+    memory->create(w,nmax,"qeq:w");
+    memory->create(z,nmax,"qeq:z");
+    memory->create(ap,nmax,"qeq:ap");
+    memory->create(mp,nmax,"qeq:mp");
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -305,6 +327,12 @@ void FixQEqReaxFF::deallocate_storage()
   memory->destroy(q);
   memory->destroy(r);
   memory->destroy(d);
+
+  memory->destroy(u);
+  memory->destroy(w);
+  memory->destroy(z);
+  memory->destroy(ap);
+  memory->destroy(mp);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -586,9 +614,17 @@ void FixQEqReaxFF::pre_force(int /*vflag*/)
 
   init_matvec();
 
-  matvecs_s = CG(b_s, s);       // CG on s - parallel
-  matvecs_t = CG(b_t, t);       // CG on t - parallel
-  matvecs = matvecs_s + matvecs_t;
+  if (dual_enabled) {
+    matvecs = dual_CG(b_s, b_t, s, t);
+  } else if (pipelined_enabled) {
+    matvecs_s = pipelined_CG(b_s, s);
+    matvecs_t = pipelined_CG(b_t, t);
+    matvecs = matvecs_s + matvecs_t;
+  } else {
+    matvecs_s = CG(b_s, s);     // CG on s - parallel
+    matvecs_t = CG(b_t, t);     // CG on t - parallel
+    matvecs = matvecs_s + matvecs_t;
+  }
 
   calculate_Q();
 }
@@ -744,8 +780,21 @@ int FixQEqReaxFF::CG(double *b, double *x)
       d[j] = r[j] * Hdia_inv[j]; //pre-condition
   }
 
-  b_norm = parallel_norm(b, nn);
-  sig_new = parallel_dot(r, d, nn);
+  // combine the reductions for the norm of b and the initial residual
+
+  double my_buf[2], buf[2];
+  my_buf[0] = my_buf[1] = 0.0;
+  for (jj = 0; jj < nn; ++jj) {
+    j = ilist[jj];
+    if (atom->mask[j] & groupbit) {
+      my_buf[0] += b[j] * b[j];
+      my_buf[1] += r[j] * d[j];
+    }
+  }
+  MPI_Allreduce(my_buf, buf, 2, MPI_DOUBLE, MPI_SUM, world);
+
+  b_norm = sqrt(buf[0]);
+  sig_new = buf[1];
 
   for (i = 1; i < imax && sqrt(sig_new) / b_norm > tolerance; ++i) {
     comm->forward_comm(this); //Dist_vector(d);
@@ -778,6 +827,270 @@ int FixQEqReaxFF::CG(double *b, double *x)
   return i;
 }
 
+/* ----------------------------------------------------------------------
+   preconditioned pipelined CG (Ghysels and Vanroose, Parallel Comput. 40, 224 (2014))
+   all dot products of an iteration are combined into one reduction, which
+   overlaps with the preconditioner and the matrix-vector product
+   u = M^-1 r, w = A u, ap = A p, mp = M^-1 ap, z = A mp
+   the matrix-vector product uses d as input and q as output, so that
+   the communication for pack_flag = 1 can be reused
+------------------------------------------------------------------------- */
+
+int FixQEqReaxFF::pipelined_CG(double *b, double *x)
+{
+  int i, ii, jj;
+  double alpha, beta, b_norm, gamma, gamma_old, delta;
+  double my_buf[3], buf[3];
+
+  // the recurrences for r, u, and w accumulate rounding errors faster than
+  // in standard CG, so the residual is recomputed from x in regular intervals
+
+  constexpr int RESTART = 50;
+
+  int *mask = atom->mask;
+  int restart = 1;
+
+  alpha = gamma_old = b_norm = 1.0;
+  pack_flag = 1;
+
+  for (i = 1; i < imax; ++i) {
+
+    if (restart) {
+      for (jj = 0; jj < nn; ++jj) {
+        ii = ilist[jj];
+        if (mask[ii] & groupbit) d[ii] = x[ii];
+      }
+
+      comm->forward_comm(this); //Dist_vector(d);
+      sparse_matvec(&H, d, q);
+      comm->reverse_comm(this); //Coll_vector(q);
+
+      for (jj = 0; jj < nn; ++jj) {
+        ii = ilist[jj];
+        if (mask[ii] & groupbit) {
+          r[ii] = b[ii] - q[ii];
+          u[ii] = r[ii] * Hdia_inv[ii];
+          d[ii] = u[ii];
+          p[ii] = ap[ii] = mp[ii] = z[ii] = 0.0;
+        }
+      }
+
+      comm->forward_comm(this); //Dist_vector(d);
+      sparse_matvec(&H, d, q);
+      comm->reverse_comm(this); //Coll_vector(q);
+
+      for (jj = 0; jj < nn; ++jj) {
+        ii = ilist[jj];
+        if (mask[ii] & groupbit) w[ii] = q[ii];
+      }
+    }
+
+    // the norm of b is included in the first reduction
+
+    my_buf[0] = my_buf[1] = my_buf[2] = 0.0;
+    for (jj = 0; jj < nn; ++jj) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) {
+        my_buf[0] += r[ii] * u[ii];
+        my_buf[1] += w[ii] * u[ii];
+        if (i == 1) my_buf[2] += b[ii] * b[ii];
+      }
+    }
+
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+    MPI_Request request;
+    MPI_Iallreduce(my_buf, buf, 3, MPI_DOUBLE, MPI_SUM, world, &request);
+#else
+    MPI_Allreduce(my_buf, buf, 3, MPI_DOUBLE, MPI_SUM, world);
+#endif
+
+    // pre-conditioning and matrix-vector product while the reduction is in flight
+
+    for (jj = 0; jj < nn; ++jj) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) d[ii] = w[ii] * Hdia_inv[ii];
+    }
+
+    comm->forward_comm(this); //Dist_vector(d);
+    sparse_matvec(&H, d, q);
+    comm->reverse_comm(this); //Coll_vector(q);
+
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+#endif
+
+    gamma = buf[0];
+    delta = buf[1];
+    if (i == 1) b_norm = sqrt(buf[2]);
+    if (sqrt(gamma) / b_norm <= tolerance) break;
+
+    if (restart) {
+      beta = 0.0;
+      alpha = gamma / delta;
+    } else {
+      beta = gamma / gamma_old;
+      alpha = gamma / (delta - beta * gamma / alpha);
+    }
+    gamma_old = gamma;
+    restart = ((i % RESTART) == 0);
+
+    for (jj = 0; jj < nn; ++jj) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) {
+        z[ii] = q[ii] + beta * z[ii];
+        mp[ii] = d[ii] + beta * mp[ii];
+        ap[ii] = w[ii] + beta * ap[ii];
+        p[ii] = u[ii] + beta * p[ii];
+
+        x[ii] += alpha * p[ii];
+        r[ii] -= alpha * ap[ii];
+        u[ii] -= alpha * mp[ii];
+        w[ii] -= alpha * z[ii];
+      }
+    }
+  }
+
+  if ((i >= imax) && maxwarn && (comm->me == 0))
+    error->warning(FLERR, "Fix {} pipelined CG convergence failed after {} iterations at step {}",
+                   style, i, update->ntimestep);
+  return i;
+}
+
+/* ----------------------------------------------------------------------
+   solve the s and t systems simultaneously
+   vectors d, p, q, r hold interleaved s and t values, so both systems
+   share one matrix traversal and one communication and reduction per step
+------------------------------------------------------------------------- */
+
+int FixQEqReaxFF::dual_CG(double *b1, double *b2, double *x1, double *x2)
+{
+  int i, ii, jj, indxI;
+  double alpha_s, alpha_t, beta_s, beta_t, b_norm_s, b_norm_t;
+  double sig_old_s, sig_old_t, sig_new_s, sig_new_t;
+  double my_buf[4], buf[4];
+
+  int *mask = atom->mask;
+
+  pack_flag = 5; // forward 2x d and reverse 2x q
+  dual_sparse_matvec(&H, x1, x2, q);
+  comm->reverse_comm(this); //Coll_Vector(q);
+
+  my_buf[0] = my_buf[1] = my_buf[2] = my_buf[3] = 0.0;
+  for (jj = 0; jj < nn; ++jj) {
+    ii = ilist[jj];
+    if (mask[ii] & groupbit) {
+      indxI = 2 * ii;
+      r[indxI] = b1[ii] - q[indxI];
+      r[indxI+1] = b2[ii] - q[indxI+1];
+
+      d[indxI] = r[indxI] * Hdia_inv[ii]; //pre-condition
+      d[indxI+1] = r[indxI+1] * Hdia_inv[ii];
+
+      my_buf[0] += b1[ii] * b1[ii];
+      my_buf[1] += b2[ii] * b2[ii];
+      my_buf[2] += r[indxI] * d[indxI];
+      my_buf[3] += r[indxI+1] * d[indxI+1];
+    }
+  }
+
+  MPI_Allreduce(my_buf, buf, 4, MPI_DOUBLE, MPI_SUM, world);
+
+  b_norm_s = sqrt(buf[0]);
+  b_norm_t = sqrt(buf[1]);
+  sig_new_s = buf[2];
+  sig_new_t = buf[3];
+
+  for (i = 1; i < imax; ++i) {
+    comm->forward_comm(this); //Dist_vector(d);
+    dual_sparse_matvec(&H, d, q);
+    comm->reverse_comm(this); //Coll_vector(q);
+
+    my_buf[0] = my_buf[1] = 0.0;
+    for (jj = 0; jj < nn; jj++) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) {
+        indxI = 2 * ii;
+        my_buf[0] += d[indxI] * q[indxI];
+        my_buf[1] += d[indxI+1] * q[indxI+1];
+      }
+    }
+
+    MPI_Allreduce(my_buf, buf, 2, MPI_DOUBLE, MPI_SUM, world);
+
+    alpha_s = sig_new_s / buf[0];
+    alpha_t = sig_new_t / buf[1];
+
+    my_buf[0] = my_buf[1] = 0.0;
+    for (jj = 0; jj < nn; jj++) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) {
+        indxI = 2 * ii;
+        x1[ii] += alpha_s * d[indxI];
+        x2[ii] += alpha_t * d[indxI+1];
+
+        r[indxI] -= alpha_s * q[indxI];
+        r[indxI+1] -= alpha_t * q[indxI+1];
+
+        // pre-conditioning
+        p[indxI] = r[indxI] * Hdia_inv[ii];
+        p[indxI+1] = r[indxI+1] * Hdia_inv[ii];
+
+        my_buf[0] += r[indxI] * p[indxI];
+        my_buf[1] += r[indxI+1] * p[indxI+1];
+      }
+    }
+
+    sig_old_s = sig_new_s;
+    sig_old_t = sig_new_t;
+
+    MPI_Allreduce(my_buf, buf, 2, MPI_DOUBLE, MPI_SUM, world);
+
+    sig_new_s = buf[0];
+    sig_new_t = buf[1];
+
+    if (sqrt(sig_new_s)/b_norm_s <= tolerance
+        || sqrt(sig_new_t)/b_norm_t <= tolerance) break;
+
+    beta_s = sig_new_s / sig_old_s;
+    beta_t = sig_new_t / sig_old_t;
+
+    for (jj = 0; jj < nn; jj++) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) {
+        indxI = 2 * ii;
+        d[indxI] = p[indxI] + beta_s * d[indxI];
+        d[indxI+1] = p[indxI+1] + beta_t * d[indxI+1];
+      }
+    }
+  }
+
+  matvecs_s = matvecs_t = i;
+
+  // if only one system is converged and there are iterations left, converge the other one
+
+  if ((matvecs_s < imax) && (sqrt(sig_new_s)/b_norm_s > tolerance)) {
+    pack_flag = 2;
+    comm->forward_comm(this); // x1 => s
+
+    int saved_imax = imax;
+    imax -= matvecs_s;
+    matvecs_s += CG(b1, x1);
+    imax = saved_imax;
+  } else if ((matvecs_t < imax) && (sqrt(sig_new_t)/b_norm_t > tolerance)) {
+    pack_flag = 3;
+    comm->forward_comm(this); // x2 => t
+
+    int saved_imax = imax;
+    imax -= matvecs_t;
+    matvecs_t += CG(b2, x2);
+    imax = saved_imax;
+  }
+
+  if ((i >= imax) && maxwarn && (comm->me == 0))
+    error->warning(FLERR, "Fix {} CG convergence failed after {} iterations at step {}",
+                   style, i, update->ntimestep);
+  return matvecs_s + matvecs_t;
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -809,19 +1122,110 @@ void FixQEqReaxFF::sparse_matvec(sparse_matrix *A, double *x, double *b)
 
 }
 
+/* ----------------------------------------------------------------------
+   sparse matrix-vector product for two separate input vectors
+   result b is stored interleaved
+------------------------------------------------------------------------- */
+
+void FixQEqReaxFF::dual_sparse_matvec(sparse_matrix *A, double *x1, double *x2, double *b)
+{
+  int i, j, ii, itr_j, indxI, indxJ;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      b[indxI] = eta[atom->type[i]] * x1[i];
+      b[indxI+1] = eta[atom->type[i]] * x2[i];
+    }
+  }
+
+  int nall = atom->nlocal + atom->nghost;
+  for (i = atom->nlocal; i < nall; ++i) {
+    indxI = 2 * i;
+    b[indxI] = 0;
+    b[indxI+1] = 0;
+  }
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      for (itr_j=A->firstnbr[i]; itr_j<A->firstnbr[i]+A->numnbrs[i]; itr_j++) {
+        j = A->jlist[itr_j];
+        indxJ = 2 * j;
+        b[indxI] += A->val[itr_j] * x1[j];
+        b[indxI+1] += A->val[itr_j] * x2[j];
+        b[indxJ] += A->val[itr_j] * x1[i];
+        b[indxJ+1] += A->val[itr_j] * x2[i];
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   sparse matrix-vector product for interleaved input and result vectors
+------------------------------------------------------------------------- */
+
+void FixQEqReaxFF::dual_sparse_matvec(sparse_matrix *A, double *x, double *b)
+{
+  int i, j, ii, itr_j, indxI, indxJ;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      b[indxI] = eta[atom->type[i]] * x[indxI];
+      b[indxI+1] = eta[atom->type[i]] * x[indxI+1];
+    }
+  }
+
+  int nall = atom->nlocal + atom->nghost;
+  for (i = atom->nlocal; i < nall; ++i) {
+    indxI = 2 * i;
+    b[indxI] = 0;
+    b[indxI+1] = 0;
+  }
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      for (itr_j=A->firstnbr[i]; itr_j<A->firstnbr[i]+A->numnbrs[i]; itr_j++) {
+        j = A->jlist[itr_j];
+        indxJ = 2 * j;
+        b[indxI] += A->val[itr_j] * x[indxJ];
+        b[indxI+1] += A->val[itr_j] * x[indxJ+1];
+        b[indxJ] += A->val[itr_j] * x[indxI];
+        b[indxJ+1] += A->val[itr_j] * x[indxI+1];
+      }
+    }
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReaxFF::calculate_Q()
 {
   int i, k;
-  double u, s_sum, t_sum;
+  double u;
   double *q = atom->q;
 
   int ii;
 
-  s_sum = parallel_vector_acc(s, nn);
-  t_sum = parallel_vector_acc(t, nn);
-  u = s_sum / t_sum;
+  // sum of s and t with a single reduction
+
+  double my_acc[2] = {0.0, 0.0};
+  double acc[2];
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      my_acc[0] += s[i];
+      my_acc[1] += t[i];
+    }
+  }
+  MPI_Allreduce(my_acc, acc, 2, MPI_DOUBLE, MPI_SUM, world);
+  u = acc[0] / acc[1];
 
   for (ii = 0; ii < nn; ++ii) {
     i = ilist[ii];
@@ -946,6 +1350,8 @@ double FixQEqReaxFF::memory_usage()
 
   if (dual_enabled)
     bytes += (double)atom->nmax*4 * sizeof(double); // double size for q, d, r, and p
+  if (pipelined_enabled)
+    bytes += (double)atom->nmax*5 * sizeof(double); // u, w, z, ap, and mp
 
   return bytes;
 }
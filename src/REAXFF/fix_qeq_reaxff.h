@@ -99,6 +99,9 @@ class FixQEqReaxFF : public Fix {
   double *p, *q, *r, *d;
   int imax, maxwarn;
 
+  // pipelined CG storage
+  double *u, *w, *z, *ap, *mp;
+
   char *pertype_option;    // argument to determine how per-type info is obtained
   virtual void pertype_parameters(char *);
   void init_shielding();
@@ -117,6 +120,7 @@ class FixQEqReaxFF : public Fix {
   virtual void calculate_Q();
 
   virtual int CG(double *, double *);
+  virtual int pipelined_CG(double *, double *);
   virtual void sparse_matvec(sparse_matrix *, double *, double *);
 
   int pack_forward_comm(int, int *, double *, int, int *) override;
@@ -141,6 +145,12 @@ class FixQEqReaxFF : public Fix {
   // dual CG support
   int dual_enabled;            // 0: Original, separate s & t optimization; 1: dual optimization
   int matvecs_s, matvecs_t;    // Iteration count for each system
+
+  int pipelined_enabled;    // 1: pipelined CG with one reduction per iteration
+
+  virtual int dual_CG(double *, double *, double *, double *);
+  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *, double *);
+  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *);
 };
 
 }    // namespace LAMMPS_NS
@@ -38,6 +38,7 @@
 #include "fix_acks2_reaxff.h"
 
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 
 #include "reaxff_api.h"
@@ -410,7 +411,10 @@ void PairReaxFF::setup()
     Make_List(api->system->total_cap,num_nbrs,TYP_FAR_NEIGHBOR,api->lists+FAR_NBRS);
     (api->lists+FAR_NBRS)->error_ptr=error;
 
-    write_reax_lists();
+    // record the far neighbor count, so that a reallocation before the
+    // first call to compute() is not sized from an empty list
+
+    api->workspace->realloc.num_far = write_reax_lists();
 
     Initialize(api->system,api->control,api->data,api->workspace,&api->lists,world);
     for (int k = 0; k < api->system->N; ++k) {
@@ -583,12 +587,11 @@ int PairReaxFF::estimate_reax_lists()
   int itr_i, itr_j, i, j;
   int num_nbrs;
   int *ilist, *jlist, *numneigh, **firstneigh;
-  double d_sqr;
+  double d_sqr, cutoff_sqr;
   rvec dvec;
   double **x;
 
   int mincap = api->system->mincap;
-  double safezone = api->system->safezone;
 
   x = atom->x;
   ilist = list->ilist;
@@ -597,23 +600,32 @@ int PairReaxFF::estimate_reax_lists()
 
   num_nbrs = 0;
 
+  int inum = list->inum;
   int numall = list->inum + list->gnum;
 
+  // count with the same cutoffs as in write_reax_lists(), so that the
+  // list is not oversized by the ghost atom neighbors beyond the bond cutoff
+
   for (itr_i = 0; itr_i < numall; ++itr_i) {
     i = ilist[itr_i];
     jlist = firstneigh[i];
 
+    if (itr_i < inum)
+      cutoff_sqr = SQR(api->control->nonb_cut);
+    else
+      cutoff_sqr = SQR(api->control->bond_cut);
+
     for (itr_j = 0; itr_j < numneigh[i]; ++itr_j) {
       j = jlist[itr_j];
       j &= NEIGHMASK;
       get_distance(x[j], x[i], &d_sqr, &dvec);
 
-      if (d_sqr <= SQR(api->control->nonb_cut))
+      if (d_sqr <= cutoff_sqr)
         ++num_nbrs;
     }
   }
 
-  return static_cast<int> (MAX(num_nbrs*safezone, mincap*REAX_MIN_NBRS));
+  return MAX(num_nbrs, mincap*REAX_MIN_NBRS);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -625,7 +637,7 @@ int PairReaxFF::write_reax_lists()
   int *ilist, *jlist, *numneigh, **firstneigh;
   double d_sqr, cutoff_sqr;
   rvec dvec;
-  double *dist, **x;
+  double **x;
   reax_list *far_nbrs;
   far_neighbor_data *far_list;
 
@@ -635,39 +647,57 @@ int PairReaxFF::write_reax_lists()
   firstneigh = list->firstneigh;
 
   far_nbrs = api->lists + FAR_NBRS;
-  far_list = far_nbrs->select.far_nbr_list;
 
-  num_nbrs = 0;
   int inum = list->inum;
-  dist = (double*) calloc(api->system->N, sizeof(double));
-
   int numall = list->inum + list->gnum;
 
-  for (itr_i = 0; itr_i < numall; ++itr_i) {
-    i = ilist[itr_i];
-    jlist = firstneigh[i];
-    Set_Start_Index(i, num_nbrs, far_nbrs);
-
-    if (itr_i < inum)
-      cutoff_sqr = SQR(api->control->nonb_cut);
-    else
-      cutoff_sqr = SQR(api->control->bond_cut);
+  // the far neighbor list is sized from the exact neighbor count of the
+  // previous step. if it is too small now, keep counting without storing,
+  // grow the list to the exact count and fill in only the atoms whose
+  // neighbors did not fit.
 
-    for (itr_j = 0; itr_j < numneigh[i]; ++itr_j) {
-      j = jlist[itr_j];
-      j &= NEIGHMASK;
-      get_distance(x[j], x[i], &d_sqr, &dvec);
+  int itr_start = 0;
+  num_nbrs = 0;
 
-      if (d_sqr <= (cutoff_sqr)) {
-        dist[j] = sqrt(d_sqr);
-        set_far_nbr(&far_list[num_nbrs], j, dist[j], dvec);
-        ++num_nbrs;
+  do {
+    if (num_nbrs > far_nbrs->num_intrs) {
+      far_nbrs->select.far_nbr_list = (far_neighbor_data *)
+        ::realloc(far_nbrs->select.far_nbr_list, num_nbrs*sizeof(far_neighbor_data));
+      if (far_nbrs->select.far_nbr_list == nullptr)
+        error->one(FLERR,"Failed to grow far neighbor list of pair style reaxff");
+      far_nbrs->num_intrs = num_nbrs;
+      num_nbrs = Start_Index(ilist[itr_start], far_nbrs);
+    }
+    far_list = far_nbrs->select.far_nbr_list;
+    int itr_full = numall;
+
+    for (itr_i = itr_start; itr_i < numall; ++itr_i) {
+      i = ilist[itr_i];
+      jlist = firstneigh[i];
+      Set_Start_Index(i, num_nbrs, far_nbrs);
+
+      if (itr_i < inum)
+        cutoff_sqr = SQR(api->control->nonb_cut);
+      else
+        cutoff_sqr = SQR(api->control->bond_cut);
+
+      for (itr_j = 0; itr_j < numneigh[i]; ++itr_j) {
+        j = jlist[itr_j];
+        j &= NEIGHMASK;
+        get_distance(x[j], x[i], &d_sqr, &dvec);
+
+        if (d_sqr <= (cutoff_sqr)) {
+          if (num_nbrs < far_nbrs->num_intrs)
+            set_far_nbr(&far_list[num_nbrs], j, sqrt(d_sqr), dvec);
+          else if (itr_full == numall)
+            itr_full = itr_i;
+          ++num_nbrs;
+        }
       }
+      Set_End_Index(i, num_nbrs, far_nbrs);
     }
-    Set_End_Index(i, num_nbrs, far_nbrs);
-  }
-
-  free(dist);
+    itr_start = itr_full;
+  } while (num_nbrs > far_nbrs->num_intrs);
 
   return num_nbrs;
 }
@@ -740,11 +770,12 @@ double PairReaxFF::memory_usage()
   bytes += (double)3.0 * api->system->total_cap * sizeof(int);
 
   // From reaxff_lists
-  bytes += (double)2.0 * api->lists->n * sizeof(int);
-  bytes += (double)api->lists->num_intrs * sizeof(three_body_interaction_data);
-  bytes += (double)api->lists->num_intrs * sizeof(bond_data);
-  bytes += (double)api->lists->num_intrs * sizeof(far_neighbor_data);
-  bytes += (double)api->lists->num_intrs * sizeof(hbond_data);
+  for (int k = 0; k < LIST_N; ++k)
+    bytes += (double)2.0 * api->lists[k].n * sizeof(int);
+  bytes += (double)api->lists[THREE_BODIES].num_intrs * sizeof(three_body_interaction_data);
+  bytes += (double)api->lists[BONDS].num_intrs * sizeof(bond_data);
+  bytes += (double)api->lists[FAR_NBRS].num_intrs * sizeof(far_neighbor_data);
+  bytes += (double)api->lists[HBONDS].num_intrs * sizeof(hbond_data);
 
   if (fixspecies_flag)
     bytes += (double)2 * nmax * MAXSPECBOND * sizeof(double);
@@ -216,7 +216,7 @@ namespace ReaxFF {
   }
 
   void ReAllocate(reax_system *system, control_params *control,
-                  simulation_data *data, storage *workspace, reax_list **lists)
+                  simulation_data * /*data*/, storage *workspace, reax_list **lists)
   {
     int num_bonds, est_3body, Hflag;
     int newsize;
@@ -248,16 +248,13 @@ namespace ReaxFF {
     }
 
     /* far neighbors */
+    /* sized from the neighbor count without a safety margin, since
+       the pair styles grow the list themselves when it overflows */
 
     far_nbrs = *lists + FAR_NBRS;
 
-    if (Nflag || wsr->num_far >= far_nbrs->num_intrs * DANGER_ZONE) {
-      if (wsr->num_far > far_nbrs->num_intrs)
-        error->one(FLERR, "step{}: ran out of space on far_nbrs: top={}, max={}",
-                   data->step, wsr->num_far, far_nbrs->num_intrs);
-
-      newsize = static_cast<int>
-        (MAX(wsr->num_far*safezone, mincap*REAX_MIN_NBRS));
+    if (Nflag || wsr->num_far > far_nbrs->num_intrs) {
+      newsize = MAX(wsr->num_far, mincap*REAX_MIN_NBRS);
 
       Reallocate_Neighbor_List(far_nbrs, system->total_cap, newsize);
       wsr->num_far = 0;
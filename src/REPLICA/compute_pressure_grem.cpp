@@ -32,6 +32,9 @@ ComputePressureGrem::ComputePressureGrem(LAMMPS *lmp, int narg, char **arg) :
   ComputePressure(lmp, narg-1, arg)
 {
   fix_grem = utils::strdup(arg[narg-1]);
+
+  // scaled pressure is computed in overridden methods only
+  size_partial_scalar = size_partial_vector = 0;
 }
 
 /* ---------------------------------------------------------------------- */
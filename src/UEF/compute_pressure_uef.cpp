@@ -37,6 +37,9 @@ ComputePressureUef::ComputePressureUef(LAMMPS *lmp, int narg, char **arg) :
   ext_flags[1] = true;
   ext_flags[2] = true;
   in_fix=false;
+
+  // rotated pressure is computed in overridden methods only
+  size_partial_scalar = size_partial_vector = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -30,6 +30,9 @@ ComputeTempUef::ComputeTempUef(LAMMPS *lmp, int narg, char **arg) :
   ComputeTemp(lmp, narg, arg)
 {
   rot_flag=true;
+
+  // rotated KE tensor is computed in overridden method only
+  size_partial_vector = 0;
 }
 
 /* ----------------------------------------------------------------------
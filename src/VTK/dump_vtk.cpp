@@ -107,6 +107,9 @@ static constexpr int DELTA = 1048576;
 DumpVTK::DumpVTK(LAMMPS *lmp, int narg, char **arg) :
   DumpCustom(lmp, narg, arg)
 {
+  async_allow = 0;
+  mpiio_allow = 0;
+
   if (narg == 5) error->all(FLERR,"No dump vtk arguments specified");
 
   pack_choice.clear();
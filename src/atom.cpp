@@ -1042,11 +1042,16 @@ void Atom::deallocate_topology()
    unpack N lines from Atom section of data file
    call atom-style specific method to parse each line
    triclinic_general = 1 if data file defines a general triclinic box
+   parallel = 1 if each proc parses only every Pth line of the chunk,
+     where nfirst is the global index of the first line, and keeps all
+     of those atoms that are inside the simulation box
+     caller must then migrate atoms to their owning procs
 ------------------------------------------------------------------------- */
 
 void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
                       int type_offset, int shiftflag, double *shift,
-                      int labelflag, int *ilabel, int triclinic_general)
+                      int labelflag, int *ilabel, int triclinic_general,
+                      int parallel, bigint nfirst)
 {
   int xptr,iptr;
   imageint imagedata;
@@ -1076,60 +1081,12 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
 
   *next = '\n';
 
-  // set bounds for my proc
-  // if periodic and I am lo/hi proc, adjust bounds by EPSILON
-  // ensures all data atoms will be owned even with round-off
+  // set bounds for atoms kept by this proc
 
   int dimension = domain->dimension;
   int triclinic = domain->triclinic;
-
-  double epsilon[3];
-  if (triclinic) epsilon[0] = epsilon[1] = epsilon[2] = EPSILON;
-  else {
-    epsilon[0] = domain->prd[0] * EPSILON;
-    epsilon[1] = domain->prd[1] * EPSILON;
-    epsilon[2] = domain->prd[2] * EPSILON;
-  }
-
   double sublo[3],subhi[3];
-  if (triclinic == 0) {
-    sublo[0] = domain->sublo[0]; subhi[0] = domain->subhi[0];
-    sublo[1] = domain->sublo[1]; subhi[1] = domain->subhi[1];
-    sublo[2] = domain->sublo[2]; subhi[2] = domain->subhi[2];
-  } else {
-    sublo[0] = domain->sublo_lamda[0]; subhi[0] = domain->subhi_lamda[0];
-    sublo[1] = domain->sublo_lamda[1]; subhi[1] = domain->subhi_lamda[1];
-    sublo[2] = domain->sublo_lamda[2]; subhi[2] = domain->subhi_lamda[2];
-  }
-
-  if (comm->layout != Comm::LAYOUT_TILED) {
-    if (domain->xperiodic) {
-      if (comm->myloc[0] == 0) sublo[0] -= epsilon[0];
-      if (comm->myloc[0] == comm->procgrid[0]-1) subhi[0] += epsilon[0];
-    }
-    if (domain->yperiodic) {
-      if (comm->myloc[1] == 0) sublo[1] -= epsilon[1];
-      if (comm->myloc[1] == comm->procgrid[1]-1) subhi[1] += epsilon[1];
-    }
-    if (domain->zperiodic) {
-      if (comm->myloc[2] == 0) sublo[2] -= epsilon[2];
-      if (comm->myloc[2] == comm->procgrid[2]-1) subhi[2] += epsilon[2];
-    }
-
-  } else {
-    if (domain->xperiodic) {
-      if (comm->mysplit[0][0] == 0.0) sublo[0] -= epsilon[0];
-      if (comm->mysplit[0][1] == 1.0) subhi[0] += epsilon[0];
-    }
-    if (domain->yperiodic) {
-      if (comm->mysplit[1][0] == 0.0) sublo[1] -= epsilon[1];
-      if (comm->mysplit[1][1] == 1.0) subhi[1] += epsilon[1];
-    }
-    if (domain->zperiodic) {
-      if (comm->mysplit[2][0] == 0.0) sublo[2] -= epsilon[2];
-      if (comm->mysplit[2][1] == 1.0) subhi[2] += epsilon[2];
-    }
-  }
+  data_atoms_bounds(sublo,subhi,parallel);
 
   // xptr = which word in line starts xyz coords
   // iptr = which word in line starts ix,iy,iz image flags
@@ -1139,6 +1096,13 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   if (nwords > avec->size_data_atom) imageflag = 1;
   if (imageflag) iptr = nwords - 3;
 
+  // in parallel mode a line is only seen by a single proc,
+  // so errors for individual lines must be raised with error->one()
+
+  int me = comm->me;
+  int nprocs = comm->nprocs;
+  bool do_abort = parallel != 0;
+
   // loop over lines of atom data
   // tokenize the line into values
   // extract xyz coords and image flags
@@ -1148,6 +1112,10 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   for (int i = 0; i < n; i++) {
     next = strchr(buf,'\n');
     if (!next) error->all(FLERR, "Missing data in {}", location);
+    if (parallel && ((nfirst + i) % nprocs != me)) {
+      buf = next + 1;
+      continue;
+    }
     *next = '\0';
     auto values = Tokenizer(buf).as_vector();
     int nvalues = values.size();
@@ -1160,6 +1128,9 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
 
     } else if ((nvalues < nwords) ||
                ((nvalues > nwords) && (!utils::strmatch(values[nwords],"^#")))) {
+      if (parallel)
+        error->one(FLERR, "Incorrect format in {}: {}{}", location,
+                   utils::trim(buf), utils::errorurl(2));
       error->all(FLERR, "Incorrect format in {}: {}{}", location,
                  utils::trim(buf), utils::errorurl(2));
 
@@ -1168,11 +1139,13 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     } else {
       int imx = 0, imy = 0, imz = 0;
       if (imageflag) {
-        imx = utils::inumeric(FLERR,values[iptr],false,lmp);
-        imy = utils::inumeric(FLERR,values[iptr+1],false,lmp);
-        imz = utils::inumeric(FLERR,values[iptr+2],false,lmp);
-        if ((dimension == 2) && (imz != 0))
+        imx = utils::inumeric(FLERR,values[iptr],do_abort,lmp);
+        imy = utils::inumeric(FLERR,values[iptr+1],do_abort,lmp);
+        imz = utils::inumeric(FLERR,values[iptr+2],do_abort,lmp);
+        if ((dimension == 2) && (imz != 0)) {
+          if (parallel) error->one(FLERR,"Z-direction image flag must be 0 for 2d-systems");
           error->all(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+        }
         if ((!domain->xperiodic) && (imx != 0)) { reset_image_flag[0] = true; imx = 0; }
         if ((!domain->yperiodic) && (imy != 0)) { reset_image_flag[1] = true; imy = 0; }
         if ((!domain->zperiodic) && (imz != 0)) { reset_image_flag[2] = true; imz = 0; }
@@ -1181,16 +1154,18 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
         (((imageint) (imy + IMGMAX) & IMGMASK) << IMGBITS) |
         (((imageint) (imz + IMGMAX) & IMGMASK) << IMG2BITS);
 
-      xdata[0] = utils::numeric(FLERR,values[xptr],false,lmp);
-      xdata[1] = utils::numeric(FLERR,values[xptr+1],false,lmp);
-      xdata[2] = utils::numeric(FLERR,values[xptr+2],false,lmp);
+      xdata[0] = utils::numeric(FLERR,values[xptr],do_abort,lmp);
+      xdata[1] = utils::numeric(FLERR,values[xptr+1],do_abort,lmp);
+      xdata[2] = utils::numeric(FLERR,values[xptr+2],do_abort,lmp);
 
       // for 2d simulation:
       // check if z coord is within EPS_ZCOORD of zero and set to zero
 
       if (dimension == 2) {
-        if (fabs(xdata[2]) > EPS_ZCOORD)
+        if (fabs(xdata[2]) > EPS_ZCOORD) {
+          if (parallel) error->one(FLERR,"Read_data atom z coord is non-zero for 2d simulation");
           error->all(FLERR,"Read_data atom z coord is non-zero for 2d simulation");
+        }
         xdata[2] = 0.0;
       }
 
@@ -1260,13 +1235,184 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   }
 }
 
+/* ----------------------------------------------------------------------
+   unpack N rows from binary Atoms section of data file
+   each row holds the values packed by AtomVec::pack_data() incl. image flags
+   offsets, shift, type label remapping and ownership as in data_atoms()
+   in parallel mode, rows are split across procs and all atoms in box are kept
+------------------------------------------------------------------------- */
+
+void Atom::data_atoms_binary(int n, double *buf, tagint id_offset, tagint mol_offset,
+                             int type_offset, int shiftflag, double *shift,
+                             int labelflag, int *ilabel, int triclinic_general, int parallel)
+{
+  imageint imagedata;
+  double xdata[3],lamda[3];
+  double *coord;
+  auto location = "binary Atoms section of data file";
+
+  // set bounds for atoms kept by this proc
+
+  int dimension = domain->dimension;
+  int triclinic = domain->triclinic;
+  double sublo[3],subhi[3];
+  data_atoms_bounds(sublo,subhi,parallel);
+
+  // xptr = which column in row starts xyz coords
+  // iptr = which column in row starts ix,iy,iz image flags
+
+  int ncol = avec->size_data_atom + 3;
+  int xptr = avec->xcol_data - 1;
+  int iptr = avec->size_data_atom;
+
+  // loop over rows of atom data
+  // same processing as for a line of the text format
+
+  for (int i = 0; i < n; i++) {
+    double *values = &buf[(bigint) i * ncol];
+
+    int imx = (int) ubuf(values[iptr]).i;
+    int imy = (int) ubuf(values[iptr+1]).i;
+    int imz = (int) ubuf(values[iptr+2]).i;
+    if ((dimension == 2) && (imz != 0)) {
+      if (parallel) error->one(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+      error->all(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+    }
+    if ((!domain->xperiodic) && (imx != 0)) { reset_image_flag[0] = true; imx = 0; }
+    if ((!domain->yperiodic) && (imy != 0)) { reset_image_flag[1] = true; imy = 0; }
+    if ((!domain->zperiodic) && (imz != 0)) { reset_image_flag[2] = true; imz = 0; }
+    imagedata = ((imageint) (imx + IMGMAX) & IMGMASK) |
+      (((imageint) (imy + IMGMAX) & IMGMASK) << IMGBITS) |
+      (((imageint) (imz + IMGMAX) & IMGMASK) << IMG2BITS);
+
+    xdata[0] = values[xptr];
+    xdata[1] = values[xptr+1];
+    xdata[2] = values[xptr+2];
+
+    if (dimension == 2) {
+      if (fabs(xdata[2]) > EPS_ZCOORD) {
+        if (parallel) error->one(FLERR,"Read_data atom z coord is non-zero for 2d simulation");
+        error->all(FLERR,"Read_data atom z coord is non-zero for 2d simulation");
+      }
+      xdata[2] = 0.0;
+    }
+
+    if (triclinic_general) domain->general_to_restricted_coords(xdata);
+
+    if (shiftflag) {
+      xdata[0] += shift[0];
+      xdata[1] += shift[1];
+      xdata[2] += shift[2];
+    }
+
+    domain->remap(xdata,imagedata);
+
+    if (triclinic) {
+      domain->x2lamda(xdata,lamda);
+      coord = lamda;
+    } else coord = xdata;
+
+    if (coord[0] >= sublo[0] && coord[0] < subhi[0] &&
+        coord[1] >= sublo[1] && coord[1] < subhi[1] &&
+        coord[2] >= sublo[2] && coord[2] < subhi[2]) {
+
+      // atom-style specific method unpacks single row
+      // atom types are always stored as numbers
+
+      avec->data_atom_binary(xdata,imagedata,values);
+      if (id_offset) tag[nlocal-1] += id_offset;
+      if (mol_offset) molecule[nlocal-1] += mol_offset;
+
+      int itype = type[nlocal-1] + type_offset;
+      if ((itype < 1) || (itype > ntypes))
+        error->one(FLERR, "Invalid atom type {} in {}", itype, location);
+      type[nlocal-1] = itype;
+      if (labelflag) type[nlocal-1] = ilabel[itype-1];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   set bounds of atoms read from a data file that are kept by this proc
+   used by data_atoms() and data_atoms_binary()
+------------------------------------------------------------------------- */
+
+void Atom::data_atoms_bounds(double *sublo, double *subhi, int parallel)
+{
+  // set bounds for my proc
+  // if periodic and I am lo/hi proc, adjust bounds by EPSILON
+  // ensures all data atoms will be owned even with round-off
+
+  int triclinic = domain->triclinic;
+
+  double epsilon[3];
+  if (triclinic) epsilon[0] = epsilon[1] = epsilon[2] = EPSILON;
+  else {
+    epsilon[0] = domain->prd[0] * EPSILON;
+    epsilon[1] = domain->prd[1] * EPSILON;
+    epsilon[2] = domain->prd[2] * EPSILON;
+  }
+
+  if (triclinic == 0) {
+    sublo[0] = domain->sublo[0]; subhi[0] = domain->subhi[0];
+    sublo[1] = domain->sublo[1]; subhi[1] = domain->subhi[1];
+    sublo[2] = domain->sublo[2]; subhi[2] = domain->subhi[2];
+  } else {
+    sublo[0] = domain->sublo_lamda[0]; subhi[0] = domain->subhi_lamda[0];
+    sublo[1] = domain->sublo_lamda[1]; subhi[1] = domain->subhi_lamda[1];
+    sublo[2] = domain->sublo_lamda[2]; subhi[2] = domain->subhi_lamda[2];
+  }
+
+  if (comm->layout != Comm::LAYOUT_TILED) {
+    if (domain->xperiodic) {
+      if (comm->myloc[0] == 0) sublo[0] -= epsilon[0];
+      if (comm->myloc[0] == comm->procgrid[0]-1) subhi[0] += epsilon[0];
+    }
+    if (domain->yperiodic) {
+      if (comm->myloc[1] == 0) sublo[1] -= epsilon[1];
+      if (comm->myloc[1] == comm->procgrid[1]-1) subhi[1] += epsilon[1];
+    }
+    if (domain->zperiodic) {
+      if (comm->myloc[2] == 0) sublo[2] -= epsilon[2];
+      if (comm->myloc[2] == comm->procgrid[2]-1) subhi[2] += epsilon[2];
+    }
+
+  } else {
+    if (domain->xperiodic) {
+      if (comm->mysplit[0][0] == 0.0) sublo[0] -= epsilon[0];
+      if (comm->mysplit[0][1] == 1.0) subhi[0] += epsilon[0];
+    }
+    if (domain->yperiodic) {
+      if (comm->mysplit[1][0] == 0.0) sublo[1] -= epsilon[1];
+      if (comm->mysplit[1][1] == 1.0) subhi[1] += epsilon[1];
+    }
+    if (domain->zperiodic) {
+      if (comm->mysplit[2][0] == 0.0) sublo[2] -= epsilon[2];
+      if (comm->mysplit[2][1] == 1.0) subhi[2] += epsilon[2];
+    }
+  }
+
+  // in parallel mode keep every atom inside the global box
+  // atoms are migrated to their owning procs afterwards
+
+  if (parallel) {
+    for (int idim = 0; idim < 3; idim++) {
+      sublo[idim] = triclinic ? 0.0 : domain->boxlo[idim];
+      subhi[idim] = triclinic ? 1.0 : domain->boxhi[idim];
+    }
+    if (domain->xperiodic) { sublo[0] -= epsilon[0]; subhi[0] += epsilon[0]; }
+    if (domain->yperiodic) { sublo[1] -= epsilon[1]; subhi[1] += epsilon[1]; }
+    if (domain->zperiodic) { sublo[2] -= epsilon[2]; subhi[2] += epsilon[2]; }
+  }
+}
+
 /* ----------------------------------------------------------------------
    unpack N lines from Velocity section of data file
    check that atom IDs are > 0 and <= map_tag_max
    call style-specific routine to parse line-
 ------------------------------------------------------------------------ */
 
-void Atom::data_vels(int n, char *buf, tagint id_offset)
+void Atom::data_vels(int n, char *buf, tagint id_offset, int parallel)
 {
   int m;
   char *next;
@@ -1274,11 +1420,34 @@ void Atom::data_vels(int n, char *buf, tagint id_offset)
   // loop over lines of atom velocities
   // tokenize the line into values
   // if I own atom tag, unpack its values
+  // in parallel mode only the leading atom ID is read on every proc
+  //   and the owning proc alone tokenizes and checks the rest of the line
 
   for (int i = 0; i < n; i++) {
     next = strchr(buf,'\n');
     if (!next) error->all(FLERR, "Missing data in Velocities section of data file");
     *next = '\0';
+
+    if (parallel) {
+      char *word = buf + strspn(buf, " \t\r\f");
+      std::size_t len = strcspn(word, " \t\r\f");
+      if ((len > 0) && (*word != '#')) {
+        tagint tagdata = utils::tnumeric(FLERR, std::string(word, len), false, lmp) + id_offset;
+        if (tagdata <= 0 || tagdata > map_tag_max)
+          error->one(FLERR,"Invalid atom ID {} in Velocities section of data file: {}",
+                     tagdata, buf);
+        if ((m = map(tagdata)) >= 0) {
+          auto values = Tokenizer(utils::trim_comment(buf)).as_vector();
+          if ((int)values.size() != avec->size_data_vel)
+            error->one(FLERR, "Incorrect format in Velocities section of data file: {}{}",
+                       utils::trim(buf), utils::errorurl(2));
+          avec->data_vel(m,values);
+        }
+      }
+      buf = next + 1;
+      continue;
+    }
+
     auto values = Tokenizer(utils::trim_comment(buf)).as_vector();
     if (values.size() == 0) {
       // skip over empty or comment lines
@@ -1295,6 +1464,25 @@ void Atom::data_vels(int n, char *buf, tagint id_offset)
   }
 }
 
+/* ----------------------------------------------------------------------
+   unpack N rows from binary Velocities section of data file
+   check that atom IDs are > 0 and <= map_tag_max
+------------------------------------------------------------------------- */
+
+void Atom::data_vels_binary(int n, double *buf, tagint id_offset)
+{
+  int m;
+  int ncol = avec->size_data_vel;
+
+  for (int i = 0; i < n; i++) {
+    double *values = &buf[(bigint) i * ncol];
+    tagint tagdata = (tagint) ubuf(values[0]).i + id_offset;
+    if (tagdata <= 0 || tagdata > map_tag_max)
+      error->one(FLERR,"Invalid atom ID {} in binary Velocities section of data file", tagdata);
+    if ((m = map(tagdata)) >= 0) avec->data_vel_binary(m,values);
+  }
+}
+
 /* ----------------------------------------------------------------------
    process N bonds read into buf from data files
    if count is non-nullptr, just count bonds per atom
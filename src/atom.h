@@ -329,8 +329,10 @@ class Atom : protected Pointers {
 
   virtual void deallocate_topology();
 
-  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *, int);
-  void data_vels(int, char *, tagint);
+  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *, int, int, bigint);
+  void data_atoms_binary(int, double *, tagint, tagint, int, int, double *, int, int *, int, int);
+  void data_vels(int, char *, tagint, int);
+  void data_vels_binary(int, double *, tagint);
   void data_bonds(int, char *, int *, tagint, int, int, int *);
   void data_angles(int, char *, int *, tagint, int, int, int *);
   void data_dihedrals(int, char *, int *, tagint, int, int, int *);
@@ -438,6 +440,7 @@ class Atom : protected Pointers {
   void set_atomflag_defaults();
   void setup_sort_bins();
   int next_prime(int);
+  void data_atoms_bounds(double *, double *, int);
 };
 
 }    // namespace LAMMPS_NS
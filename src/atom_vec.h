@@ -126,6 +126,7 @@ class AtomVec : protected Pointers {
   virtual void data_atom(double *, imageint, const std::vector<std::string> &,
                          std::string &);
   virtual void data_atom_post(int) {}
+  virtual void data_atom_binary(double *, imageint, const double *);
   virtual void data_atom_bonus(int, const std::vector<std::string> &) {}
   virtual void data_body(int, int, int, int *, double *) {}
 
@@ -137,6 +138,7 @@ class AtomVec : protected Pointers {
   virtual void pack_data_post(int) {}
 
   virtual void data_vel(int, const std::vector<std::string> &);
+  virtual void data_vel_binary(int, const double *);
   virtual void pack_vel(double **);
   virtual void write_vel(FILE *, int, double **);
 
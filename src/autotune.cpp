@@ -0,0 +1,548 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "autotune.h"
+
+#include "atom.h"
+#include "atom_vec.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "exceptions.h"
+#include "fix.h"
+#include "force.h"
+#include "input.h"
+#include "integrate.h"
+#include "modify.h"
+#include "neighbor.h"
+#include "output.h"
+#include "pair.h"
+#include "timer.h"
+#include "update.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+static constexpr int BUFEXTRA = 1024;         // same per-atom margin as in Comm
+static constexpr double MINGAIN = 0.01;       // min speedup to replace the current setting
+
+static const char *const suffixes[] = {"opt", "omp", "intel", "gpu"};
+static const char *const neighstyles[] = {"nsq", "bin", "multi/old", "multi"};
+
+/* ---------------------------------------------------------------------- */
+
+Autotune::Autotune(LAMMPS *lmp) : Command(lmp), nsteps(0), applyflag(1), neighstyle(0) {}
+
+/* ----------------------------------------------------------------------
+   run short trials with different run-time settings and keep the fastest
+------------------------------------------------------------------------- */
+
+void Autotune::command(int narg, char **arg)
+{
+  if (domain->box_exist == 0)
+    error->all(FLERR, "Autotune command before simulation box is defined");
+  if (narg < 2) utils::missing_cmd_args(FLERR, "autotune", error);
+  if (!force->pair) error->all(FLERR, "Autotune command requires a pair style");
+  if (update->whichflag != 0) error->all(FLERR, "Autotune command cannot be used during a run");
+
+  nsteps = utils::inumeric(FLERR, arg[0], false, lmp);
+  if (nsteps <= 0) error->all(FLERR, "Illegal autotune number of steps: {}", nsteps);
+
+  // strip accelerator suffix from pair style to get the base style
+
+  base_pair = force->pair_style;
+  for (const auto &sfx : suffixes)
+    if (utils::strmatch(base_pair, fmt::format("/{}$", sfx)))
+      base_pair.resize(base_pair.size() - strlen(sfx) - 1);
+  neighstyle = neighbor->style;
+
+  options(narg - 1, &arg[1]);
+
+  // record initial state and settings, then suppress all output during trials
+
+  save_state();
+
+  const bool had_omp = modify->get_fix_by_id("package_omp") != nullptr;
+  const int nthreads_initial = comm->nthreads;
+  std::vector<std::string> initial, best;
+  for (const auto &param : params) initial.push_back(current(param.which));
+  best = initial;
+
+  FILE *screen_saved = lmp->screen;
+  FILE *logfile_saved = lmp->logfile;
+  const int ndump_saved = output->ndump;
+  const int restart_saved[3] = {output->restart_flag, output->restart_flag_single,
+                                output->restart_flag_double};
+  const int fix_file_saved = output->fix_file_flag;
+
+  auto quiet = [&](bool on) {
+    lmp->screen = on ? nullptr : screen_saved;
+    lmp->logfile = on ? nullptr : logfile_saved;
+    output->ndump = on ? 0 : ndump_saved;
+    output->restart_flag = on ? 0 : restart_saved[0];
+    output->restart_flag_single = on ? 0 : restart_saved[1];
+    output->restart_flag_double = on ? 0 : restart_saved[2];
+    output->fix_file_flag = on ? 0 : fix_file_saved;
+  };
+
+  std::string table;
+  int ntrial = 1;
+  auto record = [&](const std::string &label, double t) {
+    ++ntrial;
+    table += fmt::format("  {:<32} | {:11.6g} | {:.4g}\n", label, t, t > 0.0 ? nsteps / t : 0.0);
+  };
+
+  double tinitial = 0.0, tbest = 0.0;
+  quiet(true);
+  try {
+
+    // the first trial warms up caches and memory pools and is not used
+
+    trial();
+    restore_state();
+    tinitial = tbest = trial();
+    restore_state();
+    record("initial settings", tinitial);
+
+    // coordinate search: vary one setting at a time,
+    // keeping the fastest value of each setting for the following ones
+
+    for (std::size_t i = 0; i < params.size(); ++i) {
+      const int which = params[i].which;
+      for (const auto &value : params[i].values) {
+        if (value == best[i]) continue;
+        apply(which, value);
+        const double t = trial();
+        restore_state();
+        record(settings(which, value).back(), t);
+        if (t < tbest * (1.0 - MINGAIN)) {
+          tbest = t;
+          best[i] = value;
+        }
+      }
+      apply(which, best[i]);
+    }
+  } catch (LAMMPSException &e) {
+
+    // the error message was not printed while output was suppressed
+
+    quiet(false);
+    if (comm->me == 0) utils::logmesg(lmp, e.what());
+    throw;
+  }
+
+  // revert to initial settings in reverse order if only reporting
+
+  if (!applyflag)
+    for (int i = params.size() - 1; i >= 0; --i) apply(params[i].which, initial[i]);
+
+  // remove fix OMP again if it was only added for the trials
+
+  if (!had_omp && modify->get_fix_by_id("package_omp") && (comm->nthreads == nthreads_initial) &&
+      !utils::strmatch(force->pair_style, "/omp$"))
+    modify->delete_fix("package_omp");
+
+  // dumps are still disabled here, so their last output step is kept
+
+  restore_state();
+  quiet(false);
+
+  if (comm->me == 0) {
+    std::string mesg = fmt::format("Autotune: {} trials of {} steps\n", ntrial, nsteps);
+    mesg += "  Setting                          |   Time (s)  | Steps/s\n";
+    mesg += "  -------------------------------------------------------\n";
+    mesg += table;
+    if (best == initial)
+      mesg += "Autotune: the initial settings are the fastest\n";
+    else
+      mesg += fmt::format("Autotune: fastest settings are {:.1f}% faster than the initial "
+                          "settings{}\n",
+                          tbest > 0.0 ? 100.0 * (tinitial / tbest - 1.0) : 0.0,
+                          applyflag ? " and have been applied" : "");
+    for (std::size_t i = 0; i < params.size(); ++i)
+      for (const auto &line : settings(params[i].which, best[i]))
+        mesg += fmt::format("  {}\n", line);
+    utils::logmesg(lmp, mesg);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   parse list of settings to tune and their candidate values
+------------------------------------------------------------------------- */
+
+void Autotune::options(int narg, char **arg)
+{
+  static const std::vector<std::string> keywords = {"newton",  "binsize", "cutoff", "multi",
+                                                    "threads", "suffix",  "sort"};
+
+  int iarg = 0;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "apply") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "autotune apply", error);
+      applyflag = utils::logical(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
+      continue;
+    }
+
+    int which = -1;
+    for (std::size_t k = 0; k < keywords.size(); ++k)
+      if (keywords[k] == arg[iarg]) which = k;
+    if (which < 0) error->all(FLERR, "Unknown autotune keyword: {}", arg[iarg]);
+    for (const auto &param : params)
+      if (param.which == which) error->all(FLERR, "Autotune keyword {} used twice", arg[iarg]);
+
+    // values extend up to the next keyword
+
+    Param param;
+    param.which = which;
+    ++iarg;
+    while ((iarg < narg) && (strcmp(arg[iarg], "apply") != 0) &&
+           (std::find(keywords.begin(), keywords.end(), arg[iarg]) == keywords.end())) {
+      const std::string word = arg[iarg];
+      if ((which == NEWTON) || (which == MULTI)) {
+        const int flag = utils::logical(FLERR, word, false, lmp);
+        if (which == NEWTON) param.values.emplace_back(flag ? "on" : "off");
+        else param.values.emplace_back(flag ? "yes" : "no");
+      } else if ((which == BINSIZE) || (which == CUTOFF)) {
+        const double value = utils::numeric(FLERR, word, false, lmp);
+        if (value < 0.0) error->all(FLERR, "Illegal autotune {} value: {}", keywords[which], word);
+        param.values.emplace_back(fmt::format("{}", value));
+      } else if ((which == OMP) || (which == SORT)) {
+        const int value = utils::inumeric(FLERR, word, false, lmp);
+        if ((value < 0) || ((which == OMP) && (value == 0)))
+          error->all(FLERR, "Illegal autotune {} value: {}", keywords[which], word);
+        param.values.emplace_back(std::to_string(value));
+      } else if (which == SUFFIX) {
+        if (word == "none") {
+          param.values.emplace_back(word);
+        } else {
+          bool known = false;
+          for (const auto &sfx : suffixes)
+            if (word == sfx) known = true;
+          if (!known) error->all(FLERR, "Unsupported autotune suffix: {}", word);
+
+          // skip suffixes without a matching pair style in this executable
+          // or that require a package command that can only be used before the box exists
+
+          if (force->pair_map->find(base_pair + "/" + word) == force->pair_map->end()) {
+            if (comm->me == 0)
+              error->warning(FLERR, "Pair style {}/{} is not available, skipping autotune suffix",
+                             base_pair, word);
+          } else if (((word == "intel") || (word == "gpu")) &&
+                     !modify->get_fix_by_id("package_" + word)) {
+            if (comm->me == 0)
+              error->warning(FLERR, "Autotune suffix {} requires package {} command, skipping",
+                             word, word);
+          } else {
+            param.values.emplace_back(word);
+          }
+        }
+      }
+      ++iarg;
+    }
+    if (param.values.empty() && (which != SUFFIX))
+      error->all(FLERR, "Autotune keyword {} requires at least one value", keywords[which]);
+    params.push_back(param);
+  }
+
+  if (params.empty()) error->all(FLERR, "Autotune command requires at least one setting to tune");
+
+  for (const auto &param : params) {
+    if ((param.which == OMP) && !modify->check_package("OMP"))
+      error->all(FLERR, "Autotune threads requires the OPENMP package");
+    if ((param.which == SUFFIX) && !force->pair->restartinfo)
+      error->all(FLERR, "Autotune suffix requires a pair style that supports restart files");
+    if ((param.which == CUTOFF) && (comm->mode != Comm::SINGLE))
+      error->all(FLERR, "Autotune cutoff requires comm_modify mode single");
+    if (param.which == MULTI) {
+      if (neighstyle == Neighbor::MULTI_OLD)
+        error->all(FLERR, "Autotune multi is not compatible with neighbor style multi/old");
+      for (const auto &other : params)
+        if (other.which == CUTOFF)
+          error->all(FLERR, "Autotune keywords cutoff and multi cannot be combined");
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   store a copy of the system state:
+   timestep, box, domain decomposition, per-atom data as packed for
+   migration (incl. per-atom data of fixes), and the global state of
+   fixes as stored in restart files
+------------------------------------------------------------------------- */
+
+void Autotune::save_state()
+{
+  ntimestep_saved = update->ntimestep;
+  atime_saved = update->atime;
+  atimestep_saved = update->atimestep;
+  for (int i = 0; i < 3; ++i) {
+    boxlo_saved[i] = domain->boxlo[i];
+    boxhi_saved[i] = domain->boxhi[i];
+  }
+  tilt_saved[0] = domain->xy;
+  tilt_saved[1] = domain->xz;
+  tilt_saved[2] = domain->yz;
+
+  // decomposition may be changed by fix balance during trials
+
+  layout_saved = comm->layout;
+  split_saved[0].assign(comm->xsplit, comm->xsplit + comm->procgrid[0] + 1);
+  split_saved[1].assign(comm->ysplit, comm->ysplit + comm->procgrid[1] + 1);
+  split_saved[2].assign(comm->zsplit, comm->zsplit + comm->procgrid[2] + 1);
+  memcpy(&mysplit_saved[0][0], &comm->mysplit[0][0], 6 * sizeof(double));
+  rcbcutfrac_saved = comm->rcbcutfrac;
+  rcbcutdim_saved = comm->rcbcutdim;
+
+  AtomVec *avec = atom->avec;
+  bigint maxone = avec->maxexchange + BUFEXTRA;
+  for (const auto &fix : modify->get_fix_list()) maxone += fix->maxexchange;
+
+  atombuf.clear();
+  bigint m = 0;
+  for (int i = 0; i < atom->nlocal; ++i) {
+    if ((bigint) atombuf.size() < m + maxone) atombuf.resize(2 * (m + maxone));
+    m += avec->pack_exchange(i, &atombuf[m]);
+  }
+  atombuf.resize(m);
+  nlocal_saved = atom->nlocal;
+
+  // global fix state uses the same format as in restart files: size + data
+
+  fixbuf.clear();
+  for (const auto &fix : modify->get_fix_list()) {
+    if (!fix->restart_global) continue;
+    FILE *fp = nullptr;
+    if (comm->me == 0) {
+      fp = tmpfile();
+      if (!fp)
+        error->one(FLERR, "Cannot create temporary file for autotune: {}", utils::getsyserror());
+    }
+    fix->write_restart(fp);
+
+    int nbytes = 0;
+    std::vector<char> data;
+    if (comm->me == 0) {
+      nbytes = ftell(fp);
+      data.resize(nbytes);
+      rewind(fp);
+      if (nbytes) utils::sfread(FLERR, data.data(), 1, nbytes, fp, nullptr, error);
+      fclose(fp);
+    }
+    MPI_Bcast(&nbytes, 1, MPI_INT, 0, world);
+    data.resize(nbytes);
+    if (nbytes) MPI_Bcast(data.data(), nbytes, MPI_CHAR, 0, world);
+    if (nbytes > (int) sizeof(int)) fixbuf.emplace_back(fix->id, data);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   reset the system to the stored state
+------------------------------------------------------------------------- */
+
+void Autotune::restore_state()
+{
+  update->reset_timestep(ntimestep_saved, false);
+  update->atime = atime_saved;
+  update->atimestep = atimestep_saved;
+
+  for (int i = 0; i < 3; ++i) {
+    domain->boxlo[i] = boxlo_saved[i];
+    domain->boxhi[i] = boxhi_saved[i];
+  }
+  domain->xy = tilt_saved[0];
+  domain->xz = tilt_saved[1];
+  domain->yz = tilt_saved[2];
+  domain->set_global_box();
+
+  // restore decomposition, so the saved atoms are inside the sub-domain again
+  // grids distributed across procs must follow a changed decomposition
+
+  bool changed = (comm->layout != layout_saved);
+  comm->layout = layout_saved;
+  double *split[3] = {comm->xsplit, comm->ysplit, comm->zsplit};
+  for (int d = 0; d < 3; ++d) {
+    if (!std::equal(split_saved[d].begin(), split_saved[d].end(), split[d])) changed = true;
+    std::copy(split_saved[d].begin(), split_saved[d].end(), split[d]);
+  }
+  if (layout_saved == Comm::LAYOUT_TILED) {
+    if (memcmp(&mysplit_saved[0][0], &comm->mysplit[0][0], 6 * sizeof(double)) != 0)
+      changed = true;
+    memcpy(&comm->mysplit[0][0], &mysplit_saved[0][0], 6 * sizeof(double));
+    comm->rcbcutfrac = rcbcutfrac_saved;
+    comm->rcbcutdim = rcbcutdim_saved;
+    comm->rcbnew = 1;
+  }
+  domain->set_local_box();
+
+  int anychange, mychange = changed ? 1 : 0;
+  MPI_Allreduce(&mychange, &anychange, 1, MPI_INT, MPI_MAX, world);
+
+  // replace all owned atoms with the saved ones
+
+  if (atom->map_style != Atom::MAP_NONE) atom->map_clear();
+  atom->avec->clear_bonus();
+  atom->nlocal = 0;
+  atom->nghost = 0;
+  bigint m = 0;
+  while (m < (bigint) atombuf.size()) m += atom->avec->unpack_exchange(&atombuf[m]);
+  if (atom->nlocal != nlocal_saved) error->one(FLERR, "Autotune failed to restore atoms");
+  if (atom->map_style != Atom::MAP_NONE) {
+    atom->map_init();
+    atom->map_set();
+  }
+
+  for (auto &saved : fixbuf) {
+    auto *fix = modify->get_fix_by_id(saved.first);
+    if (fix) fix->restart(saved.second.data() + sizeof(int));
+  }
+
+  if (anychange) {
+    modify->reset_grid();
+    if (force->pair) force->pair->reset_grid();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   run one trial segment like the run command and return its wall time
+------------------------------------------------------------------------- */
+
+double Autotune::trial()
+{
+  update->whichflag = 1;
+  update->nsteps = nsteps;
+  update->firststep = update->beginstep = update->ntimestep;
+  update->laststep = update->endstep = update->ntimestep + nsteps;
+  timer->init_timeout();
+
+  lmp->init();
+  update->integrate->setup(1);
+
+  timer->init();
+  timer->barrier_start();
+  update->integrate->run(nsteps);
+  timer->barrier_stop();
+  update->integrate->cleanup();
+
+  update->whichflag = 0;
+  update->firststep = update->laststep = 0;
+  update->beginstep = update->endstep = 0;
+
+  double tloop = timer->get_wall(Timer::TOTAL);
+  double tmax;
+  MPI_Allreduce(&tloop, &tmax, 1, MPI_DOUBLE, MPI_MAX, world);
+  return tmax;
+}
+
+/* ----------------------------------------------------------------------
+   current value of a setting in the same format as the parsed values
+------------------------------------------------------------------------- */
+
+std::string Autotune::current(int which)
+{
+  switch (which) {
+    case NEWTON:
+      return force->newton_pair ? "on" : "off";
+    case BINSIZE:
+      return fmt::format("{}", neighbor->binsizeflag ? neighbor->binsize_user : 0.0);
+    case CUTOFF:
+      return fmt::format("{}", comm->cutghostuser);
+    case MULTI:
+      return (comm->mode == Comm::MULTI) ? "yes" : "no";
+    case OMP:
+      return std::to_string(comm->nthreads);
+    case SUFFIX:
+      if (base_pair == force->pair_style) return "none";
+      return std::string(force->pair_style).substr(base_pair.size() + 1);
+    case SORT:
+      return std::to_string(atom->sortfreq);
+  }
+  return "";
+}
+
+/* ----------------------------------------------------------------------
+   input commands that select a value of a setting
+------------------------------------------------------------------------- */
+
+std::vector<std::string> Autotune::settings(int which, const std::string &value)
+{
+  switch (which) {
+    case NEWTON:
+      return {fmt::format("newton {} {}", value, force->newton_bond ? "on" : "off")};
+    case BINSIZE:
+      return {"neigh_modify binsize " + value};
+    case CUTOFF:
+      return {"comm_modify cutoff " + value};
+    case MULTI:
+      if (value == "yes")
+        return {fmt::format("neighbor {} multi", neighbor->skin), "comm_modify mode multi"};
+      return {fmt::format("neighbor {} {}", neighbor->skin,
+                          neighstyles[neighstyle == Neighbor::MULTI ? Neighbor::BIN : neighstyle]),
+              "comm_modify mode single"};
+    case OMP:
+      return {"package omp " + value};
+    case SUFFIX:
+      if (value == "none") return {fmt::format("pair_style {} ...", base_pair)};
+      return {fmt::format("pair_style {}/{} ...", base_pair, value)};
+    case SORT:
+      return {fmt::format("atom_modify sort {} {}", value, atom->userbinsize)};
+  }
+  return {};
+}
+
+/* ----------------------------------------------------------------------
+   select a value of a setting
+   a different pair style variant is created from the restart info of the current one
+------------------------------------------------------------------------- */
+
+void Autotune::apply(int which, const std::string &value)
+{
+  // the package command cannot be used after the box is defined,
+  // but fix OMP supports changing the number of threads between runs
+
+  if (which == OMP) {
+    const int nthreads = comm->nthreads;
+    modify->add_fix("package_omp all OMP " + value);
+
+    // per-thread force arrays are stored in per-atom arrays of size nmax*nthreads
+
+    if (comm->nthreads > nthreads) atom->avec->grow(atom->nmax);
+    return;
+  }
+  if (which != SUFFIX) {
+    for (const auto &line : settings(which, value)) input->one(line);
+    return;
+  }
+
+  const std::string style = (value == "none") ? base_pair : base_pair + "/" + value;
+  if (style == force->pair_style) return;
+
+  // /omp styles require fix OMP as created by the package command
+
+  if ((value == "omp") && !modify->get_fix_by_id("package_omp"))
+    modify->add_fix("package_omp all OMP 0");
+
+  FILE *fp = nullptr;
+  if (comm->me == 0) {
+    fp = tmpfile();
+    if (!fp)
+      error->one(FLERR, "Cannot create temporary file for autotune: {}", utils::getsyserror());
+    force->pair->write_restart(fp);
+    rewind(fp);
+  }
+  force->create_pair(style, 0);
+  force->pair->read_restart(fp);
+  if (fp) fclose(fp);
+}
@@ -0,0 +1,72 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef COMMAND_CLASS
+// clang-format off
+CommandStyle(autotune,Autotune);
+// clang-format on
+#else
+
+#ifndef LMP_AUTOTUNE_H
+#define LMP_AUTOTUNE_H
+
+#include "command.h"
+
+namespace LAMMPS_NS {
+
+class Autotune : public Command {
+ public:
+  Autotune(class LAMMPS *);
+  void command(int, char **) override;
+
+ private:
+  enum { NEWTON, BINSIZE, CUTOFF, MULTI, OMP, SUFFIX, SORT };
+
+  struct Param {
+    int which;
+    std::vector<std::string> values;
+  };
+
+  std::vector<Param> params;
+  int nsteps;         // # of timesteps per trial
+  int applyflag;      // 1 to keep the fastest settings, 0 to only print them
+  int neighstyle;     // original neighbor style
+  std::string base_pair;    // pair style without accelerator suffix
+
+  // snapshot of the system state that trials start from
+
+  bigint ntimestep_saved, atimestep_saved;
+  double atime_saved;
+  double boxlo_saved[3], boxhi_saved[3], tilt_saved[3];
+  int nlocal_saved;
+  int layout_saved;
+  std::vector<double> split_saved[3];    // xsplit, ysplit, zsplit of brick layouts
+  double mysplit_saved[3][2];            // RCB sub-domain of tiled layout
+  double rcbcutfrac_saved;
+  int rcbcutdim_saved;
+  std::vector<double> atombuf;
+  std::vector<std::pair<std::string, std::vector<char>>> fixbuf;
+
+  void options(int, char **);
+  void save_state();
+  void restore_state();
+  double trial();
+  std::string current(int);
+  std::vector<std::string> settings(int, const std::string &);
+  void apply(int, const std::string &);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -47,7 +47,8 @@ class Comm : protected Pointers {
   int other_partition_style;    // 0 = recv layout dims must be multiple of
                                 //     my layout dims
 
-  int nthreads;    // OpenMP threads per MPI process
+  int nthreads;       // OpenMP threads per MPI process
+  bigint nmigrate;    // # of atoms sent to other procs by exchange()
 
   // public settings specific to layout = UNIFORM, NONUNIFORM
 
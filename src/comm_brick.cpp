@@ -708,6 +708,7 @@ void CommBrick::exchange()
         nsend += avec->pack_exchange(i,&buf_send[nsend]);
         avec->copy(nlocal-1,i,1);
         nlocal--;
+        nmigrate++;
       } else i++;
     }
     atom->nlocal = nlocal;
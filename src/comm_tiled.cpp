@@ -987,6 +987,7 @@ void CommTiled::exchange()
         if (proc != me) {
           buf_send[nsend++] = proc;
           nsend += avec->pack_exchange(i,&buf_send[nsend]);
+          nmigrate++;
         } else {
           // DEBUG statment
           // error->warning(FLERR,"Losing atom in CommTiled::exchange() send, "
@@ -70,6 +70,9 @@ Compute::Compute(LAMMPS *lmp, int narg, char **arg) :
   scalar = 0.0;
 
   timeflag = 0;
+  walltime = 0.0;
+  trace_slot = -1;
+  size_partial_scalar = size_partial_vector = 0;
   comm_forward = comm_reverse = 0;
   dynamic = 0;
   dynamic_group_allow = 1;
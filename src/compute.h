@@ -99,6 +99,16 @@ class Compute : protected Pointers {
 
   double dof;    // degrees-of-freedom for temperature
 
+  double walltime;    // wall time spent in this compute, if enabled by timer command
+  int trace_slot;     // index of this compute in trace of timer command, -1 if not traced yet
+
+  // optional deferred reduction of global scalar and vector
+  // partial_*() computes local partial sums, which the caller sums across procs
+  //   with those of other computes in one MPI_Allreduce() before calling finish_*()
+
+  int size_partial_scalar;    // # of partial sums for global scalar, 0 if not supported
+  int size_partial_vector;    // # of partial sums for global vector, 0 if not supported
+
   int comm_forward;           // size of forward communication (0 if none)
   int comm_reverse;           // size of reverse communication (0 if none)
   int dynamic_group_allow;    // 1 if can be used with dynamic group, else 0
@@ -127,6 +137,11 @@ class Compute : protected Pointers {
   virtual void compute_pergrid() {}
   virtual void set_arrays(int) {}
 
+  virtual void partial_scalar(double *) {}
+  virtual double finish_scalar(const double *) { return 0.0; }
+  virtual void partial_vector(double *) {}
+  virtual void finish_vector(const double *) {}
+
   virtual int pack_forward_comm(int, int *, double *, int, int *) { return 0; }
   virtual void unpack_forward_comm(int, int, double *) {}
   virtual int pack_reverse_comm(int, int, double *) { return 0; }
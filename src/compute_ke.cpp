@@ -28,6 +28,7 @@ ComputeKE::ComputeKE(LAMMPS *lmp, int narg, char **arg) : Compute(lmp, narg, arg
 
   scalar_flag = 1;
   extscalar = 1;
+  size_partial_scalar = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -40,6 +41,16 @@ void ComputeKE::init()
 /* ---------------------------------------------------------------------- */
 
 double ComputeKE::compute_scalar()
+{
+  double ke, sum;
+  partial_scalar(&ke);
+  MPI_Allreduce(&ke, &sum, 1, MPI_DOUBLE, MPI_SUM, world);
+  return finish_scalar(&sum);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeKE::partial_scalar(double *partial)
 {
   invoked_scalar = update->ntimestep;
 
@@ -62,7 +73,13 @@ double ComputeKE::compute_scalar()
         ke += mass[type[i]] * (v[i][0] * v[i][0] + v[i][1] * v[i][1] + v[i][2] * v[i][2]);
   }
 
-  MPI_Allreduce(&ke, &scalar, 1, MPI_DOUBLE, MPI_SUM, world);
-  scalar *= pfactor;
+  partial[0] = ke;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double ComputeKE::finish_scalar(const double *sum)
+{
+  scalar = sum[0] * pfactor;
   return scalar;
 }
@@ -42,6 +42,7 @@ ComputePE::ComputePE(LAMMPS *lmp, int narg, char **arg) : Compute(lmp, narg, arg
   extscalar = 1;
   peflag = 1;
   timeflag = 1;
+  size_partial_scalar = 1;
 
   if (narg == 3) {
     pairflag = 1;
@@ -82,6 +83,16 @@ ComputePE::ComputePE(LAMMPS *lmp, int narg, char **arg) : Compute(lmp, narg, arg
 /* ---------------------------------------------------------------------- */
 
 double ComputePE::compute_scalar()
+{
+  double one, sum;
+  partial_scalar(&one);
+  MPI_Allreduce(&one, &sum, 1, MPI_DOUBLE, MPI_SUM, world);
+  return finish_scalar(&sum);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputePE::partial_scalar(double *partial)
 {
   invoked_scalar = update->ntimestep;
   if (update->eflag_global != invoked_scalar)
@@ -96,8 +107,16 @@ double ComputePE::compute_scalar()
     if (dihedralflag && force->dihedral) one += force->dihedral->energy;
     if (improperflag && force->improper) one += force->improper->energy;
   }
+  partial[0] = one;
+}
 
-  MPI_Allreduce(&one, &scalar, 1, MPI_DOUBLE, MPI_SUM, world);
+/* ----------------------------------------------------------------------
+   add contributions that are already summed across procs
+------------------------------------------------------------------------- */
+
+double ComputePE::finish_scalar(const double *sum)
+{
+  scalar = sum[0];
 
   if (kspaceflag && force->kspace) scalar += force->kspace->energy;
 
@@ -46,6 +46,8 @@ ComputePressure::ComputePressure(LAMMPS *lmp, int narg, char **arg) :
   extscalar = 0;
   extvector = 0;
   pressflag = 1;
+  size_partial_scalar = (domain->dimension == 3) ? 3 : 2;
+  size_partial_vector = (domain->dimension == 3) ? 6 : 4;
   timeflag = 1;
 
   // store temperature ID used by pressure computation
@@ -226,11 +228,29 @@ void ComputePressure::init()
 ------------------------------------------------------------------------- */
 
 double ComputePressure::compute_scalar()
+{
+  const int n = (dimension == 3) ? 3 : 2;
+  double v[3], sum[3];
+  partial_scalar(v);
+  MPI_Allreduce(v, sum, n, MPI_DOUBLE, MPI_SUM, world);
+  return finish_scalar(sum);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputePressure::partial_scalar(double *v)
 {
   invoked_scalar = update->ntimestep;
   if (update->vflag_global != invoked_scalar)
     error->all(FLERR,"Virial was not tallied on needed timestep");
 
+  virial_partial((dimension == 3) ? 3 : 2, v);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double ComputePressure::finish_scalar(const double *sum)
+{
   // invoke temperature if it hasn't been already
 
   if (keflag) {
@@ -240,7 +260,7 @@ double ComputePressure::compute_scalar()
 
   if (dimension == 3) {
     inv_volume = 1.0 / (domain->xprd * domain->yprd * domain->zprd);
-    virial_compute(3,3);
+    virial_finish(3,3,sum);
     if (keflag)
       scalar = (temperature->dof * boltz * temperature->scalar +
                 virial[0] + virial[1] + virial[2]) / 3.0 * inv_volume * nktv2p;
@@ -248,7 +268,7 @@ double ComputePressure::compute_scalar()
       scalar = (virial[0] + virial[1] + virial[2]) / 3.0 * inv_volume * nktv2p;
   } else {
     inv_volume = 1.0 / (domain->xprd * domain->yprd);
-    virial_compute(2,2);
+    virial_finish(2,2,sum);
     if (keflag)
       scalar = (temperature->dof * boltz * temperature->scalar +
                 virial[0] + virial[1]) / 2.0 * inv_volume * nktv2p;
@@ -265,6 +285,17 @@ double ComputePressure::compute_scalar()
 ------------------------------------------------------------------------- */
 
 void ComputePressure::compute_vector()
+{
+  const int n = (dimension == 3) ? 6 : 4;
+  double v[6], sum[6];
+  partial_vector(v);
+  MPI_Allreduce(v, sum, n, MPI_DOUBLE, MPI_SUM, world);
+  finish_vector(sum);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputePressure::partial_vector(double *v)
 {
   invoked_vector = update->ntimestep;
   if (update->vflag_global != invoked_vector)
@@ -274,6 +305,13 @@ void ComputePressure::compute_vector()
     error->all(FLERR,"Must use 'kspace_modify pressure/scalar no' for "
                "tensor components with kspace_style msm");
 
+  virial_partial((dimension == 3) ? 6 : 4, v);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputePressure::finish_vector(const double *sum)
+{
   // invoke temperature if it hasn't been already
 
   double *ke_tensor;
@@ -285,7 +323,7 @@ void ComputePressure::compute_vector()
 
   if (dimension == 3) {
     inv_volume = 1.0 / (domain->xprd * domain->yprd * domain->zprd);
-    virial_compute(6,3);
+    virial_finish(6,3,sum);
     if (keflag) {
       for (int i = 0; i < 6; i++)
         vector[i] = (ke_tensor[i] + virial[i]) * inv_volume * nktv2p;
@@ -294,7 +332,7 @@ void ComputePressure::compute_vector()
         vector[i] = virial[i] * inv_volume * nktv2p;
   } else {
     inv_volume = 1.0 / (domain->xprd * domain->yprd);
-    virial_compute(4,2);
+    virial_finish(4,2,sum);
     if (keflag) {
       vector[0] = (ke_tensor[0] + virial[0]) * inv_volume * nktv2p;
       vector[1] = (ke_tensor[1] + virial[1]) * inv_volume * nktv2p;
@@ -312,22 +350,42 @@ void ComputePressure::compute_vector()
 /* ---------------------------------------------------------------------- */
 
 void ComputePressure::virial_compute(int n, int ndiag)
+{
+  double v[6], sum[6];
+
+  // sum virial across procs
+
+  virial_partial(n,v);
+  MPI_Allreduce(v,sum,n,MPI_DOUBLE,MPI_SUM,world);
+  virial_finish(n,ndiag,sum);
+}
+
+/* ----------------------------------------------------------------------
+   sum contributions to virial from forces and fixes on this proc
+------------------------------------------------------------------------- */
+
+void ComputePressure::virial_partial(int n, double *v)
 {
   int i,j;
-  double v[6],*vcomponent;
+  double *vcomponent;
 
   for (i = 0; i < n; i++) v[i] = 0.0;
 
-  // sum contributions to virial from forces and fixes
-
   for (j = 0; j < nvirial; j++) {
     vcomponent = vptr[j];
     for (i = 0; i < n; i++) v[i] += vcomponent[i];
   }
+}
 
-  // sum virial across procs
+/* ----------------------------------------------------------------------
+   add contributions that are already summed across procs to summed virial
+------------------------------------------------------------------------- */
+
+void ComputePressure::virial_finish(int n, int ndiag, const double *sum)
+{
+  int i;
 
-  MPI_Allreduce(v,virial,n,MPI_DOUBLE,MPI_SUM,world);
+  for (i = 0; i < n; i++) virial[i] = sum[i];
 
   // KSpace virial contribution is already summed across procs
 
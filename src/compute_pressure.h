@@ -31,6 +31,10 @@ class ComputePressure : public Compute {
   void init() override;
   double compute_scalar() override;
   void compute_vector() override;
+  void partial_scalar(double *) override;
+  double finish_scalar(const double *) override;
+  void partial_vector(double *) override;
+  void finish_vector(const double *) override;
   void reset_extra_compute_fix(const char *) override;
 
  protected:
@@ -47,6 +51,8 @@ class ComputePressure : public Compute {
   int fixflag, kspaceflag;
 
   void virial_compute(int, int);
+  void virial_partial(int, double *);
+  void virial_finish(int, int, const double *);
 
  private:
   char *pstyle;
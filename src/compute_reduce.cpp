@@ -328,6 +328,15 @@ ComputeReduce::ComputeReduce(LAMMPS *lmp, int narg, char **arg) :
     owner = new int[size_vector];
   }
 
+  // sums can be combined with the reductions of other computes
+
+  if (mode == SUM || mode == SUMSQ || mode == SUMABS) {
+    if (nvalues == 1)
+      size_partial_scalar = 1;
+    else
+      size_partial_vector = nvalues;
+  }
+
   maxatom = 0;
   varatom = nullptr;
 }
@@ -408,9 +417,8 @@ void ComputeReduce::compute_vector()
       indices[m] = index;
     }
 
-  if (mode == SUM || mode == SUMSQ || mode == AVEABS) {
-    for (int m = 0; m < nvalues; m++)
-      MPI_Allreduce(&onevec[m], &vector[m], 1, MPI_DOUBLE, MPI_SUM, world);
+  if (mode == SUM || mode == SUMSQ || mode == SUMABS) {
+    MPI_Allreduce(onevec, vector, nvalues, MPI_DOUBLE, MPI_SUM, world);
   } else if (mode == MINABS || mode == MAXABS) {
     for (int m = 0; m < nvalues; m++)
       MPI_Allreduce(&onevec[m], &vector[m], 1, MPI_DOUBLE, this->scalar_reduction_operation, world);
@@ -456,14 +464,47 @@ void ComputeReduce::compute_vector()
     }
 
   } else if (mode == AVE || mode == AVESQ || mode == AVEABS) {
+    MPI_Allreduce(onevec, vector, nvalues, MPI_DOUBLE, MPI_SUM, world);
     for (int m = 0; m < nvalues; m++) {
-      MPI_Allreduce(&onevec[m], &vector[m], 1, MPI_DOUBLE, MPI_SUM, world);
       bigint n = count(m);
       if (n) vector[m] /= n;
     }
   }
 }
 
+/* ----------------------------------------------------------------------
+   deferred reduction, only used for sum modes
+------------------------------------------------------------------------- */
+
+void ComputeReduce::partial_scalar(double *partial)
+{
+  invoked_scalar = update->ntimestep;
+  partial[0] = compute_one(0, -1);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double ComputeReduce::finish_scalar(const double *sum)
+{
+  scalar = sum[0];
+  return scalar;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeReduce::partial_vector(double *partial)
+{
+  invoked_vector = update->ntimestep;
+  for (int m = 0; m < nvalues; m++) partial[m] = compute_one(m, -1);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeReduce::finish_vector(const double *sum)
+{
+  for (int m = 0; m < nvalues; m++) vector[m] = sum[m];
+}
+
 /* ----------------------------------------------------------------------
    calculate reduced value for one input M and return it
    if flag = -1:
@@ -33,6 +33,8 @@ ComputeTemp::ComputeTemp(LAMMPS *lmp, int narg, char **arg) : Compute(lmp, narg,
   extscalar = 0;
   extvector = 1;
   tempflag = 1;
+  size_partial_scalar = 1;
+  size_partial_vector = 6;
 
   vector = new double[size_vector];
 }
@@ -70,6 +72,16 @@ void ComputeTemp::dof_compute()
 /* ---------------------------------------------------------------------- */
 
 double ComputeTemp::compute_scalar()
+{
+  double t, sum;
+  partial_scalar(&t);
+  MPI_Allreduce(&t, &sum, 1, MPI_DOUBLE, MPI_SUM, world);
+  return finish_scalar(&sum);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeTemp::partial_scalar(double *t)
 {
   invoked_scalar = update->ntimestep;
 
@@ -80,19 +92,25 @@ double ComputeTemp::compute_scalar()
   int *mask = atom->mask;
   int nlocal = atom->nlocal;
 
-  double t = 0.0;
+  double one = 0.0;
 
   if (rmass) {
     for (int i = 0; i < nlocal; i++)
       if (mask[i] & groupbit)
-        t += (v[i][0] * v[i][0] + v[i][1] * v[i][1] + v[i][2] * v[i][2]) * rmass[i];
+        one += (v[i][0] * v[i][0] + v[i][1] * v[i][1] + v[i][2] * v[i][2]) * rmass[i];
   } else {
     for (int i = 0; i < nlocal; i++)
       if (mask[i] & groupbit)
-        t += (v[i][0] * v[i][0] + v[i][1] * v[i][1] + v[i][2] * v[i][2]) * mass[type[i]];
+        one += (v[i][0] * v[i][0] + v[i][1] * v[i][1] + v[i][2] * v[i][2]) * mass[type[i]];
   }
+  t[0] = one;
+}
+
+/* ---------------------------------------------------------------------- */
 
-  MPI_Allreduce(&t, &scalar, 1, MPI_DOUBLE, MPI_SUM, world);
+double ComputeTemp::finish_scalar(const double *sum)
+{
+  scalar = sum[0];
   if (dynamic) dof_compute();
   if (dof < 0.0 && natoms_temp > 0.0)
     error->all(FLERR, "Temperature compute degrees of freedom < 0");
@@ -103,6 +121,16 @@ double ComputeTemp::compute_scalar()
 /* ---------------------------------------------------------------------- */
 
 void ComputeTemp::compute_vector()
+{
+  double t[6];
+  partial_vector(t);
+  MPI_Allreduce(t, vector, 6, MPI_DOUBLE, MPI_SUM, world);
+  finish_vector(vector);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeTemp::partial_vector(double *t)
 {
   int i;
 
@@ -115,7 +143,7 @@ void ComputeTemp::compute_vector()
   int *mask = atom->mask;
   int nlocal = atom->nlocal;
 
-  double massone, t[6];
+  double massone;
   for (i = 0; i < 6; i++) t[i] = 0.0;
 
   for (i = 0; i < nlocal; i++)
@@ -131,7 +159,11 @@ void ComputeTemp::compute_vector()
       t[4] += massone * v[i][0] * v[i][2];
       t[5] += massone * v[i][1] * v[i][2];
     }
+}
 
-  MPI_Allreduce(t, vector, 6, MPI_DOUBLE, MPI_SUM, world);
-  for (i = 0; i < 6; i++) vector[i] *= force->mvv2e;
+/* ---------------------------------------------------------------------- */
+
+void ComputeTemp::finish_vector(const double *sum)
+{
+  for (int i = 0; i < 6; i++) vector[i] = sum[i] * force->mvv2e;
 }
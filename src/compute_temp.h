@@ -32,6 +32,10 @@ class ComputeTemp : public Compute {
   void setup() override;
   double compute_scalar() override;
   void compute_vector() override;
+  void partial_scalar(double *) override;
+  double finish_scalar(const double *) override;
+  void partial_vector(double *) override;
+  void finish_vector(const double *) override;
 
  protected:
   double tfactor;
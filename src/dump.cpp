@@ -48,7 +48,8 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
     Pointers(lmp), multiname(nullptr), idrefresh(nullptr), irefresh(nullptr), skipvar(nullptr),
     format(nullptr), format_default(nullptr), format_line_user(nullptr), format_float_user(nullptr),
     format_int_user(nullptr), format_bigint_user(nullptr), format_column_user(nullptr), fp(nullptr),
-    nameslist(nullptr), buf(nullptr), sbuf(nullptr), ids(nullptr), bufsort(nullptr),
+    nameslist(nullptr), buf(nullptr), sbuf(nullptr), abuf(nullptr), async_thread(nullptr),
+    ids(nullptr), bufsort(nullptr),
     idsort(nullptr), index(nullptr), proclist(nullptr), xpbc(nullptr), vpbc(nullptr),
     imagepbc(nullptr), irregular(nullptr)
 {
@@ -77,6 +78,12 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
   append_flag = 0;
   buffer_allow = 0;
   buffer_flag = 0;
+  async_allow = 0;
+  sbuf_line = 0;
+  async_flag = 0;
+  async_error = 0;
+  mpiio_allow = 0;
+  mpiio_flag = 0;
   padflag = 0;
   pbcflag = 0;
   time_flag = 0;
@@ -94,6 +101,7 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
 
   maxbuf = maxids = maxsort = maxproc = 0;
   maxsbuf = 0;
+  maxabuf = 0;
 
   maxpbc = -1;
 
@@ -140,6 +148,11 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
 
 Dump::~Dump()
 {
+  // derived classes may already be destructed here,
+  // so Output must call async_wait() before deleting a dump
+
+  async_wait();
+
   delete[] id;
   delete[] style;
   delete[] filename;
@@ -166,6 +179,7 @@ Dump::~Dump()
   delete irregular;
 
   memory->destroy(sbuf);
+  memory->destroy(abuf);
 
   if (pbcflag) {
     memory->destroy(xpbc);
@@ -200,8 +214,18 @@ Dump::~Dump()
 
 void Dump::init()
 {
+  async_wait();
   init_style();
 
+  if (mpiio_flag) {
+    if (multiproc)
+      error->all(FLERR,"Dump {} with MPI-IO output cannot write multiple files per snapshot", id);
+    if (compressed)
+      error->all(FLERR,"Dump {} with MPI-IO output cannot write compressed files", id);
+    if (async_flag)
+      error->all(FLERR,"Dump {} with MPI-IO output cannot use async output", id);
+  }
+
   if (!sort_flag) {
     memory->destroy(bufsort);
     memory->destroy(ids);
@@ -328,6 +352,10 @@ void Dump::write()
   imageint *imagehold;
   double **xhold,**vhold;
 
+  // previous snapshot must be completely written before file or buffers are changed
+
+  if (async_flag) async_wait();
+
   // simulation box bounds
 
   if (domain->triclinic == 0) {
@@ -450,8 +478,9 @@ void Dump::write()
   // if buffering, convert doubles into strings
   // ensure sbuf is sized for communicating
   // cannot buffer if output is to binary file
+  // with async output, conversion is done by the writer thread instead
 
-  if (buffer_flag && !binary) {
+  if (buffer_flag && !binary && !async_flag && !mpiio_flag) {
     nsme = convert_string(nme,buf);
     int nsmin,nsmax;
     MPI_Allreduce(&nsme,&nsmin,1,MPI_INT,MPI_MIN,world);
@@ -473,9 +502,65 @@ void Dump::write()
   MPI_Status status;
   MPI_Request request;
 
+  // MPI-IO output: each proc writes its own data directly to the file
+
+  if (mpiio_flag) {
+    write_mpiio();
+
+  // async output: gather all bufs of my cluster into abuf
+  // and hand them to a background thread for conversion and output
+
+  } else if (async_flag) {
+    if (filewriter) {
+      bigint nabuf = nheader * size_one;
+      if (nabuf > maxabuf) {
+        maxabuf = nabuf;
+        memory->destroy(abuf);
+        memory->create(abuf,maxabuf,"dump:abuf");
+      }
+      async_lines.resize(nclusterprocs);
+      bigint offset = 0;
+      for (int iproc = 0; iproc < nclusterprocs; iproc++) {
+        if (iproc) {
+          int nrecv = static_cast<int> (MIN(maxbuf,nabuf-offset));
+          MPI_Irecv(abuf+offset,nrecv,MPI_DOUBLE,me+iproc,0,world,&request);
+          MPI_Send(&tmp,0,MPI_INT,me+iproc,0,world);
+          MPI_Wait(&request,&status);
+          MPI_Get_count(&status,MPI_DOUBLE,&nlines);
+          nlines /= size_one;
+        } else {
+          nlines = nme;
+          if (nme) memcpy(abuf,buf,sizeof(double)*nme*size_one);
+        }
+        async_lines[iproc] = nlines;
+        offset += (bigint) nlines * size_one;
+      }
+
+      // size sbuf here for the largest chunk, so the thread never grows it
+
+      if (buffer_flag && !binary) {
+        int nlinemax = 0;
+        for (int n : async_lines) nlinemax = MAX(nlinemax,n);
+        bigint nsbuf = (bigint) (nlinemax+1) * sbuf_line;
+        if (nsbuf > MAXSMALLINT)
+          error->one(FLERR,"Too much buffered per-proc info for dump {}", id);
+        if (nsbuf > maxsbuf) {
+          maxsbuf = nsbuf;
+          memory->grow(sbuf,maxsbuf,"dump:sbuf");
+        }
+      }
+
+      async_error = 0;
+      async_thread = new std::thread(&Dump::write_async,this);
+
+    } else {
+      MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
+      MPI_Rsend(buf,nme*size_one,MPI_DOUBLE,fileproc,0,world);
+    }
+
   // comm and output buf of doubles
 
-  if (buffer_flag == 0 || binary) {
+  } else if (buffer_flag == 0 || binary) {
     if (filewriter) {
       for (int iproc = 0; iproc < nclusterprocs; iproc++) {
         if (iproc) {
@@ -530,6 +615,10 @@ void Dump::write()
 
   if (refreshflag) irefresh->refresh();
 
+  // with async output, the writer thread finishes and closes the file
+
+  if (async_flag) return;
+
   if (filewriter && fp != nullptr) write_footer();
 
   if (fp && ferror(fp)) error->one(FLERR,"Error writing dump {}: {}", id, utils::getsyserror());
@@ -546,6 +635,124 @@ void Dump::write()
   }
 }
 
+/* ----------------------------------------------------------------------
+   write snapshot gathered in abuf to file, runs in async_thread
+   convert to strings, if buffering, then write one chunk per proc in cluster
+   must not use MPI or raise errors, failures are reported via async_error
+------------------------------------------------------------------------- */
+
+void Dump::write_async()
+{
+  bigint offset = 0;
+  for (int nlines : async_lines) {
+    if (buffer_flag && !binary) {
+      int nchars = convert_string(nlines,abuf+offset);
+      if (nchars < 0) {
+        async_error = 2;
+        break;
+      }
+      write_data(nchars,(double *) sbuf);
+    } else write_data(nlines,abuf+offset);
+    offset += (bigint) nlines * size_one;
+  }
+
+  if (fp == nullptr) return;
+  if (flush_flag) fflush(fp);
+  write_footer();
+  if (ferror(fp) && !async_error) async_error = 1;
+
+  if (multifile) {
+    if (compressed) platform::pclose(fp);
+    else fclose(fp);
+    fp = nullptr;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   write data of all procs into a single shared file via collective MPI-IO
+   filewriter has already written the header via fp, data follows at end of file
+   each proc writes one chunk at an offset computed by prefix sum over chunk sizes
+   binary chunks are the same as for write_binary(): chunk length + doubles
+   text chunks are the strings from convert_string(), so procs can use any format
+------------------------------------------------------------------------- */
+
+void Dump::write_mpiio()
+{
+#if !defined(MPI_STUBS)
+  bigint header_end = 0;
+  if (filewriter) {
+    fflush(fp);
+    platform::fseek(fp,platform::END_OF_FILE);
+    header_end = platform::ftell(fp);
+  }
+  MPI_Bcast(&header_end,1,MPI_LMP_BIGINT,0,world);
+
+  bigint nbytes;
+  if (binary) {
+    nbytes = sizeof(int) + (bigint) nme * size_one * sizeof(double);
+  } else {
+    nsme = convert_string(nme,buf);
+    int nsmin;
+    MPI_Allreduce(&nsme,&nsmin,1,MPI_INT,MPI_MIN,world);
+    if (nsmin < 0) error->all(FLERR,"Too much buffered per-proc info for dump");
+    nbytes = nsme;
+  }
+
+  // offset = position of my chunk in file, MPI_Exscan() leaves it undefined on proc 0
+
+  bigint offset = 0, nbytes_all;
+  MPI_Exscan(&nbytes,&offset,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  if (me == 0) offset = 0;
+  offset += header_end;
+  MPI_Allreduce(&nbytes,&nbytes_all,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
+  MPI_File fh;
+  int err = MPI_File_open(world,mpiio_file.c_str(),MPI_MODE_WRONLY,MPI_INFO_NULL,&fh);
+  if (err != MPI_SUCCESS) error->all(FLERR,"Cannot open dump file {} for MPI-IO", mpiio_file);
+
+  int flag = 0;
+  if (binary) {
+    int n = nme * size_one;
+    if (MPI_File_write_at_all(fh,offset,&n,1,MPI_INT,MPI_STATUS_IGNORE) != MPI_SUCCESS)
+      flag = 1;
+    if (MPI_File_write_at_all(fh,offset+sizeof(int),buf,n,MPI_DOUBLE,MPI_STATUS_IGNORE)
+        != MPI_SUCCESS)
+      flag = 1;
+  } else {
+    if (MPI_File_write_at_all(fh,offset,sbuf,nsme,MPI_CHAR,MPI_STATUS_IGNORE) != MPI_SUCCESS)
+      flag = 1;
+  }
+  MPI_File_close(&fh);
+
+  int flagall;
+  MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,world);
+  if (flagall) error->all(FLERR,"Error writing dump {} via MPI-IO", id);
+
+  // move file pointer past the data for footer and next snapshot
+
+  if (filewriter) platform::fseek(fp,header_end+nbytes_all);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   wait until the background thread has written the previous snapshot
+   report errors from the thread, only the filewriter procs have a thread
+------------------------------------------------------------------------- */
+
+void Dump::async_wait()
+{
+  if (async_thread == nullptr) return;
+
+  async_thread->join();
+  delete async_thread;
+  async_thread = nullptr;
+
+  if (async_error == 1)
+    error->one(FLERR,"Error writing dump {}: {}", id, utils::getsyserror());
+  if (async_error == 2)
+    error->one(FLERR,"Too much buffered per-proc info for dump {}", id);
+}
+
 /* ----------------------------------------------------------------------
    generic opening of a dump file
    ASCII or binary or compressed
@@ -581,6 +788,10 @@ void Dump::openfile()
     }
   }
 
+  // all procs need the file name for MPI-IO output
+
+  mpiio_file = filecurrent;
+
   // each proc with filewriter = 1 opens a file
 
   if (filewriter) {
@@ -1049,6 +1260,8 @@ void Dump::modify_params(int narg, char **arg)
 {
   if (narg == 0) utils::missing_cmd_args(FLERR, "dump_modify", error);
 
+  async_wait();
+
   int iarg = 0;
   while (iarg < narg) {
     if (strcmp(arg[iarg],"append") == 0) {
@@ -1062,6 +1275,13 @@ void Dump::modify_params(int narg, char **arg)
         balance_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify async", error);
+      async_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (async_flag && async_allow == 0)
+        error->all(FLERR,"Dump_modify async yes not allowed for this style");
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"buffer") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify buffer", error);
       buffer_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
@@ -1265,6 +1485,16 @@ void Dump::modify_params(int narg, char **arg)
       *ptr = '%';
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"mpiio") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify mpiio", error);
+      mpiio_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (mpiio_flag && mpiio_allow == 0)
+        error->all(FLERR,"Dump_modify mpiio yes not allowed for this style");
+#if defined(MPI_STUBS)
+      if (mpiio_flag) error->all(FLERR,"Dump_modify mpiio yes requires LAMMPS compiled with MPI");
+#endif
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"pad") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify pad", error);
       padflag = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
@@ -1353,6 +1583,7 @@ double Dump::memory_usage()
 {
   double bytes = memory->usage(buf,maxbuf);
   bytes += memory->usage(sbuf,maxsbuf);
+  bytes += (double)maxabuf * sizeof(double);
   if (sort_flag) {
     if (sortcol == 0) bytes += memory->usage(ids,maxids);
     bytes += memory->usage(bufsort,size_one*maxsort);
@@ -17,6 +17,7 @@
 #include "pointers.h"    // IWYU pragma: export
 
 #include <map>
+#include <thread>
 
 namespace LAMMPS_NS {
 class Compute;
@@ -53,6 +54,7 @@ class Dump : protected Pointers {
 
   void modify_params(int, char **);
   virtual double memory_usage();
+  void async_wait();
 
  protected:
   int me, nprocs;    // proc info
@@ -74,6 +76,10 @@ class Dump : protected Pointers {
   int append_flag;          // 1 if open file in append mode, 0 if not
   int buffer_allow;         // 1 if style allows for buffer_flag, 0 if not
   int buffer_flag;          // 1 if buffer output as one big string, 0 if not
+  int async_allow;          // 1 if style allows for async_flag, 0 if not
+  int async_flag;           // 1 if file is written by a background thread, 0 if not
+  int mpiio_allow;          // 1 if style allows for mpiio_flag, 0 if not
+  int mpiio_flag;           // 1 if all procs write to the file via MPI-IO, 0 if not
   int padflag;              // timestep padding in filename
   int pbcflag;              // 1 if remap dumped atoms via PBC, 0 if not
   int singlefile_opened;    // 1 = one big file, already opened, else 0
@@ -137,6 +143,15 @@ class Dump : protected Pointers {
   int maxsbuf;    // size of sbuf
   char *sbuf;     // memory for atom quantities in string format
 
+  bigint maxabuf;                  // size of abuf
+  double *abuf;                    // gathered snapshot written by async_thread
+  std::vector<int> async_lines;    // # of lines from each proc in abuf
+  std::thread *async_thread;       // background thread writing the last snapshot
+  int async_error;                 // set by async_thread if writing failed
+  int sbuf_line;                   // max # of chars per line from convert_string()
+
+  std::string mpiio_file;    // name of currently open file for MPI-IO output
+
   int maxids;     // size of ids
   int maxsort;    // size of bufsort, idsort, index
   int maxproc;    // size of proclist
@@ -162,6 +177,8 @@ class Dump : protected Pointers {
   virtual void write_footer() {}
 
   void pbc_allocate();
+  void write_async();
+  void write_mpiio();
   double compute_time();
 
   void sort();
@@ -20,6 +20,8 @@
 #include "memory.h"
 #include "update.h"
 
+#include "fmt/compile.h"
+
 #include <cstring>
 
 using namespace LAMMPS_NS;
@@ -39,6 +41,9 @@ DumpAtom::DumpAtom(LAMMPS *lmp, int narg, char **arg) :
   triclinic_general = 0;
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
+  sbuf_line = ONELINE;
+  mpiio_allow = 1;
   format_default = nullptr;
   key2col = { { "id", 0 }, { "type", 1 }, { "x", 2 }, { "y", 3 },
               { "z", 4 }, { "ix", 5 }, { "iy", 6 }, { "iz", 7 } };
@@ -661,6 +666,7 @@ void DumpAtom::pack_noscale_noimage_triclinic_general(tagint *ids)
 /* ----------------------------------------------------------------------
    convert mybuf of doubles to one big formatted string in sbuf
    return -1 if strlen exceeds an int, since used as arg in MPI calls in Dump
+   default format is converted with fmt, which gives the same output as printf()
 ------------------------------------------------------------------------- */
 
 int DumpAtom::convert_image(int n, double *mybuf)
@@ -674,13 +680,22 @@ int DumpAtom::convert_image(int n, double *mybuf)
       memory->grow(sbuf,maxsbuf,"dump:sbuf");
     }
 
-    offset += sprintf(&sbuf[offset],format,
-                      static_cast<tagint> (mybuf[m]),
-                      static_cast<int> (mybuf[m+1]),
-                      mybuf[m+2],mybuf[m+3],mybuf[m+4],
-                      static_cast<int> (mybuf[m+5]),
-                      static_cast<int> (mybuf[m+6]),
-                      static_cast<int> (mybuf[m+7]));
+    if (format_line_user)
+      offset += sprintf(&sbuf[offset],format,
+                        static_cast<tagint> (mybuf[m]),
+                        static_cast<int> (mybuf[m+1]),
+                        mybuf[m+2],mybuf[m+3],mybuf[m+4],
+                        static_cast<int> (mybuf[m+5]),
+                        static_cast<int> (mybuf[m+6]),
+                        static_cast<int> (mybuf[m+7]));
+    else
+      offset = fmt::format_to(&sbuf[offset],FMT_COMPILE("{} {} {:g} {:g} {:g} {} {} {}\n"),
+                              static_cast<tagint> (mybuf[m]),
+                              static_cast<int> (mybuf[m+1]),
+                              mybuf[m+2],mybuf[m+3],mybuf[m+4],
+                              static_cast<int> (mybuf[m+5]),
+                              static_cast<int> (mybuf[m+6]),
+                              static_cast<int> (mybuf[m+7])) - sbuf;
     m += size_one;
   }
 
@@ -700,10 +715,16 @@ int DumpAtom::convert_noimage(int n, double *mybuf)
       memory->grow(sbuf,maxsbuf,"dump:sbuf");
     }
 
-    offset += sprintf(&sbuf[offset],format,
-                      static_cast<tagint> (mybuf[m]),
-                      static_cast<int> (mybuf[m+1]),
-                      mybuf[m+2],mybuf[m+3],mybuf[m+4]);
+    if (format_line_user)
+      offset += sprintf(&sbuf[offset],format,
+                        static_cast<tagint> (mybuf[m]),
+                        static_cast<int> (mybuf[m+1]),
+                        mybuf[m+2],mybuf[m+3],mybuf[m+4]);
+    else
+      offset = fmt::format_to(&sbuf[offset],FMT_COMPILE("{} {} {:g} {:g} {:g}\n"),
+                              static_cast<tagint> (mybuf[m]),
+                              static_cast<int> (mybuf[m+1]),
+                              mybuf[m+2],mybuf[m+3],mybuf[m+4]) - sbuf;
     m += size_one;
   }
 
@@ -731,12 +752,22 @@ void DumpAtom::write_string(int n, double *mybuf)
 
 void DumpAtom::write_lines_image(int n, double *mybuf)
 {
+  char line[ONELINE];
+
   int m = 0;
   for (int i = 0; i < n; i++) {
-    fprintf(fp,format,
-            static_cast<tagint> (mybuf[m]), static_cast<int> (mybuf[m+1]),
-            mybuf[m+2],mybuf[m+3],mybuf[m+4], static_cast<int> (mybuf[m+5]),
-            static_cast<int> (mybuf[m+6]), static_cast<int> (mybuf[m+7]));
+    if (format_line_user)
+      fprintf(fp,format,
+              static_cast<tagint> (mybuf[m]), static_cast<int> (mybuf[m+1]),
+              mybuf[m+2],mybuf[m+3],mybuf[m+4], static_cast<int> (mybuf[m+5]),
+              static_cast<int> (mybuf[m+6]), static_cast<int> (mybuf[m+7]));
+    else {
+      char *end = fmt::format_to(line,FMT_COMPILE("{} {} {:g} {:g} {:g} {} {} {}\n"),
+                                 static_cast<tagint> (mybuf[m]), static_cast<int> (mybuf[m+1]),
+                                 mybuf[m+2],mybuf[m+3],mybuf[m+4], static_cast<int> (mybuf[m+5]),
+                                 static_cast<int> (mybuf[m+6]), static_cast<int> (mybuf[m+7]));
+      fwrite(line,sizeof(char),end-line,fp);
+    }
     m += size_one;
   }
 }
@@ -745,11 +776,20 @@ void DumpAtom::write_lines_image(int n, double *mybuf)
 
 void DumpAtom::write_lines_noimage(int n, double *mybuf)
 {
+  char line[ONELINE];
+
   int m = 0;
   for (int i = 0; i < n; i++) {
-    fprintf(fp,format,
-            static_cast<tagint> (mybuf[m]), static_cast<int> (mybuf[m+1]),
-            mybuf[m+2],mybuf[m+3],mybuf[m+4]);
+    if (format_line_user)
+      fprintf(fp,format,
+              static_cast<tagint> (mybuf[m]), static_cast<int> (mybuf[m+1]),
+              mybuf[m+2],mybuf[m+3],mybuf[m+4]);
+    else {
+      char *end = fmt::format_to(line,FMT_COMPILE("{} {} {:g} {:g} {:g}\n"),
+                                 static_cast<tagint> (mybuf[m]), static_cast<int> (mybuf[m+1]),
+                                 mybuf[m+2],mybuf[m+3],mybuf[m+4]);
+      fwrite(line,sizeof(char),end-line,fp);
+    }
     m += size_one;
   }
 }
@@ -26,9 +26,12 @@
 #include "memory.h"
 #include "modify.h"
 #include "region.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
+#include "fmt/compile.h"
+
 #include <cstring>
 
 using namespace LAMMPS_NS;
@@ -50,13 +53,17 @@ enum{LT,LE,GT,GE,EQ,NEQ,XOR};
 static constexpr int ONEFIELD = 32;
 static constexpr int DELTA = 1048576;
 
+// formatter for output of each column: printf() with vformat or fmt for default formats
+
+enum { VFORMAT, FASTINT, FASTBIGINT, FASTDOUBLE };
+
 /* ---------------------------------------------------------------------- */
 
 DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
     Dump(lmp, narg, arg), idregion(nullptr), thresh_array(nullptr), thresh_op(nullptr),
     thresh_value(nullptr), thresh_last(nullptr), thresh_fix(nullptr), thresh_fixID(nullptr),
-    thresh_first(nullptr), earg(nullptr), vtype(nullptr), vformat(nullptr), columns(nullptr),
-    columns_default(nullptr), choose(nullptr), dchoose(nullptr), clist(nullptr),
+    thresh_first(nullptr), earg(nullptr), vtype(nullptr), vformat(nullptr), vfast(nullptr),
+    columns(nullptr), columns_default(nullptr), choose(nullptr), dchoose(nullptr), clist(nullptr),
     field2index(nullptr), argindex(nullptr), id_compute(nullptr), compute(nullptr), id_fix(nullptr),
     fix(nullptr), id_variable(nullptr), variable(nullptr), vbuf(nullptr), id_custom(nullptr),
     custom(nullptr), custom_flag(nullptr), typenames(nullptr), header_choice(nullptr),
@@ -87,6 +94,9 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
+  sbuf_line = nfield*ONEFIELD;
+  mpiio_allow = 1;
 
   triclinic_general = 0;
   nthresh = 0;
@@ -133,6 +143,7 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
   // setup format strings
 
   vformat = new char*[nfield];
+  vfast = new int[nfield];
   std::string cols;
 
   cols.clear();
@@ -224,6 +235,7 @@ DumpCustom::~DumpCustom()
     for (int i = 0; i < nfield; i++) delete[] vformat[i];
     delete[] vformat;
   }
+  delete[] vfast;
 
   if (format_column_user) {
     for (int i = 0; i < nfield; i++) delete[] format_column_user[i];
@@ -284,6 +296,15 @@ void DumpCustom::init_style()
     // remove trailing blank on last column's format
     if (i == nfield-1) vformat[i][strlen(vformat[i])-1] = '\0';
 
+    // use fast formatter if format is the default for the type of the column
+    // fmt produces the same output as printf() for these formats
+
+    std::string fmtstr = utils::trim(vformat[i]);
+    vfast[i] = VFORMAT;
+    if (vtype[i] == Dump::INT && fmtstr == "%d") vfast[i] = FASTINT;
+    else if (vtype[i] == Dump::BIGINT && fmtstr == BIGINT_FORMAT) vfast[i] = FASTBIGINT;
+    else if (vtype[i] == Dump::DOUBLE && fmtstr == "%g") vfast[i] = FASTDOUBLE;
+
     ++i;
   }
 
@@ -621,6 +642,7 @@ int DumpCustom::count()
         error->all(FLERR,"Dump compute ID {} cannot be invoked before initialization by a run",
           compute[i]->id);
       if (!(compute[i]->invoked_flag & Compute::INVOKED_PERATOM)) {
+        Timer::Instance timing(timer, compute[i]);
         compute[i]->compute_peratom();
         compute[i]->invoked_flag |= Compute::INVOKED_PERATOM;
       }
@@ -1229,7 +1251,9 @@ int DumpCustom::convert_string(int n, double *mybuf)
     }
 
     for (j = 0; j < nfield; j++) {
-      if (vtype[j] == Dump::INT)
+      if (vfast[j] != VFORMAT)
+        offset += convert_fast(&sbuf[offset],j,mybuf[m]);
+      else if (vtype[j] == Dump::INT)
         offset += sprintf(&sbuf[offset],vformat[j],static_cast<int> (mybuf[m]));
       else if (vtype[j] == Dump::DOUBLE)
         offset += sprintf(&sbuf[offset],vformat[j],mybuf[m]);
@@ -1246,6 +1270,25 @@ int DumpCustom::convert_string(int n, double *mybuf)
   return offset;
 }
 
+/* ----------------------------------------------------------------------
+   convert value of column j with fast formatter to string at str
+   append blank except for last column, string is not null-terminated
+   return # of chars written, which is at most ONEFIELD
+------------------------------------------------------------------------- */
+
+int DumpCustom::convert_fast(char *str, int j, double value)
+{
+  char *ptr = str;
+  if (vfast[j] == FASTINT)
+    ptr = fmt::format_to(ptr,FMT_COMPILE("{}"),static_cast<int> (value));
+  else if (vfast[j] == FASTBIGINT)
+    ptr = fmt::format_to(ptr,FMT_COMPILE("{}"),static_cast<bigint> (value));
+  else if (vfast[j] == FASTDOUBLE)
+    ptr = fmt::format_to(ptr,FMT_COMPILE("{:g}"),value);
+  if (j < nfield-1) *ptr++ = ' ';
+  return ptr - str;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void DumpCustom::write_data(int n, double *mybuf)
@@ -1275,11 +1318,13 @@ void DumpCustom::write_string(int n, double *mybuf)
 void DumpCustom::write_lines(int n, double *mybuf)
 {
   int i,j;
+  char str[ONEFIELD];
 
   int m = 0;
   for (i = 0; i < n; i++) {
     for (j = 0; j < nfield; j++) {
-      if (vtype[j] == Dump::INT) fprintf(fp,vformat[j],static_cast<int> (mybuf[m]));
+      if (vfast[j] != VFORMAT) fwrite(str,sizeof(char),convert_fast(str,j,mybuf[m]),fp);
+      else if (vtype[j] == Dump::INT) fprintf(fp,vformat[j],static_cast<int> (mybuf[m]));
       else if (vtype[j] == Dump::DOUBLE) fprintf(fp,vformat[j],mybuf[m]);
       else if (vtype[j] == Dump::STRING)
         fprintf(fp,vformat[j],typenames[(int) mybuf[m]]);
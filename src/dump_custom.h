@@ -58,6 +58,7 @@ class DumpCustom : public Dump {
                      //
   int *vtype;        // type of each vector (INT, DOUBLE)
   char **vformat;    // format string for each vector element
+  int *vfast;        // fast formatter for each vector element, VFORMAT if none
                      //
   char *columns;     // column labels
   char *columns_default;
@@ -103,6 +104,7 @@ class DumpCustom : public Dump {
   int count() override;
   void pack(tagint *) override;
   int convert_string(int, double *) override;
+  int convert_fast(char *, int, double);
   void write_data(int, double *) override;
   double memory_usage() override;
 
@@ -23,6 +23,7 @@
 #include "grid3d.h"
 #include "memory.h"
 #include "modify.h"
+#include "timer.h"
 #include "update.h"
 
 #include <cstring>
@@ -73,6 +74,8 @@ DumpGrid::DumpGrid(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
+  sbuf_line = nfield*ONEFIELD;
 
   dimension = domain->dimension;
 
@@ -531,6 +534,7 @@ int DumpGrid::count()
         error->all(FLERR,"Dump compute ID {} cannot be invoked before initialization by a run",
           compute[i]->id);
       if (!(compute[i]->invoked_flag & Compute::INVOKED_PERGRID)) {
+        Timer::Instance timing(timer, compute[i]);
         compute[i]->compute_pergrid();
         compute[i]->invoked_flag |= Compute::INVOKED_PERGRID;
       }
@@ -38,6 +38,7 @@
 #include "molecule.h"
 #include "output.h"
 #include "thermo.h"
+#include "timer.h"
 #include "tokenizer.h"
 #include "update.h"
 #include "variable.h"
@@ -66,6 +67,9 @@ DumpImage::DumpImage(LAMMPS *lmp, int narg, char **arg) :
   avec_line(nullptr), avec_tri(nullptr), avec_body(nullptr), fixptr(nullptr), image(nullptr),
   chooseghost(nullptr), bufcopy(nullptr)
 {
+  async_allow = 0;
+  mpiio_allow = 0;
+
   if (binary || multiproc) error->all(FLERR,"Invalid dump image filename");
 
   // force binary flag on to avoid corrupted output on Windows
@@ -693,6 +697,7 @@ void DumpImage::write()
         error->all(FLERR,"Grid compute ID {} used in dump image cannot be invoked "
                    "before initialization by a run", grid_compute->id);
       if (!(grid_compute->invoked_flag & Compute::INVOKED_PERGRID)) {
+        Timer::Instance timing(timer, grid_compute);
         grid_compute->compute_pergrid();
         grid_compute->invoked_flag |= Compute::INVOKED_PERGRID;
       }
@@ -21,6 +21,7 @@
 #include "fix.h"
 #include "memory.h"
 #include "modify.h"
+#include "timer.h"
 #include "update.h"
 
 #include <cstring>
@@ -65,6 +66,8 @@ DumpLocal::DumpLocal(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
+  sbuf_line = nfield*ONEFIELD;
 
   // computes & fixes which the dump accesses
 
@@ -333,6 +336,7 @@ int DumpLocal::count()
         error->all(FLERR,"Dump compute ID {} cannot be invoked before initialization by a run",
           compute[i]->id);
       if (!(compute[i]->invoked_flag & Compute::INVOKED_LOCAL)) {
+        Timer::Instance timing(timer, compute[i]);
         compute[i]->compute_local();
         compute[i]->invoked_flag |= Compute::INVOKED_LOCAL;
       }
@@ -18,11 +18,14 @@
 #include "atom.h"
 #include "atom_vec.h"
 #include "comm.h"
+#include "compute.h"
 #include "error.h"
+#include "fix.h"
 #include "force.h"
 #include "kspace.h"
 #include "memory.h"             // IWYU pragma: keep
 #include "min.h"
+#include "modify.h"
 #include "molecule.h"
 #include "neighbor.h"           // IWYU pragma: keep
 #include "output.h"
@@ -32,23 +35,31 @@
 #include "universe.h"
 #include "update.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
 #ifdef LMP_OPENMP
-#include "modify.h"
 #include "fix_omp.h"
 #include "thr_data.h"
 #endif
 
 using namespace LAMMPS_NS;
 
+static constexpr int MAXMEMSHOW = 10;    // max number of subsystems listed individually
+static constexpr double BIG = 1.0e20;
+
 // local function prototypes, code at end of file
 
 static void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
                         MPI_Comm world, const int nprocs, const int nthreads,
                         const int me, double time_loop, FILE *scr, FILE *log);
 
+static void instance_timings(Modify *modify, MPI_Comm world, const int nprocs,
+                             const int me, double time_loop, FILE *scr, FILE *log);
+
+static void counter_timings(Timer *t, MPI_Comm world, const int me, FILE *scr, FILE *log);
+
 #ifdef LMP_OPENMP
 static void omp_times(FixOMP *fix, const char *label, enum Timer::ttype which,
                       const int nthreads,FILE *scr, FILE *log);
@@ -65,7 +76,7 @@ void Finish::end(int flag)
   int i,nneigh,nneighfull;
   int histo[10];
   int minflag,prdflag,tadflag,hyperflag;
-  int timeflag,fftflag,histoflag,neighflag;
+  int timeflag,fftflag,histoflag,neighflag,memflag;
   double time,tmp,ave,max,min;
   double time_loop,time_other,cpu_loop;
 
@@ -73,8 +84,16 @@ void Finish::end(int flag)
   MPI_Comm_rank(world,&me);
   MPI_Comm_size(world,&nprocs);
 
+  // dump snapshots of this run must be complete when the run ends
+
+  output->async_wait();
+
   const int nthreads = comm->nthreads;
 
+  // write trace file, if enabled with the timer command
+
+  timer->write_trace();
+
   // recompute natoms in case atoms have been lost
 
   bigint nblocal = atom->nlocal;
@@ -90,22 +109,22 @@ void Finish::end(int flag)
   // turn off neighflag for Kspace partition of verlet/split integrator
 
   minflag = prdflag = tadflag = hyperflag = 0;
-  timeflag = fftflag = histoflag = neighflag = 0;
+  timeflag = fftflag = histoflag = neighflag = memflag = 0;
   time_loop = cpu_loop = time_other = 0.0;
 
   if (flag == 1) {
     if (update->whichflag == 2) minflag = 1;
     timeflag = histoflag = 1;
-    neighflag = 1;
+    neighflag = memflag = 1;
     if (update->whichflag == 1 &&
         strncmp(update->integrate_style,"verlet/split",12) == 0 &&
         universe->iworld == 1) neighflag = 0;
     if (force->kspace && force->kspace_match("^pppm",0)
         && force->kspace->fftbench) fftflag = 1;
   }
-  if (flag == 2) prdflag = timeflag = histoflag = neighflag = 1;
-  if (flag == 3) tadflag = histoflag = neighflag = 1;
-  if (flag == 4) hyperflag = timeflag = histoflag = neighflag = 1;
+  if (flag == 2) prdflag = timeflag = histoflag = neighflag = memflag = 1;
+  if (flag == 3) tadflag = histoflag = neighflag = memflag = 1;
+  if (flag == 4) hyperflag = timeflag = histoflag = neighflag = memflag = 1;
 
   // loop stats
 
@@ -354,6 +373,12 @@ void Finish::end(int flag)
         utils::logmesg(lmp,"Other   |            | {:<10.4g} |            |  "
                        "     |{:6.2f}\n",time,time/time_loop*100.0);
     }
+
+    if (timer->has_instance())
+      instance_timings(modify,world,nprocs,me,time_loop,screen,logfile);
+
+    if (timer->has_counters())
+      counter_timings(timer,world,me,screen,logfile);
   }
 
 #ifdef LMP_OPENMP
@@ -545,6 +570,73 @@ void Finish::end(int flag)
     }
   }
 
+  // memory allocated via Memory class per subsystem, if tracked
+  // build the sorted union of subsystem names across MPI ranks,
+  // so that all ranks can contribute to a single reduction
+
+  if (memflag && memory->is_tracking()) {
+    const auto usage = memory->get_usage(true);
+    std::string names;
+    for (const auto &u : usage) names += u.name + "\n";
+
+    int len = names.size();
+    std::vector<int> lens(nprocs), offsets(nprocs);
+    MPI_Allgather(&len,1,MPI_INT,lens.data(),1,MPI_INT,world);
+    int ntotal = 0;
+    for (i = 0; i < nprocs; i++) {
+      offsets[i] = ntotal;
+      ntotal += lens[i];
+    }
+    std::vector<char> allnames(ntotal+1,'\0');
+    MPI_Allgatherv(&names[0],len,MPI_CHAR,allnames.data(),lens.data(),offsets.data(),
+                   MPI_CHAR,world);
+
+    auto subsystems = utils::split_lines(allnames.data());
+    std::sort(subsystems.begin(),subsystems.end());
+    subsystems.erase(std::unique(subsystems.begin(),subsystems.end()),subsystems.end());
+
+    // last entry is the total
+
+    const int nsub = subsystems.size();
+    std::vector<double> bytes(2*(nsub+1),0.0), bytesmax(2*(nsub+1),0.0);
+    for (const auto &u : usage) {
+      auto idx = std::lower_bound(subsystems.begin(),subsystems.end(),u.name) - subsystems.begin();
+      bytes[2*idx] = u.live;
+      bytes[2*idx+1] = u.peak;
+    }
+    bytes[2*nsub] = memory->get_live();
+    bytes[2*nsub+1] = memory->get_peak();
+    MPI_Reduce(bytes.data(),bytesmax.data(),2*(nsub+1),MPI_DOUBLE,MPI_MAX,0,world);
+
+    if (me == 0) {
+      const double mbyte = 1.0/1024.0/1024.0;
+      std::vector<int> order(nsub);
+      for (i = 0; i < nsub; i++) order[i] = i;
+      std::sort(order.begin(),order.end(),[&bytesmax](int a, int b)
+                { return bytesmax[2*a+1] > bytesmax[2*b+1]; });
+
+      std::string mesg = "\nMemory usage per subsystem in Mbytes (max across MPI ranks):\n"
+        "Subsystem            |    Current    |     Peak\n"
+        "-----------------------------------------------------\n";
+      const int nshow = MIN(nsub,MAXMEMSHOW);
+      for (i = 0; i < nshow; i++)
+        mesg += fmt::format("{:<20} | {:>13.4f} | {:>13.4f}\n",subsystems[order[i]],
+                            bytesmax[2*order[i]]*mbyte,bytesmax[2*order[i]+1]*mbyte);
+      if (nsub > nshow) {
+        double live = 0.0, peak = 0.0;
+        for (i = nshow; i < nsub; i++) {
+          live += bytesmax[2*order[i]];
+          peak += bytesmax[2*order[i]+1];
+        }
+        mesg += fmt::format("{:<20} | {:>13.4f} | {:>13.4f}\n",
+                            fmt::format("({} others)",nsub-nshow),live*mbyte,peak*mbyte);
+      }
+      mesg += fmt::format("{:<20} | {:>13.4f} | {:>13.4f}\n","Total",bytesmax[2*nsub]*mbyte,
+                          bytesmax[2*nsub+1]*mbyte);
+      utils::logmesg(lmp,mesg);
+    }
+  }
+
   if (logfile) fflush(logfile);
 }
 
@@ -641,6 +733,119 @@ void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
   }
 }
 
+/* ----------------------------------------------------------------------
+   print wall time spent in individual fixes and computes
+   sorted by average time, instances that were never called are skipped
+------------------------------------------------------------------------- */
+
+void instance_timings(Modify *modify, MPI_Comm world, const int nprocs,
+                      const int me, double time_loop, FILE *scr, FILE *log)
+{
+  // the list of fixes and computes is the same on all MPI ranks
+
+  std::vector<std::string> labels;
+  std::vector<double> times;
+  for (const auto &ifix : modify->get_fix_list()) {
+    labels.push_back(fmt::format("fix {} ({})",ifix->id,ifix->style));
+    times.push_back(ifix->walltime);
+  }
+  for (const auto &icompute : modify->get_compute_list()) {
+    labels.push_back(fmt::format("compute {} ({})",icompute->id,icompute->style));
+    times.push_back(icompute->walltime);
+  }
+
+  const int n = times.size();
+  if (n == 0) return;
+
+  std::vector<double> time_sq(n), time_min(n), time_max(n), time_avg(n), time_var(n);
+  for (int i = 0; i < n; ++i) time_sq[i] = times[i]*times[i];
+  MPI_Allreduce(times.data(),time_min.data(),n,MPI_DOUBLE,MPI_MIN,world);
+  MPI_Allreduce(times.data(),time_max.data(),n,MPI_DOUBLE,MPI_MAX,world);
+  MPI_Allreduce(times.data(),time_avg.data(),n,MPI_DOUBLE,MPI_SUM,world);
+  MPI_Allreduce(time_sq.data(),time_var.data(),n,MPI_DOUBLE,MPI_SUM,world);
+  if (me != 0) return;
+
+  std::vector<int> order;
+  std::size_t width = 8;
+  for (int i = 0; i < n; ++i) {
+    time_avg[i] /= nprocs;
+    time_var[i] /= nprocs;
+
+    // % variance from the average as measure of load imbalance
+    if ((time_avg[i] > 0.001) && ((time_var[i]/time_avg[i] - time_avg[i]) > 1.0e-10))
+      time_var[i] = sqrt(time_var[i]/time_avg[i] - time_avg[i])*100.0;
+    else
+      time_var[i] = 0.0;
+
+    if (time_max[i] > 0.0) {
+      order.push_back(i);
+      width = MAX(width,labels[i].size());
+    }
+  }
+  std::stable_sort(order.begin(),order.end(),
+                   [&](int a, int b) { return time_avg[a] > time_avg[b]; });
+
+  std::string mesg = fmt::format("\nFix and compute timing breakdown:\n{:<{}s} |  min time  "
+                                 "|  avg time  |  max time  |%varavg| %total\n{:-<{}s}\n",
+                                 "Instance",width,"",width+55);
+  for (const auto &i : order)
+    mesg += fmt::format("{:<{}s} | {:<10.5g} | {:<10.5g} | {:<10.5g} |{:6.1f} |{:6.2f}\n",
+                        labels[i],width,time_min[i],time_avg[i],time_max[i],time_var[i],
+                        time_avg[i]/time_loop*100.0);
+  if (scr) fputs(mesg.c_str(),scr);
+  if (log) fputs(mesg.c_str(),log);
+}
+
+/* ----------------------------------------------------------------------
+   print instructions per cycle and last level cache misses per timer section
+   IPC is given as min, avg, and max over MPI ranks with cycles counted,
+   ranks without counters or without work in a section are left out,
+   cache miss rate and misses per 1000 instructions for the sum over MPI ranks
+   sections without counts, e.g. Kspace without a kspace style, are skipped
+------------------------------------------------------------------------- */
+
+void counter_timings(Timer *t, MPI_Comm world, const int me, FILE *scr, FILE *log)
+{
+  const Timer::ttype sections[] = {Timer::PAIR, Timer::BOND, Timer::KSPACE, Timer::NEIGH,
+                                   Timer::COMM, Timer::OUTPUT, Timer::MODIFY, Timer::SYNC};
+  const char *labels[] = {"Pair", "Bond", "Kspace", "Neigh", "Comm", "Output", "Modify", "Sync"};
+  constexpr int n = sizeof(labels)/sizeof(const char *);
+
+  double counts[n][Timer::NUM_COUNTER], sums[n][Timer::NUM_COUNTER];
+  double ipc_lo[n], ipc_hi[n], ipc_min[n], ipc_max[n];
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < Timer::NUM_COUNTER; ++j) counts[i][j] = t->get_counter(sections[i],j);
+    ipc_lo[i] = BIG;
+    ipc_hi[i] = 0.0;
+    if (counts[i][Timer::CYCLES] > 0.0)
+      ipc_lo[i] = ipc_hi[i] = counts[i][Timer::INSTRUCTIONS]/counts[i][Timer::CYCLES];
+  }
+
+  // the avg IPC is the ratio of the sums, to which ranks without cycles add nothing
+
+  MPI_Allreduce(&counts[0][0],&sums[0][0],n*Timer::NUM_COUNTER,MPI_DOUBLE,MPI_SUM,world);
+  MPI_Allreduce(ipc_lo,ipc_min,n,MPI_DOUBLE,MPI_MIN,world);
+  MPI_Allreduce(ipc_hi,ipc_max,n,MPI_DOUBLE,MPI_MAX,world);
+  if (me != 0) return;
+
+  std::string mesg = "\nHardware counter breakdown:\nSection |  min IPC |  avg IPC |  max IPC "
+    "| LLC miss% | LLC MPKI | Gcycles\n---------------------------------------------------"
+    "-------------------------\n";
+  for (int i = 0; i < n; ++i) {
+    const double *sum = sums[i];
+    if (!(sum[Timer::CYCLES] > 0.0)) continue;
+    const double miss = (sum[Timer::CACHEREFS] > 0.0)
+      ? sum[Timer::CACHEMISSES]/sum[Timer::CACHEREFS]*100.0 : 0.0;
+    const double mpki = (sum[Timer::INSTRUCTIONS] > 0.0)
+      ? sum[Timer::CACHEMISSES]/sum[Timer::INSTRUCTIONS]*1000.0 : 0.0;
+    mesg += fmt::format("{:<8s}| {:8.3f} | {:8.3f} | {:8.3f} | {:9.2f} | {:8.3f} | {:<10.4g}\n",
+                        labels[i],ipc_min[i],sum[Timer::INSTRUCTIONS]/sum[Timer::CYCLES],
+                        ipc_max[i],miss,mpki,sum[Timer::CYCLES]*1.0e-9);
+  }
+  if (scr) fputs(mesg.c_str(),scr);
+  if (log) fputs(mesg.c_str(),log);
+}
+
 /* ---------------------------------------------------------------------- */
 
 #ifdef LMP_OPENMP
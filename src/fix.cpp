@@ -79,6 +79,8 @@ Fix::Fix(LAMMPS *lmp, int /*narg*/, char **arg) :
   pre_exchange_migrate = 0;
   stores_ids = 0;
   diam_flag = 0;
+  walltime = 0.0;
+  trace_slot = -1;
 
   scalar_flag = vector_flag = array_flag = 0;
   extscalar = extvector = extarray = -1;
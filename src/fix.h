@@ -80,6 +80,9 @@ class Fix : protected Pointers {
   int stores_ids;              // 1 if fix stores atom IDs
   int diam_flag;               // 1 if fix may change partical diameter
 
+  double walltime;    // wall time spent in this fix, if enabled by timer command
+  int trace_slot;     // index of this fix in trace of timer command, -1 if not traced yet
+
   int scalar_flag;                 // 0/1 if compute_scalar() function exists
   int vector_flag;                 // 0/1 if compute_vector() function exists
   int array_flag;                  // 0/1 if compute_array() function exists
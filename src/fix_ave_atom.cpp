@@ -21,6 +21,7 @@
 #include "input.h"
 #include "memory.h"
 #include "modify.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -294,6 +295,7 @@ void FixAveAtom::end_of_step()
 
     } else if (val.which == ArgInfo::COMPUTE) {
       if (!(val.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
+        Timer::Instance timing(timer, val.val.c);
         val.val.c->compute_peratom();
         val.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
       }
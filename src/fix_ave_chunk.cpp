@@ -25,6 +25,8 @@
 #include "input.h"
 #include "memory.h"
 #include "modify.h"
+#include "output.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -670,6 +672,7 @@ void FixAveChunk::end_of_step()
 
     } else if (val.which == ArgInfo::COMPUTE) {
       if (!(val.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
+        Timer::Instance timing(timer, val.val.c);
         val.val.c->compute_peratom();
         val.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
       }
@@ -897,7 +900,7 @@ void FixAveChunk::end_of_step()
 
   // output result to file
 
-  if (fp && comm->me == 0) {
+  if (fp && output->fix_file_flag && comm->me == 0) {
     clearerr(fp);
     if (overwrite) platform::fseek(fp,filepos);
     double count = 0.0;
@@ -27,6 +27,8 @@
 #include "input.h"
 #include "memory.h"
 #include "modify.h"
+#include "output.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -393,12 +395,14 @@ void FixAveCorrelate::end_of_step()
 
       if (val.argindex == 0) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_SCALAR)) {
+          Timer::Instance timing(timer, val.val.c);
           val.val.c->compute_scalar();
           val.val.c->invoked_flag |= Compute::INVOKED_SCALAR;
         }
         scalar = val.val.c->scalar;
       } else {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
+          Timer::Instance timing(timer, val.val.c);
           val.val.c->compute_vector();
           val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
@@ -463,7 +467,7 @@ void FixAveCorrelate::end_of_step()
 
   // output result to file
 
-  if (fp && comm->me == 0) {
+  if (fp && output->fix_file_flag && comm->me == 0) {
     clearerr(fp);
     if (overwrite) platform::fseek(fp,filepos);
     fmt::print(fp,"{} {}\n",ntimestep,nrepeat);
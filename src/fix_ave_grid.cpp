@@ -26,6 +26,7 @@
 #include "memory.h"
 #include "modify.h"
 #include "neighbor.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -967,6 +968,7 @@ void FixAveGrid::atom2grid()
       if (which[m] == ArgInfo::COMPUTE) {
         Compute *compute = modify->get_compute_by_index(n);
         if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
+          Timer::Instance timing(timer, compute);
           compute->compute_peratom();
           compute->invoked_flag |= Compute::INVOKED_PERATOM;
         }
@@ -1076,6 +1078,7 @@ void FixAveGrid::grid2grid()
     if (which[m] == ArgInfo::COMPUTE) {
       compute = modify->get_compute_by_index(n);
       if (!(compute->invoked_flag & Compute::INVOKED_PERGRID)) {
+        Timer::Instance timing(timer, compute);
         compute->compute_pergrid();
         compute->invoked_flag |= Compute::INVOKED_PERGRID;
       }
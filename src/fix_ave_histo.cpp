@@ -22,6 +22,8 @@
 #include "input.h"
 #include "memory.h"
 #include "modify.h"
+#include "output.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -521,12 +523,14 @@ void FixAveHisto::end_of_step()
       if (kind == GLOBAL && mode == SCALAR) {
         if (j == 0) {
           if (!(val.val.c->invoked_flag & Compute::INVOKED_SCALAR)) {
+            Timer::Instance timing(timer, val.val.c);
             val.val.c->compute_scalar();
             val.val.c->invoked_flag |= Compute::INVOKED_SCALAR;
           }
           bin_one(val.val.c->scalar);
         } else {
           if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
+            Timer::Instance timing(timer, val.val.c);
             val.val.c->compute_vector();
             val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
           }
@@ -535,12 +539,14 @@ void FixAveHisto::end_of_step()
       } else if (kind == GLOBAL && mode == VECTOR) {
         if (j == 0) {
           if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
+            Timer::Instance timing(timer, val.val.c);
             val.val.c->compute_vector();
             val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
           }
           bin_vector(val.val.c->size_vector,val.val.c->vector,1);
         } else {
           if (!(val.val.c->invoked_flag & Compute::INVOKED_ARRAY)) {
+            Timer::Instance timing(timer, val.val.c);
             val.val.c->compute_array();
             val.val.c->invoked_flag |= Compute::INVOKED_ARRAY;
           }
@@ -551,6 +557,7 @@ void FixAveHisto::end_of_step()
 
       } else if (kind == PERATOM) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
+          Timer::Instance timing(timer, val.val.c);
           val.val.c->compute_peratom();
           val.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
         }
@@ -561,6 +568,7 @@ void FixAveHisto::end_of_step()
 
       } else if (kind == LOCAL) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_LOCAL)) {
+          Timer::Instance timing(timer, val.val.c);
           val.val.c->compute_local();
           val.val.c->invoked_flag |= Compute::INVOKED_LOCAL;
         }
@@ -714,7 +722,7 @@ void FixAveHisto::end_of_step()
 
   // output result to file
 
-  if (fp && comm->me == 0) {
+  if (fp && output->fix_file_flag && comm->me == 0) {
     clearerr(fp);
     if (overwrite) platform::fseek(fp,filepos);
     fmt::print(fp,"{} {} {} {} {} {}\n",ntimestep,nbins,
@@ -26,6 +26,8 @@
 #include "input.h"
 #include "memory.h"
 #include "modify.h"
+#include "output.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -137,12 +139,14 @@ void FixAveHistoWeight::end_of_step()
     if (kind == GLOBAL && mode == SCALAR) {
       if (j == 0) {
         if (!(val1.val.c->invoked_flag & Compute::INVOKED_SCALAR)) {
+          Timer::Instance timing(timer, val1.val.c);
           val1.val.c->compute_scalar();
           val1.val.c->invoked_flag |= Compute::INVOKED_SCALAR;
         }
         weight = val1.val.c->scalar;
       } else {
         if (!(val1.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
+          Timer::Instance timing(timer, val1.val.c);
           val1.val.c->compute_vector();
           val1.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
@@ -151,6 +155,7 @@ void FixAveHistoWeight::end_of_step()
     } else if (kind == GLOBAL && mode == VECTOR) {
       if (j == 0) {
         if (!(val1.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
+          Timer::Instance timing(timer, val1.val.c);
           val1.val.c->compute_vector();
           val1.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
@@ -158,6 +163,7 @@ void FixAveHistoWeight::end_of_step()
         stride = 1;
       } else {
         if (!(val1.val.c->invoked_flag & Compute::INVOKED_ARRAY)) {
+          Timer::Instance timing(timer, val1.val.c);
           val1.val.c->compute_array();
           val1.val.c->invoked_flag |= Compute::INVOKED_ARRAY;
         }
@@ -166,6 +172,7 @@ void FixAveHistoWeight::end_of_step()
       }
     } else if (kind == PERATOM) {
       if (!(val1.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
+        Timer::Instance timing(timer, val1.val.c);
         val1.val.c->compute_peratom();
         val1.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
       }
@@ -178,6 +185,7 @@ void FixAveHistoWeight::end_of_step()
       }
     } else if (kind == LOCAL) {
       if (!(val1.val.c->invoked_flag & Compute::INVOKED_LOCAL)) {
+        Timer::Instance timing(timer, val1.val.c);
         val1.val.c->compute_local();
         val1.val.c->invoked_flag |= Compute::INVOKED_LOCAL;
       }
@@ -262,12 +270,14 @@ void FixAveHistoWeight::end_of_step()
     if (kind == GLOBAL && mode == SCALAR) {
       if (j == 0) {
         if (!(val0.val.c->invoked_flag & Compute::INVOKED_SCALAR)) {
+          Timer::Instance timing(timer, val0.val.c);
           val0.val.c->compute_scalar();
           val0.val.c->invoked_flag |= Compute::INVOKED_SCALAR;
         }
         bin_one_weights(val0.val.c->scalar,weight);
       } else {
         if (!(val0.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
+          Timer::Instance timing(timer, val0.val.c);
           val0.val.c->compute_vector();
           val0.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
@@ -276,6 +286,7 @@ void FixAveHistoWeight::end_of_step()
     } else if (kind == GLOBAL && mode == VECTOR) {
       if (j == 0) {
         if (!(val0.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
+          Timer::Instance timing(timer, val0.val.c);
           val0.val.c->compute_vector();
           val0.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
@@ -283,6 +294,7 @@ void FixAveHistoWeight::end_of_step()
                            weights,stride);
       } else {
         if (!(val0.val.c->invoked_flag & Compute::INVOKED_ARRAY)) {
+          Timer::Instance timing(timer, val0.val.c);
           val0.val.c->compute_array();
           val0.val.c->invoked_flag |= Compute::INVOKED_ARRAY;
         }
@@ -293,6 +305,7 @@ void FixAveHistoWeight::end_of_step()
 
     } else if (kind == PERATOM) {
       if (!(val0.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
+        Timer::Instance timing(timer, val0.val.c);
         val0.val.c->compute_peratom();
         val0.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
       }
@@ -304,6 +317,7 @@ void FixAveHistoWeight::end_of_step()
 
     } else if (kind == LOCAL) {
       if (!(val0.val.c->invoked_flag & Compute::INVOKED_LOCAL)) {
+        Timer::Instance timing(timer, val0.val.c);
         val0.val.c->compute_local();
         val0.val.c->invoked_flag |= Compute::INVOKED_LOCAL;
       }
@@ -451,7 +465,7 @@ void FixAveHistoWeight::end_of_step()
 
   // output result to file
 
-  if (fp && comm->me == 0) {
+  if (fp && output->fix_file_flag && comm->me == 0) {
     clearerr(fp);
     if (overwrite) platform::fseek(fp,filepos);
     fmt::print(fp,"{} {} {} {} {} {}\n",ntimestep,nbins,
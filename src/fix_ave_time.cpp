@@ -25,6 +25,8 @@
 #include "input.h"
 #include "memory.h"
 #include "modify.h"
+#include "output.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -540,12 +542,14 @@ void FixAveTime::invoke_scalar(bigint ntimestep)
 
       if (val.argindex == 0) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_SCALAR)) {
+          Timer::Instance timing(timer, val.val.c);
           val.val.c->compute_scalar();
           val.val.c->invoked_flag |= Compute::INVOKED_SCALAR;
         }
         scalar = val.val.c->scalar;
       } else {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
+          Timer::Instance timing(timer, val.val.c);
           val.val.c->compute_vector();
           val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
@@ -638,7 +642,7 @@ void FixAveTime::invoke_scalar(bigint ntimestep)
 
   // output result to file
 
-  if (fp && comm->me == 0) {
+  if (fp && output->fix_file_flag && comm->me == 0) {
     clearerr(fp);
     if (overwrite) platform::fseek(fp,filepos);
     if (yaml_flag) {
@@ -729,6 +733,7 @@ void FixAveTime::invoke_vector(bigint ntimestep)
     if (val.which == ArgInfo::COMPUTE) {
       if (val.argindex == 0) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
+          Timer::Instance timing(timer, val.val.c);
           val.val.c->compute_vector();
           val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
@@ -738,6 +743,7 @@ void FixAveTime::invoke_vector(bigint ntimestep)
 
       } else {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_ARRAY)) {
+          Timer::Instance timing(timer, val.val.c);
           val.val.c->compute_array();
           val.val.c->invoked_flag |= Compute::INVOKED_ARRAY;
         }
@@ -854,7 +860,7 @@ void FixAveTime::invoke_vector(bigint ntimestep)
 
   // output result to file
 
-  if (fp && comm->me == 0) {
+  if (fp && output->fix_file_flag && comm->me == 0) {
     if (overwrite) platform::fseek(fp,filepos);
     if (yaml_flag) {
       if (!yaml_header || overwrite) {
@@ -0,0 +1,355 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_imbalance_map.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "neighbor.h"
+#include "timer.h"
+#include "update.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+// per-rank values gathered on rank 0:
+// 5 timers, 3 counts, sub-domain bounds, grid location, RCB cut
+
+static constexpr int NVAL = 19;
+static constexpr double IMBTHRESH = 1.05;    // load imbalance factor below which no action is needed
+
+/* ---------------------------------------------------------------------- */
+
+FixImbalanceMap::FixImbalanceMap(LAMMPS *lmp, int narg, char **arg) :
+    Fix(lmp, narg, arg), firststep(-1), laststep(-1), active(0), nsample(0)
+{
+  if (narg < 5) utils::missing_cmd_args(FLERR, "fix imbalance/map", error);
+
+  nevery = utils::inumeric(FLERR, arg[3], false, lmp);
+  if (nevery <= 0) error->all(FLERR, "Illegal fix imbalance/map nevery value: {}", nevery);
+  filename = arg[4];
+
+  wstart = 0;
+  wstop = MAXBIGINT;
+
+  int iarg = 5;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "start") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "fix imbalance/map start", error);
+      wstart = utils::bnumeric(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "stop") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "fix imbalance/map stop", error);
+      wstop = utils::bnumeric(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
+    } else
+      error->all(FLERR, "Unknown fix imbalance/map keyword: {}", arg[iarg]);
+  }
+  if (wstop < wstart) error->all(FLERR, "Fix imbalance/map stop must be >= start");
+
+  for (int i = 0; i < NUM_TIME; ++i) tbase[i] = tlast[i] = 0.0;
+  for (int i = 0; i < NUM_COUNT; ++i) count[i] = 0.0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixImbalanceMap::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixImbalanceMap::init()
+{
+  if (!timer->has_normal())
+    error->all(FLERR, "Fix imbalance/map requires timer level normal or full");
+}
+
+/* ----------------------------------------------------------------------
+   timers are reset after setup, so a window which includes the first
+   step of the run starts with zero time
+------------------------------------------------------------------------- */
+
+void FixImbalanceMap::setup(int /*vflag*/)
+{
+  for (int i = 0; i < NUM_TIME; ++i) tbase[i] = tlast[i] = 0.0;
+  for (int i = 0; i < NUM_COUNT; ++i) count[i] = 0.0;
+  nsample = 0;
+  active = 0;
+
+  const bigint ntimestep = update->ntimestep;
+  if ((ntimestep >= wstart) && (ntimestep <= wstop)) {
+    active = 1;
+    firststep = laststep = ntimestep;
+    sample();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   only local data is recorded during the run, no communication
+------------------------------------------------------------------------- */
+
+void FixImbalanceMap::end_of_step()
+{
+  const bigint ntimestep = update->ntimestep;
+  if ((ntimestep < wstart) || (ntimestep > wstop)) return;
+
+  if (!active) {
+    active = 1;
+    read_timers(tbase);
+    firststep = ntimestep;
+  }
+  sample();
+  read_timers(tlast);
+  laststep = ntimestep;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixImbalanceMap::post_run()
+{
+  if (!active) return;
+  if (update->ntimestep <= wstop) {
+    read_timers(tlast);
+    laststep = update->ntimestep;
+  }
+  report();
+  active = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixImbalanceMap::read_timers(double *times)
+{
+  times[PAIR] = timer->get_wall(Timer::PAIR);
+  times[BOND] = timer->get_wall(Timer::BOND);
+  times[KSPACE] = timer->get_wall(Timer::KSPACE);
+  times[NEIGH] = timer->get_wall(Timer::NEIGH);
+  times[COMM] = timer->get_wall(Timer::COMM);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixImbalanceMap::sample()
+{
+  bigint nneigh = neighbor->get_nneigh_half();
+  if (nneigh < 0) nneigh = neighbor->get_nneigh_full();
+
+  count[ATOMS] += atom->nlocal;
+  count[GHOSTS] += atom->nghost;
+  if (nneigh > 0) count[NEIGHS] += nneigh;
+  ++nsample;
+}
+
+/* ----------------------------------------------------------------------
+   gather per-rank data, write heatmap data file and print diagnosis
+------------------------------------------------------------------------- */
+
+void FixImbalanceMap::report()
+{
+  const int nprocs = comm->nprocs;
+  const int dimension = domain->dimension;
+  const int tiled = (comm->layout == Comm::LAYOUT_TILED);
+
+  double local[NVAL];
+  for (int i = 0; i < NUM_TIME; ++i) local[i] = tlast[i] - tbase[i];
+  for (int i = 0; i < NUM_COUNT; ++i) local[NUM_TIME + i] = nsample ? count[i] / nsample : 0.0;
+  for (int i = 0; i < 3; ++i) {
+    local[8 + i] = domain->sublo[i];
+    local[11 + i] = domain->subhi[i];
+    local[14 + i] = tiled ? -1 : comm->myloc[i];
+  }
+  local[17] = tiled ? comm->rcbcutdim : -1;
+  local[18] = tiled ? comm->rcbcutfrac : 0.0;
+
+  std::vector<double> all;
+  if (comm->me == 0) all.resize((size_t) nprocs * NVAL);
+  MPI_Gather(local, NVAL, MPI_DOUBLE, all.data(), NVAL, MPI_DOUBLE, 0, world);
+  if (comm->me != 0) return;
+
+  // write one line per MPI rank
+
+  FILE *fp = fopen(filename.c_str(), "w");
+  if (!fp)
+    error->one(FLERR, "Cannot open fix imbalance/map file {}: {}", filename, utils::getsyserror());
+  fmt::print(fp, "# Load imbalance map from fix {} for steps {} to {} with {} samples\n", id,
+             firststep, laststep, nsample);
+  if (tiled)
+    fmt::print(fp, "# Recursive coordinate bisection with {} MPI ranks\n", nprocs);
+  else
+    fmt::print(fp, "# Processor grid {} by {} by {}\n", comm->procgrid[0], comm->procgrid[1],
+               comm->procgrid[2]);
+  fputs("# rank ix iy iz xlo ylo zlo xhi yhi zhi cutdim cutfrac pair bond kspace neigh comm "
+        "load atoms ghosts neighbors\n",
+        fp);
+  for (int p = 0; p < nprocs; ++p) {
+    const double *v = &all[(size_t) p * NVAL];
+    const double load = v[PAIR] + v[BOND] + v[KSPACE] + v[NEIGH];
+    fmt::print(fp, "{} {:.0f} {:.0f} {:.0f} {:.8g} {:.8g} {:.8g} {:.8g} {:.8g} {:.8g} {:.0f} {:.8g}",
+               p, v[14], v[15], v[16], v[8], v[9], v[10], v[11], v[12], v[13], v[17], v[18]);
+    fmt::print(fp, " {:.8g} {:.8g} {:.8g} {:.8g} {:.8g} {:.8g} {:.8g} {:.8g} {:.8g}\n", v[PAIR],
+               v[BOND], v[KSPACE], v[NEIGH], v[COMM], load, v[NUM_TIME + ATOMS],
+               v[NUM_TIME + GHOSTS], v[NUM_TIME + NEIGHS]);
+  }
+  fclose(fp);
+
+  // per-rank series for the analysis. load is the time for computations
+  // that scale with the atoms owned by a rank, as used by balance weight time.
+
+  std::vector<double> load(nprocs), comm_t(nprocs), atoms(nprocs), ghosts(nprocs), neighs(nprocs);
+  std::vector<double> load_pa, neigh_pa;
+  for (int p = 0; p < nprocs; ++p) {
+    const double *v = &all[(size_t) p * NVAL];
+    load[p] = v[PAIR] + v[BOND] + v[KSPACE] + v[NEIGH];
+    comm_t[p] = v[COMM];
+    atoms[p] = v[NUM_TIME + ATOMS];
+    ghosts[p] = v[NUM_TIME + GHOSTS];
+    neighs[p] = v[NUM_TIME + NEIGHS];
+    if (atoms[p] > 0.0) {
+      load_pa.push_back(load[p] / atoms[p]);
+      neigh_pa.push_back(neighs[p] / atoms[p]);
+    }
+  }
+
+  struct Stats {
+    double min, avg, max;
+    double ratio() const { return (avg > 0.0) ? max / avg : 1.0; }
+  };
+  auto stats = [](const std::vector<double> &val) {
+    Stats s{val.empty() ? 0.0 : val[0], 0.0, val.empty() ? 0.0 : val[0]};
+    for (const auto &v : val) {
+      s.min = MIN(s.min, v);
+      s.max = MAX(s.max, v);
+      s.avg += v;
+    }
+    if (!val.empty()) s.avg /= val.size();
+    return s;
+  };
+  auto correlation = [](const std::vector<double> &a, const std::vector<double> &b) {
+    const int n = a.size();
+    if (n < 2) return 0.0;
+    double ma = 0.0, mb = 0.0;
+    for (int i = 0; i < n; ++i) {
+      ma += a[i];
+      mb += b[i];
+    }
+    ma /= n;
+    mb /= n;
+    double sab = 0.0, saa = 0.0, sbb = 0.0;
+    for (int i = 0; i < n; ++i) {
+      sab += (a[i] - ma) * (b[i] - mb);
+      saa += (a[i] - ma) * (a[i] - ma);
+      sbb += (b[i] - mb) * (b[i] - mb);
+    }
+    if ((saa <= 0.0) || (sbb <= 0.0)) return 0.0;
+    return sab / sqrt(saa * sbb);
+  };
+
+  std::string mesg = fmt::format("Load imbalance map (fix {}) for steps {} to {} with {} samples, "
+                                 "written to {}:\n",
+                                 id, firststep, laststep, nsample, filename);
+  mesg += "Quantity  |     min     |     avg     |     max     | max/avg\n";
+  mesg += "--------------------------------------------------------------\n";
+  const std::vector<std::pair<const char *, const std::vector<double> *>> rows = {
+      {"Load", &load},     {"Comm", &comm_t},     {"Atoms", &atoms},
+      {"Ghosts", &ghosts}, {"Neighbors", &neighs}};
+  for (const auto &row : rows) {
+    const Stats s = stats(*row.second);
+    mesg += fmt::format("{:<9} | {:<11.5g} | {:<11.5g} | {:<11.5g} | {:.3f}\n", row.first, s.min,
+                        s.avg, s.max, s.ratio());
+  }
+
+  // score each candidate cause by how strongly it tracks the per-rank load
+  // and how imbalanced it is itself:
+  // atom count: different number of owned atoms
+  // neighbor density: different number of neighbors per owned atom
+  // ghost count: different number of ghost atoms, which add to Neigh and Comm
+
+  const Stats sload = stats(load);
+  const Stats satoms = stats(atoms);
+  const Stats sghosts = stats(ghosts);
+  const Stats sload_pa = stats(load_pa);
+  const Stats sneigh_pa = stats(neigh_pa);
+
+  std::vector<double> ghostwork(nprocs);
+  for (int p = 0; p < nprocs; ++p)
+    ghostwork[p] = all[(size_t) p * NVAL + NEIGH] + all[(size_t) p * NVAL + COMM];
+
+  const double score_atoms = MAX(0.0, correlation(load, atoms)) * (satoms.ratio() - 1.0);
+  const double score_density =
+      MAX(0.0, correlation(load_pa, neigh_pa)) * (sneigh_pa.ratio() - 1.0);
+  const double score_ghosts = MAX(0.0, correlation(ghostwork, ghosts)) * (sghosts.ratio() - 1.0);
+
+  const std::string shift = (dimension == 2) ? "shift xy 10 1.1" : "shift xyz 10 1.1";
+  const std::string method = tiled ? "rcb" : shift;
+  std::string weight;
+
+  if (nprocs == 1) {
+    mesg += "Imbalance diagnosis: single MPI rank, nothing to balance\n";
+  } else if ((sload.ratio() < IMBTHRESH) || (sload.max <= 0.0)) {
+    mesg += fmt::format("Imbalance diagnosis: load is balanced within {:.0f}%, no rebalancing needed\n",
+                        100.0 * (IMBTHRESH - 1.0));
+  } else {
+    // ImbalanceNeigh scales the hi/lo ratio of the per-atom neighbor weights by
+    // its factor, choose the factor so that it matches the hi/lo ratio of the load per atom
+
+    double factor = 1.0;
+    if ((sload_pa.min > 0.0) && (sneigh_pa.min > 0.0))
+      factor = (sload_pa.max / sload_pa.min) / (sneigh_pa.max / sneigh_pa.min);
+    factor = MAX(0.1, MIN(factor, 10.0));
+
+    const double best = MAX(score_atoms, MAX(score_density, score_ghosts));
+    if (best < 0.01) {
+      mesg += "Imbalance diagnosis: load imbalance is not explained by atom, neighbor, or ghost "
+              "counts, likely from fixes, computes, or other processes on the nodes\n";
+      weight = " weight time 1.0";
+    } else if (best == score_atoms) {
+      mesg += fmt::format("Imbalance diagnosis: dominant cause is the atom count per rank "
+                          "(max/avg = {:.3f})\n",
+                          satoms.ratio());
+      if (score_density > 0.5 * score_atoms) {
+        mesg += fmt::format("Imbalance diagnosis: secondary cause is the neighbor density "
+                            "(neighbors per atom max/avg = {:.3f})\n",
+                            sneigh_pa.ratio());
+        weight = fmt::format(" weight neigh {:.2g}", factor);
+      }
+    } else if (best == score_density) {
+      mesg += fmt::format("Imbalance diagnosis: dominant cause is the neighbor density "
+                          "(neighbors per atom max/avg = {:.3f})\n",
+                          sneigh_pa.ratio());
+      weight = fmt::format(" weight neigh {:.2g}", factor);
+    } else {
+      mesg += fmt::format("Imbalance diagnosis: dominant cause is the ghost atom count per rank "
+                          "(max/avg = {:.3f})\n",
+                          sghosts.ratio());
+      weight = " weight time 1.0";
+    }
+    mesg += "Recommended load balancing settings:\n";
+    mesg += fmt::format("  balance 1.1 {}{}\n", method, weight);
+    mesg += fmt::format("  fix {}_bal all balance {} 1.1 {}{}\n", id, 10 * nevery, method, weight);
+    if (!tiled && (sload.ratio() > 1.5))
+      mesg += fmt::format("  or, for strongly non-uniform systems: comm_style tiled and "
+                          "balance 1.1 rcb{}\n",
+                          weight);
+  }
+  utils::logmesg(lmp, mesg);
+}
@@ -0,0 +1,60 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+// clang-format off
+FixStyle(imbalance/map,FixImbalanceMap);
+// clang-format on
+#else
+
+#ifndef LMP_FIX_IMBALANCE_MAP_H
+#define LMP_FIX_IMBALANCE_MAP_H
+
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixImbalanceMap : public Fix {
+ public:
+  FixImbalanceMap(class LAMMPS *, int, char **);
+
+  int setmask() override;
+  void init() override;
+  void setup(int) override;
+  void end_of_step() override;
+  void post_run() override;
+
+ private:
+  enum { PAIR = 0, BOND, KSPACE, NEIGH, COMM, NUM_TIME };
+  enum { ATOMS = 0, GHOSTS, NEIGHS, NUM_COUNT };
+
+  std::string filename;    // name of heatmap data file
+  bigint wstart, wstop;    // window of timesteps to record
+  bigint firststep;        // first and last timestep of recorded data
+  bigint laststep;
+  int active;              // 1 if inside window and base times are set
+  int nsample;             // number of samples of per-rank counts
+
+  double tbase[NUM_TIME];      // timer values at start of window
+  double tlast[NUM_TIME];      // timer values at end of window
+  double count[NUM_COUNT];     // accumulated per-rank counts
+
+  void read_timers(double *);
+  void sample();
+  void report();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
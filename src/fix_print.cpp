@@ -18,6 +18,7 @@
 #include "input.h"
 #include "memory.h"
 #include "modify.h"
+#include "output.h"
 #include "update.h"
 #include "variable.h"
 
@@ -177,7 +178,7 @@ void FixPrint::end_of_step()
 
   if (comm->me == 0) {
     if (screenflag) utils::logmesg(lmp, std::string(copy) + "\n");
-    if (fp) {
+    if (fp && output->fix_file_flag) {
       fmt::print(fp, "{}\n", copy);
       fflush(fp);
     }
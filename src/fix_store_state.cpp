@@ -17,6 +17,7 @@
 #include "arg_info.h"
 #include "atom.h"
 #include "compute.h"
+#include "timer.h"
 #include "update.h"
 #include "domain.h"
 #include "modify.h"
@@ -459,6 +460,7 @@ void FixStoreState::end_of_step()
 
       if (val.which == ArgInfo::COMPUTE) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
+          Timer::Instance timing(timer, val.val.c);
           val.val.c->compute_peratom();
           val.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
         }
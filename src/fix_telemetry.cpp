@@ -0,0 +1,341 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_telemetry.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "error.h"
+#include "force.h"
+#include "memory.h"
+#include "neighbor.h"
+#include "timer.h"
+#include "update.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+static constexpr std::size_t MAXPENDING = 1 << 20;    // max bytes of unsent records
+static constexpr double MBYTES = 1024.0 * 1024.0;
+static const char *const timenames[] = {"pair", "bond", "kspace", "neigh",
+                                        "comm", "output", "modify"};
+static const Timer::ttype timers[] = {Timer::PAIR, Timer::BOND,   Timer::KSPACE, Timer::NEIGH,
+                                      Timer::COMM, Timer::OUTPUT, Timer::MODIFY};
+
+/* ---------------------------------------------------------------------- */
+
+FixTelemetry::FixTelemetry(LAMMPS *lmp, int narg, char **arg) :
+    Fix(lmp, narg, arg), mode(FILEOUT), maxsize(0), nbackup(1), appendflag(0), fp(nullptr),
+    fd(-1), ndropped(0), laststep(0), lastwall(0.0), lastbuild(0), lastdanger(0), lastmigrate(0)
+{
+  if (narg < 5) utils::missing_cmd_args(FLERR, "fix telemetry", error);
+
+  nevery = utils::inumeric(FLERR, arg[3], false, lmp);
+  if (nevery <= 0) error->all(FLERR, "Illegal fix telemetry nevery value: {}", nevery);
+  target = arg[4];
+
+  int iarg = 5;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "mode") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "fix telemetry mode", error);
+      if (strcmp(arg[iarg + 1], "file") == 0) mode = FILEOUT;
+      else if (strcmp(arg[iarg + 1], "pipe") == 0) mode = PIPE;
+      else if (strcmp(arg[iarg + 1], "socket") == 0) mode = SOCKET;
+      else error->all(FLERR, "Unknown fix telemetry mode: {}", arg[iarg + 1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "maxsize") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "fix telemetry maxsize", error);
+      double mbytes = utils::numeric(FLERR, arg[iarg + 1], false, lmp);
+      if (mbytes < 0.0) error->all(FLERR, "Illegal fix telemetry maxsize value: {}", mbytes);
+      maxsize = (bigint) (mbytes * MBYTES);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "backups") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "fix telemetry backups", error);
+      nbackup = utils::inumeric(FLERR, arg[iarg + 1], false, lmp);
+      if (nbackup < 0) error->all(FLERR, "Illegal fix telemetry backups value: {}", nbackup);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "append") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "fix telemetry append", error);
+      appendflag = utils::logical(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
+    } else
+      error->all(FLERR, "Unknown fix telemetry keyword: {}", arg[iarg]);
+  }
+
+  if ((mode != FILEOUT) && (maxsize > 0))
+    error->all(FLERR, "Fix telemetry maxsize requires mode file");
+
+#if defined(_WIN32)
+  if (mode != FILEOUT)
+    error->all(FLERR, "Fix telemetry modes pipe and socket are not supported on Windows");
+#endif
+
+  // only rank 0 writes records, pipes and sockets are connected at the first record
+
+  if (comm->me == 0) {
+    if (mode == FILEOUT) open_file();
+#if !defined(_WIN32)
+    if (mode == PIPE) {
+      struct stat info;
+      if (stat(target.c_str(), &info) != 0) {
+        if (mkfifo(target.c_str(), 0600) != 0)
+          error->one(FLERR, "Cannot create fix telemetry named pipe {}: {}", target,
+                     utils::getsyserror());
+      } else if (!S_ISFIFO(info.st_mode))
+        error->one(FLERR, "Fix telemetry target {} is not a named pipe", target);
+    }
+    if (mode == SOCKET) {
+      if (target.size() >= sizeof(sockaddr_un::sun_path))
+        error->one(FLERR, "Fix telemetry socket path {} is too long", target);
+    }
+#endif
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixTelemetry::~FixTelemetry()
+{
+  if (fp) fclose(fp);
+#if !defined(_WIN32)
+  if (fd >= 0) close(fd);
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixTelemetry::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ----------------------------------------------------------------------
+   record counters at the start of a run
+   the timers are reset after setup, all other counters are cumulative
+------------------------------------------------------------------------- */
+
+void FixTelemetry::setup(int /*vflag*/)
+{
+  laststep = update->ntimestep;
+  lastwall = platform::walltime();
+  for (double &t : lasttime) t = 0.0;
+  lastbuild = neighbor->ncalls;
+  lastdanger = neighbor->ndanger;
+  lastmigrate = comm->nmigrate;
+}
+
+/* ----------------------------------------------------------------------
+   gather the changes of the counters since the previous record and
+   write them on rank 0 as one line of JSON
+------------------------------------------------------------------------- */
+
+void FixTelemetry::end_of_step()
+{
+  const double now = platform::walltime();
+
+  // per-rank values: times, migrated atoms, live and peak memory
+  // are combined with one sum and one max reduction
+
+  double local[NUM_TIME + 3], sum[NUM_TIME + 3], max[NUM_TIME + 3];
+  for (int i = 0; i < NUM_TIME; ++i) {
+    const double t = timer->get_wall(timers[i]);
+    local[i] = t - lasttime[i];
+    lasttime[i] = t;
+  }
+  local[NUM_TIME] = (double) (comm->nmigrate - lastmigrate);
+  local[NUM_TIME + 1] = (double) memory->get_live();
+  local[NUM_TIME + 2] = (double) memory->get_peak();
+  lastmigrate = comm->nmigrate;
+
+  MPI_Reduce(local, sum, NUM_TIME + 3, MPI_DOUBLE, MPI_SUM, 0, world);
+  MPI_Reduce(local, max, NUM_TIME + 3, MPI_DOUBLE, MPI_MAX, 0, world);
+
+  const bigint nsteps = update->ntimestep - laststep;
+  const bigint nbuild = neighbor->ncalls - lastbuild;
+  const bigint ndanger = neighbor->ndanger - lastdanger;
+  const double wall = now - lastwall;
+  laststep = update->ntimestep;
+  lastwall = now;
+  lastbuild = neighbor->ncalls;
+  lastdanger = neighbor->ndanger;
+
+  if (comm->me != 0) return;
+
+  const double nprocs = comm->nprocs;
+  const double step_s = (wall > 0.0) ? nsteps / wall : 0.0;
+  const double sim_day = 24.0 * 3600.0 * step_s * update->dt / force->femtosecond;
+  const double elapsed = update->atime + (update->ntimestep - update->atimestep) * update->dt;
+
+  std::string mesg = fmt::format("{{\"step\":{},\"time\":{:.8g},\"wall\":{:.6g},\"steps\":{},"
+                                 "\"steps_per_s\":{:.6g},",
+                                 update->ntimestep, elapsed, wall, nsteps, step_s);
+  if (strcmp(update->unit_style, "lj") == 0)
+    mesg += fmt::format("\"tau_per_day\":{:.6g},", sim_day);
+  else
+    mesg += fmt::format("\"ns_per_day\":{:.6g},", sim_day / 1000000.0);
+  mesg += fmt::format("\"atoms\":{},\"timer_avg\":{{", atom->natoms);
+
+  double other = wall;
+  for (int i = 0; i < NUM_TIME; ++i) {
+    mesg += fmt::format("\"{}\":{:.6g},", timenames[i], sum[i] / nprocs);
+    other -= sum[i] / nprocs;
+  }
+  mesg += fmt::format("\"other\":{:.6g}}},\"timer_max\":{{", other > 0.0 ? other : 0.0);
+  for (int i = 0; i < NUM_TIME; ++i)
+    mesg += fmt::format("{}\"{}\":{:.6g}", i ? "," : "", timenames[i], max[i]);
+
+  mesg += fmt::format("}},\"neigh\":{{\"builds\":{},\"per_step\":{:.6g},\"dangerous\":{}}},"
+                      "\"migrated\":{:.0f}",
+                      nbuild, nsteps > 0 ? (double) nbuild / nsteps : 0.0, ndanger,
+                      sum[NUM_TIME]);
+  if (memory->is_tracking())
+    mesg += fmt::format(",\"memory\":{{\"live_sum\":{:.6g},\"live_max\":{:.6g},\"peak_max\":{:.6g}}}",
+                        sum[NUM_TIME + 1] / MBYTES, max[NUM_TIME + 1] / MBYTES,
+                        max[NUM_TIME + 2] / MBYTES);
+  if (mode != FILEOUT) mesg += fmt::format(",\"dropped\":{}", ndropped);
+  mesg += "}\n";
+
+  send(mesg);
+}
+
+/* ----------------------------------------------------------------------
+   open output file, on rank 0 only
+------------------------------------------------------------------------- */
+
+void FixTelemetry::open_file()
+{
+  fp = fopen(target.c_str(), appendflag ? "a" : "w");
+  if (!fp)
+    error->one(FLERR, "Cannot open fix telemetry file {}: {}", target, utils::getsyserror());
+}
+
+/* ----------------------------------------------------------------------
+   rename file to file.1, file.1 to file.2, etc. and start a new file
+   the oldest file beyond the number of backups is overwritten
+------------------------------------------------------------------------- */
+
+void FixTelemetry::rotate_file()
+{
+  fclose(fp);
+  fp = nullptr;
+  if (nbackup > 0) {
+    for (int i = nbackup - 1; i > 0; --i)
+      rename(fmt::format("{}.{}", target, i).c_str(), fmt::format("{}.{}", target, i + 1).c_str());
+    rename(target.c_str(), (target + ".1").c_str());
+  }
+  fp = fopen(target.c_str(), "w");
+  if (!fp)
+    error->one(FLERR, "Cannot open fix telemetry file {}: {}", target, utils::getsyserror());
+}
+
+/* ----------------------------------------------------------------------
+   connect to the reader of a named pipe or the server of a unix socket
+   a missing reader is not an error, the connection is retried with the next record
+------------------------------------------------------------------------- */
+
+void FixTelemetry::connect()
+{
+#if !defined(_WIN32)
+  if (mode == PIPE) {
+
+    // fails with ENXIO if no process has the pipe open for reading
+
+    fd = open(target.c_str(), O_WRONLY | O_NONBLOCK);
+  } else {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, target.c_str(), sizeof(addr.sun_path) - 1);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return;
+    if (::connect(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) {
+      close(fd);
+      fd = -1;
+      return;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  }
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   write one record, on rank 0 only
+   pipes and sockets never block the simulation: records that cannot be
+   sent yet are kept until the next record, and dropped if the reader
+   is not connected or does not keep up
+------------------------------------------------------------------------- */
+
+void FixTelemetry::send(const std::string &mesg)
+{
+  if (mode == FILEOUT) {
+    fputs(mesg.c_str(), fp);
+    fflush(fp);
+    if ((maxsize > 0) && (ftell(fp) >= maxsize)) rotate_file();
+    return;
+  }
+
+#if !defined(_WIN32)
+  if (fd < 0) connect();
+  if ((fd < 0) || (pending.size() > MAXPENDING)) {
+    ++ndropped;
+    return;
+  }
+  pending += mesg;
+  ndropped = 0;
+
+  // a reader closing the pipe would raise SIGPIPE, which terminates the process by default
+
+  struct sigaction ignore, saved;
+  memset(&ignore, 0, sizeof(ignore));
+  ignore.sa_handler = SIG_IGN;
+  if (mode == PIPE) sigaction(SIGPIPE, &ignore, &saved);
+
+  while (!pending.empty()) {
+    ssize_t n;
+    if (mode == PIPE)
+      n = write(fd, pending.data(), pending.size());
+    else
+      n = ::send(fd, pending.data(), pending.size(), MSG_NOSIGNAL);
+    if (n > 0) {
+      pending.erase(0, n);
+    } else {
+      if ((n < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+
+        // reader is gone, partially sent data is discarded and the next record reconnects
+
+        close(fd);
+        fd = -1;
+        pending.clear();
+      }
+      break;
+    }
+  }
+
+  if (mode == PIPE) sigaction(SIGPIPE, &saved, nullptr);
+#endif
+}
@@ -0,0 +1,67 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+// clang-format off
+FixStyle(telemetry,FixTelemetry);
+// clang-format on
+#else
+
+#ifndef LMP_FIX_TELEMETRY_H
+#define LMP_FIX_TELEMETRY_H
+
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixTelemetry : public Fix {
+ public:
+  FixTelemetry(class LAMMPS *, int, char **);
+  ~FixTelemetry() override;
+
+  int setmask() override;
+  void setup(int) override;
+  void end_of_step() override;
+
+ private:
+  enum { FILEOUT, PIPE, SOCKET };
+  enum { PAIR = 0, BOND, KSPACE, NEIGH, COMM, OUTPUT, MODIFY, NUM_TIME };
+
+  std::string target;    // name of file, named pipe, or socket
+  int mode;              // FILEOUT or PIPE or SOCKET
+  bigint maxsize;        // rotate file when larger than this many bytes, 0 = never
+  int nbackup;           // # of rotated files to keep
+  int appendflag;        // 1 to append to an existing file
+
+  FILE *fp;              // output file (FILEOUT mode, rank 0 only)
+  int fd;                // descriptor of pipe or socket, -1 if not connected
+  std::string pending;   // unsent part of records for pipe or socket
+  bigint ndropped;       // # of records dropped since last successful send
+
+  // counter values at the previous record
+
+  bigint laststep;
+  double lastwall;
+  double lasttime[NUM_TIME];
+  bigint lastbuild, lastdanger, lastmigrate;
+
+  void open_file();
+  void rotate_file();
+  void connect();
+  void send(const std::string &);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -19,6 +19,7 @@
 #include "input.h"
 #include "memory.h"
 #include "modify.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -268,12 +269,14 @@ void FixVector::end_of_step()
 
       if (val.argindex == 0) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_SCALAR)) {
+          Timer::Instance timing(timer, val.val.c);
           val.val.c->compute_scalar();
           val.val.c->invoked_flag |= Compute::INVOKED_SCALAR;
         }
         result[i] = val.val.c->scalar;
       } else {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
+          Timer::Instance timing(timer, val.val.c);
           val.val.c->compute_vector();
           val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
@@ -430,6 +430,11 @@ LAMMPS::LAMMPS(int narg, char **arg, MPI_Comm communicator) :
       screenflag = iarg + 1;
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"-memtrack") == 0 ||
+               strcmp(arg[iarg],"-mt") == 0) {
+      memory->set_tracking(true);
+      ++iarg;
+
     } else if (strcmp(arg[iarg],"-skiprun") == 0 ||
                strcmp(arg[iarg],"-sr") == 0) {
       skiprunflag = 1;
@@ -1252,6 +1257,7 @@ void _noopt LAMMPS::help()
           "-kokkos on/off ...          : turn KOKKOS mode on or off (-k)\n"
           "-log none/filename          : where to send log output (-l)\n"
           "-mdi '<mdi flags>'          : pass flags to the MolSSI Driver Interface\n"
+          "-memtrack                   : track memory allocated by LAMMPS (-mt)\n"
           "-mpicolor color             : which exe in a multi-exe mpirun cmd (-m)\n"
           "-cite                       : select citation reminder style (-c)\n"
           "-nocite                     : disable citation reminder (-nc)\n"
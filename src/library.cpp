@@ -916,6 +916,49 @@ void *lammps_last_thermo(void *handle, const char *what, int index)
 
 /* ---------------------------------------------------------------------- */
 
+/** Get wall time spent in a fix or compute
+ *
+\verbatim embed:rst
+
+.. versionadded:: TBD
+
+This function returns the wall time in seconds that the calling MPI
+process has spent in the fix or compute with the given ID since the
+start of the last run or minimization.  These times are only collected
+when enabled with the :doc:`timer instance <timer>` command, otherwise
+the returned value is 0.0.  The times are local to each MPI process, so
+the calling code has to reduce them across processes, if the minimum,
+average, or maximum time is desired.
+
+\endverbatim
+ *
+ * \param  handle    pointer to a previously created LAMMPS instance
+ * \param  category  string "fix" or "compute"
+ * \param  id        string with ID of the fix or compute
+ * \return           accumulated wall time or -1.0 if no such fix or compute exists */
+
+double lammps_get_instance_time(void *handle, const char *category, const char *id)
+{
+  auto lmp = (LAMMPS *) handle;
+  double time = -1.0;
+
+  BEGIN_CAPTURE
+  {
+    if (strcmp(category, "fix") == 0) {
+      auto ifix = lmp->modify->get_fix_by_id(id);
+      if (ifix) time = ifix->walltime;
+    } else if (strcmp(category, "compute") == 0) {
+      auto icompute = lmp->modify->get_compute_by_id(id);
+      if (icompute) time = icompute->walltime;
+    }
+  }
+  END_CAPTURE
+
+  return time;
+}
+
+/* ---------------------------------------------------------------------- */
+
 /** Extract simulation box parameters.
  *
 \verbatim embed:rst
@@ -18,6 +18,7 @@
 #define ENDIAN 0x0001
 #define ENDIANSWAP 0x1000
 #define FORMAT_REVISION 3
+#define DELTA_FORMAT_REVISION 4
 
 enum{VERSION,SMALLINT,TAGINT,BIGINT,
      UNITS,NTIMESTEP,DIMENSION,NPROCS,PROCGRID,
@@ -38,7 +39,8 @@ enum{VERSION,SMALLINT,TAGINT,BIGINT,
      EXTRA_BOND_PER_ATOM,EXTRA_ANGLE_PER_ATOM,EXTRA_DIHEDRAL_PER_ATOM,
      EXTRA_IMPROPER_PER_ATOM,EXTRA_SPECIAL_PER_ATOM,ATOM_MAXSPECIAL,
      NELLIPSOIDS,NLINES,NTRIS,NBODIES,ATIME,ATIMESTEP,LABELMAP,
-     TRICLINIC_GENERAL,ROTATE_G2R};
+     TRICLINIC_GENERAL,ROTATE_G2R,DELTA_BASE,DELTA_OFFSET,DELTA_NCHUNK,
+     DELTA_ZLIB};
 
 #define LB_FACTOR 1.1
 
@@ -16,6 +16,9 @@
 
 #include "error.h"
 
+#include <mutex>
+#include <unordered_map>
+
 #if defined(LMP_INTEL) && ((defined(__INTEL_COMPILER) || defined(__INTEL_LLVM_COMPILER)))
 #ifndef LMP_INTEL_NO_TBB
 #define LMP_USE_TBB_ALLOCATOR
@@ -36,9 +39,86 @@
 
 using namespace LAMMPS_NS;
 
+/* ----------------------------------------------------------------------
+   bookkeeping for memory accounting: size and tag of each live block,
+   live and peak bytes per tag, per subsystem, and in total
+   the mutex serializes updates from OpenMP threads and from the
+   background threads of dump output
+------------------------------------------------------------------------- */
+
+struct Memory::Tracker {
+  struct Block {
+    bigint nbytes;
+    int tag;
+  };
+  struct Count {
+    bigint live, peak;
+    int subsystem;
+  };
+
+  std::unordered_map<void *, Block> blocks;
+  std::unordered_map<std::string, int> tagindex, subindex;
+  std::vector<std::string> tagnames, subnames;
+  std::vector<Count> tags, subsystems;
+  bigint live, peak;
+  std::mutex mutex;
+
+  Tracker() : live(0), peak(0) {}
+
+  int find_tag(const char *name)
+  {
+    const std::string tag = name ? name : "(unknown)";
+    auto found = tagindex.find(tag);
+    if (found != tagindex.end()) return found->second;
+
+    // new tag, also look up or add its subsystem
+
+    const std::string sub = tag.substr(0, tag.find(':'));
+    int isub;
+    auto foundsub = subindex.find(sub);
+    if (foundsub != subindex.end()) {
+      isub = foundsub->second;
+    } else {
+      isub = subnames.size();
+      subindex[sub] = isub;
+      subnames.push_back(sub);
+      subsystems.push_back({0, 0, -1});
+    }
+
+    const int itag = tagnames.size();
+    tagindex[tag] = itag;
+    tagnames.push_back(tag);
+    tags.push_back({0, 0, isub});
+    return itag;
+  }
+
+  void add(int itag, bigint nbytes)
+  {
+    Count &t = tags[itag];
+    Count &s = subsystems[t.subsystem];
+    t.live += nbytes;
+    s.live += nbytes;
+    live += nbytes;
+    if (t.live > t.peak) t.peak = t.live;
+    if (s.live > s.peak) s.peak = s.live;
+    if (live > peak) peak = live;
+  }
+};
+
+/* ---------------------------------------------------------------------- */
+
+Memory::Memory(LAMMPS *lmp) : Pointers(lmp)
+{
+  tracker = new Tracker;
+  tracking = false;
+}
+
 /* ---------------------------------------------------------------------- */
 
-Memory::Memory(LAMMPS *lmp) : Pointers(lmp) {}
+Memory::~Memory()
+{
+  delete tracker;
+}
 
 /* ----------------------------------------------------------------------
    safe malloc
@@ -63,6 +143,7 @@ void *Memory::smalloc(bigint nbytes, const char *name)
 #endif
   if (ptr == nullptr)
     error->one(FLERR,"Failed to allocate {} bytes for array {}", nbytes,name);
+  if (tracking) track(ptr, nbytes, name);
   return ptr;
 }
 
@@ -77,6 +158,12 @@ void *Memory::srealloc(void *ptr, bigint nbytes, const char *name)
     return nullptr;
   }
 
+  // remove old block from accounting before its address can be reused
+
+  void *oldptr = ptr;
+  bigint oldbytes = 0;
+  if (tracking) oldbytes = untrack(oldptr);
+
 #if defined(LMP_USE_TBB_ALLOCATOR)
   ptr = scalable_aligned_realloc(ptr, nbytes, LAMMPS_MEMALIGN);
 #elif defined(LMP_INTEL_NO_TBB) && defined(LAMMPS_MEMALIGN) && \
@@ -99,9 +186,12 @@ void *Memory::srealloc(void *ptr, bigint nbytes, const char *name)
 #else
   ptr = realloc(ptr,nbytes);
 #endif
-  if (ptr == nullptr)
+  if (ptr == nullptr) {
+    if (tracking && oldbytes) track(oldptr, oldbytes, name);
     error->one(FLERR,"Failed to reallocate {} bytes for array {}",
                                  nbytes,name);
+  }
+  if (tracking) track(ptr, nbytes, name);
   return ptr;
 }
 
@@ -112,6 +202,7 @@ void *Memory::srealloc(void *ptr, bigint nbytes, const char *name)
 void Memory::sfree(void *ptr)
 {
   if (ptr == nullptr) return;
+  if (tracking) untrack(ptr);
   #if defined(LMP_USE_TBB_ALLOCATOR)
   scalable_aligned_free(ptr);
   #else
@@ -127,3 +218,81 @@ void Memory::fail(const char *name)
 {
   error->one(FLERR,"Cannot create/grow a vector/array of pointers for {}",name);
 }
+
+/* ----------------------------------------------------------------------
+   record allocated block under its tag
+   a block at the same address that was released without sfree() is replaced
+------------------------------------------------------------------------- */
+
+void Memory::track(void *ptr, bigint nbytes, const char *name)
+{
+  std::lock_guard<std::mutex> lock(tracker->mutex);
+  auto found = tracker->blocks.find(ptr);
+  if (found != tracker->blocks.end()) {
+    tracker->add(found->second.tag, -found->second.nbytes);
+    tracker->blocks.erase(found);
+  }
+  const int itag = tracker->find_tag(name);
+  tracker->blocks[ptr] = {nbytes, itag};
+  tracker->add(itag, nbytes);
+}
+
+/* ----------------------------------------------------------------------
+   remove block from accounting, ignore blocks not allocated by smalloc()
+   return size of removed block or 0 if block was not tracked
+------------------------------------------------------------------------- */
+
+bigint Memory::untrack(void *ptr)
+{
+  std::lock_guard<std::mutex> lock(tracker->mutex);
+  auto found = tracker->blocks.find(ptr);
+  if (found == tracker->blocks.end()) return 0;
+  const bigint nbytes = found->second.nbytes;
+  tracker->add(found->second.tag, -nbytes);
+  tracker->blocks.erase(found);
+  return nbytes;
+}
+
+/* ----------------------------------------------------------------------
+   turn memory accounting on or off, off by default
+   accounting starts from zero, blocks allocated before are not counted
+------------------------------------------------------------------------- */
+
+void Memory::set_tracking(bool flag)
+{
+  if (flag == tracking) return;
+  delete tracker;
+  tracker = new Tracker;
+  tracking = flag;
+}
+
+/* ----------------------------------------------------------------------
+   bytes currently allocated and high-water mark on this MPI rank
+------------------------------------------------------------------------- */
+
+bigint Memory::get_live() const
+{
+  std::lock_guard<std::mutex> lock(tracker->mutex);
+  return tracker->live;
+}
+
+bigint Memory::get_peak() const
+{
+  std::lock_guard<std::mutex> lock(tracker->mutex);
+  return tracker->peak;
+}
+
+/* ----------------------------------------------------------------------
+   live and peak bytes on this MPI rank per tag or per subsystem
+------------------------------------------------------------------------- */
+
+std::vector<Memory::Usage> Memory::get_usage(bool bysubsystem) const
+{
+  std::lock_guard<std::mutex> lock(tracker->mutex);
+  std::vector<Usage> usage;
+  const auto &names = bysubsystem ? tracker->subnames : tracker->tagnames;
+  const auto &counts = bysubsystem ? tracker->subsystems : tracker->tags;
+  for (std::size_t i = 0; i < names.size(); ++i)
+    usage.push_back({names[i], counts[i].live, counts[i].peak});
+  return usage;
+}
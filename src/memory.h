@@ -22,12 +22,28 @@ namespace LAMMPS_NS {
 class Memory : protected Pointers {
  public:
   Memory(class LAMMPS *);
+  ~Memory() override;
 
   void *smalloc(bigint n, const char *);
   void *srealloc(void *, bigint n, const char *);
   void sfree(void *);
   void fail(const char *);
 
+  // optional accounting of memory allocated through smalloc()/srealloc() per tag,
+  // i.e. the name argument, and per subsystem, i.e. the tag up to the first ':'
+
+  struct Usage {
+    std::string name;
+    bigint live;
+    bigint peak;
+  };
+
+  void set_tracking(bool);
+  bool is_tracking() const { return tracking; }
+  bigint get_live() const;
+  bigint get_peak() const;
+  std::vector<Usage> get_usage(bool bysubsystem) const;
+
 /* ----------------------------------------------------------------------
    create/grow/destroy vecs and multidim arrays with contiguous memory blocks
    only use with primitive data types, e.g. 1d vec of ints, 2d array of doubles
@@ -941,6 +957,14 @@ class Memory : protected Pointers {
     bytes += ((double) sizeof(TYPE ***)) * n1;
     return bytes;
   }
+
+ private:
+  struct Tracker;
+  Tracker *tracker;
+  bool tracking;    // true if allocations are recorded in tracker
+
+  void track(void *, bigint, const char *);
+  bigint untrack(void *);
 };
 
 }    // namespace LAMMPS_NS
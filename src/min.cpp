@@ -149,7 +149,7 @@ void Min::init()
 
   // detect if fix omp is present for clearing force arrays
 
-  if (modify->get_fix_by_id("package_omp")) external_force_clear = 1;
+  external_force_clear = modify->get_fix_by_id("package_omp") ? 1 : 0;
 
   // set flags for arrays to clear in force_clear()
 
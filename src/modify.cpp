@@ -25,6 +25,7 @@
 #include "input.h"
 #include "memory.h"
 #include "region.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -395,8 +396,11 @@ void Modify::setup_pre_reverse(int eflag, int vflag)
 
 void Modify::initial_integrate(int vflag)
 {
-  for (int i = 0; i < n_initial_integrate; i++)
-    fix[list_initial_integrate[i]]->initial_integrate(vflag);
+  for (int i = 0; i < n_initial_integrate; i++) {
+    Fix *ifix = fix[list_initial_integrate[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->initial_integrate(vflag);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -405,7 +409,11 @@ void Modify::initial_integrate(int vflag)
 
 void Modify::post_integrate()
 {
-  for (int i = 0; i < n_post_integrate; i++) fix[list_post_integrate[i]]->post_integrate();
+  for (int i = 0; i < n_post_integrate; i++) {
+    Fix *ifix = fix[list_post_integrate[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->post_integrate();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -414,7 +422,11 @@ void Modify::post_integrate()
 
 void Modify::pre_exchange()
 {
-  for (int i = 0; i < n_pre_exchange; i++) fix[list_pre_exchange[i]]->pre_exchange();
+  for (int i = 0; i < n_pre_exchange; i++) {
+    Fix *ifix = fix[list_pre_exchange[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->pre_exchange();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -423,7 +435,11 @@ void Modify::pre_exchange()
 
 void Modify::pre_neighbor()
 {
-  for (int i = 0; i < n_pre_neighbor; i++) fix[list_pre_neighbor[i]]->pre_neighbor();
+  for (int i = 0; i < n_pre_neighbor; i++) {
+    Fix *ifix = fix[list_pre_neighbor[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->pre_neighbor();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -432,7 +448,11 @@ void Modify::pre_neighbor()
 
 void Modify::post_neighbor()
 {
-  for (int i = 0; i < n_post_neighbor; i++) fix[list_post_neighbor[i]]->post_neighbor();
+  for (int i = 0; i < n_post_neighbor; i++) {
+    Fix *ifix = fix[list_post_neighbor[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->post_neighbor();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -441,7 +461,11 @@ void Modify::post_neighbor()
 
 void Modify::pre_force(int vflag)
 {
-  for (int i = 0; i < n_pre_force; i++) fix[list_pre_force[i]]->pre_force(vflag);
+  for (int i = 0; i < n_pre_force; i++) {
+    Fix *ifix = fix[list_pre_force[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->pre_force(vflag);
+  }
 }
 /* ----------------------------------------------------------------------
    pre_reverse call, only for relevant fixes
@@ -449,7 +473,11 @@ void Modify::pre_force(int vflag)
 
 void Modify::pre_reverse(int eflag, int vflag)
 {
-  for (int i = 0; i < n_pre_reverse; i++) fix[list_pre_reverse[i]]->pre_reverse(eflag, vflag);
+  for (int i = 0; i < n_pre_reverse; i++) {
+    Fix *ifix = fix[list_pre_reverse[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->pre_reverse(eflag, vflag);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -461,11 +489,19 @@ void Modify::pre_reverse(int eflag, int vflag)
 void Modify::post_force(int vflag)
 {
   if (n_post_force_group) {
-    for (int i = 0; i < n_post_force_group; i++) fix[list_post_force_group[i]]->post_force(vflag);
+    for (int i = 0; i < n_post_force_group; i++) {
+      Fix *ifix = fix[list_post_force_group[i]];
+      Timer::Instance timing(timer, ifix);
+      ifix->post_force(vflag);
+    }
   }
 
   if (n_post_force) {
-    for (int i = 0; i < n_post_force; i++) fix[list_post_force[i]]->post_force(vflag);
+    for (int i = 0; i < n_post_force; i++) {
+      Fix *ifix = fix[list_post_force[i]];
+      Timer::Instance timing(timer, ifix);
+      ifix->post_force(vflag);
+    }
   }
 }
 
@@ -475,7 +511,11 @@ void Modify::post_force(int vflag)
 
 void Modify::final_integrate()
 {
-  for (int i = 0; i < n_final_integrate; i++) fix[list_final_integrate[i]]->final_integrate();
+  for (int i = 0; i < n_final_integrate; i++) {
+    Fix *ifix = fix[list_final_integrate[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->final_integrate();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -485,8 +525,13 @@ void Modify::final_integrate()
 
 void Modify::end_of_step()
 {
-  for (int i = 0; i < n_end_of_step; i++)
-    if (update->ntimestep % end_of_step_every[i] == 0) fix[list_end_of_step[i]]->end_of_step();
+  for (int i = 0; i < n_end_of_step; i++) {
+    if (update->ntimestep % end_of_step_every[i] == 0) {
+      Fix *ifix = fix[list_end_of_step[i]];
+      Timer::Instance timing(timer, ifix);
+      ifix->end_of_step();
+    }
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -580,8 +625,11 @@ void Modify::setup_pre_force_respa(int vflag, int ilevel)
 
 void Modify::initial_integrate_respa(int vflag, int ilevel, int iloop)
 {
-  for (int i = 0; i < n_initial_integrate_respa; i++)
-    fix[list_initial_integrate_respa[i]]->initial_integrate_respa(vflag, ilevel, iloop);
+  for (int i = 0; i < n_initial_integrate_respa; i++) {
+    Fix *ifix = fix[list_initial_integrate_respa[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->initial_integrate_respa(vflag, ilevel, iloop);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -590,8 +638,11 @@ void Modify::initial_integrate_respa(int vflag, int ilevel, int iloop)
 
 void Modify::post_integrate_respa(int ilevel, int iloop)
 {
-  for (int i = 0; i < n_post_integrate_respa; i++)
-    fix[list_post_integrate_respa[i]]->post_integrate_respa(ilevel, iloop);
+  for (int i = 0; i < n_post_integrate_respa; i++) {
+    Fix *ifix = fix[list_post_integrate_respa[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->post_integrate_respa(ilevel, iloop);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -600,8 +651,11 @@ void Modify::post_integrate_respa(int ilevel, int iloop)
 
 void Modify::pre_force_respa(int vflag, int ilevel, int iloop)
 {
-  for (int i = 0; i < n_pre_force_respa; i++)
-    fix[list_pre_force_respa[i]]->pre_force_respa(vflag, ilevel, iloop);
+  for (int i = 0; i < n_pre_force_respa; i++) {
+    Fix *ifix = fix[list_pre_force_respa[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->pre_force_respa(vflag, ilevel, iloop);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -612,13 +666,19 @@ void Modify::pre_force_respa(int vflag, int ilevel, int iloop)
 void Modify::post_force_respa(int vflag, int ilevel, int iloop)
 {
   if (n_post_force_group) {
-    for (int i = 0; i < n_post_force_group; i++)
-      fix[list_post_force_group[i]]->post_force_respa(vflag, ilevel, iloop);
+    for (int i = 0; i < n_post_force_group; i++) {
+      Fix *ifix = fix[list_post_force_group[i]];
+      Timer::Instance timing(timer, ifix);
+      ifix->post_force_respa(vflag, ilevel, iloop);
+    }
   }
 
   if (n_post_force_respa) {
-    for (int i = 0; i < n_post_force_respa; i++)
-      fix[list_post_force_respa[i]]->post_force_respa(vflag, ilevel, iloop);
+    for (int i = 0; i < n_post_force_respa; i++) {
+      Fix *ifix = fix[list_post_force_respa[i]];
+      Timer::Instance timing(timer, ifix);
+      ifix->post_force_respa(vflag, ilevel, iloop);
+    }
   }
 }
 
@@ -628,8 +688,11 @@ void Modify::post_force_respa(int vflag, int ilevel, int iloop)
 
 void Modify::final_integrate_respa(int ilevel, int iloop)
 {
-  for (int i = 0; i < n_final_integrate_respa; i++)
-    fix[list_final_integrate_respa[i]]->final_integrate_respa(ilevel, iloop);
+  for (int i = 0; i < n_final_integrate_respa; i++) {
+    Fix *ifix = fix[list_final_integrate_respa[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->final_integrate_respa(ilevel, iloop);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -638,7 +701,11 @@ void Modify::final_integrate_respa(int ilevel, int iloop)
 
 void Modify::min_pre_exchange()
 {
-  for (int i = 0; i < n_min_pre_exchange; i++) fix[list_min_pre_exchange[i]]->min_pre_exchange();
+  for (int i = 0; i < n_min_pre_exchange; i++) {
+    Fix *ifix = fix[list_min_pre_exchange[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->min_pre_exchange();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -647,7 +714,11 @@ void Modify::min_pre_exchange()
 
 void Modify::min_pre_neighbor()
 {
-  for (int i = 0; i < n_min_pre_neighbor; i++) fix[list_min_pre_neighbor[i]]->min_pre_neighbor();
+  for (int i = 0; i < n_min_pre_neighbor; i++) {
+    Fix *ifix = fix[list_min_pre_neighbor[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->min_pre_neighbor();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -656,7 +727,11 @@ void Modify::min_pre_neighbor()
 
 void Modify::min_post_neighbor()
 {
-  for (int i = 0; i < n_min_post_neighbor; i++) fix[list_min_post_neighbor[i]]->min_post_neighbor();
+  for (int i = 0; i < n_min_post_neighbor; i++) {
+    Fix *ifix = fix[list_min_post_neighbor[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->min_post_neighbor();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -665,7 +740,11 @@ void Modify::min_post_neighbor()
 
 void Modify::min_pre_force(int vflag)
 {
-  for (int i = 0; i < n_min_pre_force; i++) fix[list_min_pre_force[i]]->min_pre_force(vflag);
+  for (int i = 0; i < n_min_pre_force; i++) {
+    Fix *ifix = fix[list_min_pre_force[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->min_pre_force(vflag);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -674,8 +753,11 @@ void Modify::min_pre_force(int vflag)
 
 void Modify::min_pre_reverse(int eflag, int vflag)
 {
-  for (int i = 0; i < n_min_pre_reverse; i++)
-    fix[list_min_pre_reverse[i]]->min_pre_reverse(eflag, vflag);
+  for (int i = 0; i < n_min_pre_reverse; i++) {
+    Fix *ifix = fix[list_min_pre_reverse[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->min_pre_reverse(eflag, vflag);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -684,7 +766,11 @@ void Modify::min_pre_reverse(int eflag, int vflag)
 
 void Modify::min_post_force(int vflag)
 {
-  for (int i = 0; i < n_min_post_force; i++) fix[list_min_post_force[i]]->min_post_force(vflag);
+  for (int i = 0; i < n_min_post_force; i++) {
+    Fix *ifix = fix[list_min_post_force[i]];
+    Timer::Instance timing(timer, ifix);
+    ifix->min_post_force(vflag);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -174,6 +174,7 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   old_triclinic = 0;
   old_pgsize = pgsize;
   old_oneatom = oneatom;
+  old_nthreads = comm->nthreads;
 
   binclass = nullptr;
   binnames = nullptr;
@@ -801,6 +802,7 @@ int Neighbor::init_pair()
   if (triclinic != old_triclinic) same = 0;
   if (pgsize != old_pgsize) same = 0;
   if (oneatom != old_oneatom) same = 0;
+  if (comm->nthreads != old_nthreads) same = 0;
 
   if (nrequest != old_nrequest) same = 0;
   else
@@ -1871,6 +1873,7 @@ void Neighbor::requests_new2old()
   old_triclinic = triclinic;
   old_pgsize = pgsize;
   old_oneatom = oneatom;
+  old_nthreads = comm->nthreads;
 }
 
 /* ----------------------------------------------------------------------
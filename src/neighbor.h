@@ -203,6 +203,7 @@ class Neighbor : protected Pointers {
 
   int old_style, old_triclinic;    // previous run info
   int old_pgsize, old_oneatom;     // used to avoid re-creating neigh lists
+  int old_nthreads;                // neigh list pages are allocated per thread
 
   int nstencil_perpetual;    // # of perpetual NeighStencil classes
   int npair_perpetual;       // #x of perpetual NeighPair classes
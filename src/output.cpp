@@ -95,6 +95,8 @@ Output::Output(LAMMPS *lmp) : Pointers(lmp)
   var_restart_single = var_restart_double = nullptr;
   restart = nullptr;
 
+  fix_file_flag = 1;
+
   dump_map = new DumpCreatorMap();
 
 #define DUMP_CLASS
@@ -120,7 +122,10 @@ Output::~Output()
   for (int i = 0; i < ndump; i++) delete[] var_dump[i];
   memory->sfree(var_dump);
   memory->destroy(ivar_dump);
-  for (int i = 0; i < ndump; i++) delete dump[i];
+  for (int i = 0; i < ndump; i++) {
+    dump[i]->async_wait();
+    delete dump[i];
+  }
   memory->sfree(dump);
 
   delete[] restart1;
@@ -807,6 +812,16 @@ void Output::modify_dump(int narg, char **arg)
   idump->modify_params(narg-1,&arg[1]);
 }
 
+/* ----------------------------------------------------------------------
+   wait until all dumps have finished writing their last snapshot
+   called at the end of a run, so files are complete and errors are reported
+------------------------------------------------------------------------- */
+
+void Output::async_wait()
+{
+  for (int i = 0; i < ndump; i++) dump[i]->async_wait();
+}
+
 /* ----------------------------------------------------------------------
    delete a Dump from list of Dumps
 ------------------------------------------------------------------------- */
@@ -819,6 +834,7 @@ void Output::delete_dump(const std::string &id)
   for (idump = 0; idump < ndump; idump++) if (id == dump[idump]->id) break;
   if (idump == ndump) error->all(FLERR,"Could not find undump ID: {}", id);
 
+  dump[idump]->async_wait();
   delete dump[idump];
   delete[] var_dump[idump];
 
@@ -1001,6 +1017,10 @@ void Output::create_restart(int narg, char **arg)
   restart = new WriteRestart(lmp);
   int iarg = nfile+1;
   restart->multiproc_options(multiproc,narg-iarg,&arg[iarg]);
+  if (nfile == 2 && restart->delta_every)
+    error->all(FLERR,"Cannot use restart delta when toggling between two restart files");
+  if (restart->delta_every && !strchr(arg[1],'*'))
+    error->all(FLERR,"Restart file name must contain '*' with restart delta");
 }
 
 /* ----------------------------------------------------------------------
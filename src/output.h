@@ -66,6 +66,8 @@ class Output : protected Pointers {
   char *restart2a, *restart2b;    // names of double restart files
   class WriteRestart *restart;    // class for writing restart files
 
+  int fix_file_flag;    // 0 if fixes like fix ave/time must not write to their files
+
   typedef Dump *(*DumpCreator)(LAMMPS *, int, char **);
   typedef std::map<std::string, DumpCreator> DumpCreatorMap;
   DumpCreatorMap *dump_map;
@@ -83,6 +85,7 @@ class Output : protected Pointers {
   Dump *add_dump(int, char **);                       // add a Dump to Dump list
   void modify_dump(int, char **);                     // modify a Dump
   void delete_dump(const std::string &);              // delete a Dump from Dump list
+  void async_wait();                                  // wait for dumps written in background
   Dump *get_dump_by_id(const std::string &) const;    // find a Dump by ID
   Dump *get_dump_by_index(int idx) const              // find a Dump by index in Dump list
   {
@@ -51,6 +51,7 @@ static constexpr double LB_FACTOR = 1.1;
 static constexpr int CHUNK = 1024;
 static constexpr int DELTA = 4;       // must be 2 or larger
 static constexpr int MAXBODY = 32;    // max # of lines in one body
+static constexpr int DATA_ENDIAN = 0x0001;    // also in WriteData
 
 // customize for new sections
 
@@ -87,14 +88,19 @@ static const char *labeltypes[] = {"Atom", "Bond", "Angle", "Dihedral", "Imprope
 
 // clang-format on
 /* ---------------------------------------------------------------------- */
-ReadData::ReadData(LAMMPS *_lmp) : Command(_lmp), fp(nullptr), coeffarg(nullptr), lmap(nullptr)
+ReadData::ReadData(LAMMPS *_lmp) :
+    Command(_lmp), fp(nullptr), colbuf(nullptr), rowbuf(nullptr), scounts(nullptr),
+    sdispls(nullptr), coeffarg(nullptr), lmap(nullptr)
 {
   MPI_Comm_rank(world, &me);
+  MPI_Comm_size(world, &nprocs);
   line = new char[MAXLINE];
   keyword = new char[MAXLINE];
   style = new char[MAXLINE];
   buffer = new char[CHUNK * MAXLINE];
   ncoeffarg = maxcoeffarg = 0;
+  binaryflag = 0;
+  maxcolbuf = maxrowbuf = 0;
 
   // customize for new sections
   // pointers to atom styles that store bonus info
@@ -117,6 +123,10 @@ ReadData::~ReadData()
   delete[] keyword;
   delete[] style;
   delete[] buffer;
+  memory->destroy(colbuf);
+  memory->destroy(rowbuf);
+  memory->destroy(scounts);
+  memory->destroy(sdispls);
   memory->sfree(coeffarg);
 
   for (int i = 0; i < nfix; i++) {
@@ -145,6 +155,7 @@ void ReadData::command(int narg, char **arg)
 
   addflag = NONE;
   coeffflag = 1;
+  parallelflag = 0;
   id_offset = mol_offset = 0;
   offsetflag = shiftflag = settypeflag = 0;
   tlabelflag = blabelflag = alabelflag = dlabelflag = ilabelflag = 0;
@@ -209,6 +220,10 @@ void ReadData::command(int narg, char **arg)
     } else if (strcmp(arg[iarg], "nocoeff") == 0) {
       coeffflag = 0;
       iarg++;
+    } else if (strcmp(arg[iarg], "parallel") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "read_data parallel", error);
+      parallelflag = utils::logical(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg], "extra/atom/types") == 0) {
       if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "read_data extra/atom/types", error);
       extra_atom_types = utils::inumeric(FLERR, arg[iarg + 1], false, lmp);
@@ -342,6 +357,8 @@ void ReadData::command(int narg, char **arg)
     error->all(FLERR, "Cannot use read_data without add keyword after simulation box is defined");
   if (!domain->box_exist && addflag)
     error->all(FLERR, "Cannot use read_data add before simulation box is defined");
+  if (parallelflag && addflag)
+    error->all(FLERR, "Cannot use read_data parallel yes together with the add keyword");
   if (offsetflag) {
     if (addflag == NONE) {
       error->all(FLERR, "Cannot use read_data offset without add keyword");
@@ -706,13 +723,17 @@ void ReadData::command(int narg, char **arg)
                 FLERR, "Atom style in data file {} differs from currently defined atom style {}",
                 style, atom->atom_style);
           atoms();
-        } else
+        } else if (binaryflag)
+          skip_blocks(natoms);
+        else
           skip_lines(natoms);
 
       } else if (strcmp(keyword, "Velocities") == 0) {
         if (atomflag == 0) error->all(FLERR, "Must read Atoms before Velocities");
         if (firstpass)
           velocities();
+        else if (binaryflag)
+          skip_blocks(natoms);
         else
           skip_lines(natoms);
 
@@ -1242,10 +1263,13 @@ void ReadData::header(int firstpass)
   }
 
   // skip 1st line of file
+  // a binary data file is recognized by the first line written by write_data
 
+  binaryflag = 0;
   if (me == 0) {
     char *eof = utils::fgets_trunc(line, MAXLINE, fp);
     if (eof == nullptr) error->one(FLERR, "Unexpected end of data file");
+    if (utils::strmatch(line, "^LAMMPS binary data file")) binaryflag = 1;
 
     // check for units keyword in first line and print warning on mismatch
 
@@ -1256,6 +1280,7 @@ void ReadData::header(int firstpass)
                        update->unit_style, units[2]);
     }
   }
+  MPI_Bcast(&binaryflag, 1, MPI_INT, 0, world);
 
   while (true) {
 
@@ -1521,6 +1546,21 @@ void ReadData::atoms()
 
   bigint nread = 0;
 
+  // binary blocks are scattered across procs in parallel mode
+
+  if (binaryflag) {
+    int ncol = atom->avec->size_data_atom + 3;
+    bigint nblock;
+    while (nread < natoms) {
+      int nrow = read_block(ncol, natoms - nread, "Atoms", parallelflag, nblock);
+      if (tlabelflag && !lmap->is_complete(Atom::ATOM))
+        error->all(FLERR, "Label map is incomplete: all types must be assigned a unique type label");
+      atom->data_atoms_binary(nrow, rowbuf, id_offset, mol_offset, toffset, shiftflag, shift,
+                              tlabelflag, lmap->lmap2lmap.atom, triclinic_general, parallelflag);
+      nread += nblock;
+    }
+  }
+
   while (nread < natoms) {
     nchunk = MIN(natoms - nread, CHUNK);
     eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
@@ -1528,10 +1568,33 @@ void ReadData::atoms()
     if (tlabelflag && !lmap->is_complete(Atom::ATOM))
       error->all(FLERR, "Label map is incomplete: all types must be assigned a unique type label");
     atom->data_atoms(nchunk, buffer, id_offset, mol_offset, toffset,
-                     shiftflag, shift, tlabelflag, lmap->lmap2lmap.atom, triclinic_general);
+                     shiftflag, shift, tlabelflag, lmap->lmap2lmap.atom, triclinic_general,
+                     parallelflag, nread);
     nread += nchunk;
   }
 
+  // with parallel parsing each proc kept the atoms from its share of the lines or rows,
+  // so migrate them to the procs owning their sub-domain via irregular()
+  // first do map_init() since irregular->migrate_atoms() will do map_clear()
+  // image flag resets were also only seen by the proc that parsed the line
+
+  if (parallelflag) {
+    if (atom->map_style != Atom::MAP_NONE) {
+      atom->map_init();
+      atom->map_set();
+    }
+    if (domain->triclinic) domain->x2lamda(atom->nlocal);
+    auto irregular = new Irregular(lmp);
+    irregular->migrate_atoms(1);
+    delete irregular;
+    if (domain->triclinic) domain->lamda2x(atom->nlocal);
+
+    int flag[3], flagall[3];
+    for (int i = 0; i < 3; i++) flag[i] = atom->reset_image_flag[i] ? 1 : 0;
+    MPI_Allreduce(flag, flagall, 3, MPI_INT, MPI_MAX, world);
+    for (int i = 0; i < 3; i++) atom->reset_image_flag[i] = flagall[i] != 0;
+  }
+
   // warn if we have read data with non-zero image flags for non-periodic boundaries.
   // we may want to turn this into an error at some point, since this essentially
   // creates invalid position information that works by accident most of the time.
@@ -1593,6 +1656,10 @@ void ReadData::velocities()
   if (!atom->tag_enable) {
     if (me == 0) utils::logmesg(lmp, "  skipping velocities without atom IDs ...\n");
 
+    if (binaryflag) {
+      skip_blocks(natoms);
+      return;
+    }
     while (nread < natoms) {
       nchunk = MIN(natoms - nread, CHUNK);
       eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
@@ -1611,11 +1678,22 @@ void ReadData::velocities()
     atom->map_set();
   }
 
+  // binary blocks are always broadcast since the owner of a row is only known via the map
+
+  if (binaryflag) {
+    bigint nblock;
+    while (nread < natoms) {
+      int nrow = read_block(atom->avec->size_data_vel, natoms - nread, "Velocities", 0, nblock);
+      atom->data_vels_binary(nrow, rowbuf, id_offset);
+      nread += nblock;
+    }
+  }
+
   while (nread < natoms) {
     nchunk = MIN(natoms - nread, CHUNK);
     eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
     if (eof) error->all(FLERR, "Unexpected end of data file");
-    atom->data_vels(nchunk, buffer, id_offset);
+    atom->data_vels(nchunk, buffer, id_offset, parallelflag);
     nread += nchunk;
   }
 
@@ -2534,6 +2612,103 @@ void ReadData::skip_lines(bigint n)
   if (eof == nullptr) error->one(FLERR, "Unexpected end of data file");
 }
 
+/* ----------------------------------------------------------------------
+   read one block of per-atom values from a binary data file
+   proc 0 reads the block header and the ncol columns of the block
+     and transposes them into rows of ncol values in rowbuf
+   if scatter is set, rows are split into contiguous ranges across procs
+   else all rows are broadcast to all procs
+   nmax = max # of rows still expected in this section
+   return # of rows in rowbuf of this proc, nblock = # of rows in block
+------------------------------------------------------------------------- */
+
+int ReadData::read_block(int ncol, bigint nmax, const char *section, int scatter, bigint &nblock)
+{
+  int header[2];
+
+  nblock = 0;
+  if (me == 0) {
+    if ((fread(&nblock, sizeof(bigint), 1, fp) != 1) || (fread(header, sizeof(int), 2, fp) != 2))
+      error->one(FLERR, "Unexpected end of data file in binary {} section", section);
+    if (header[1] != DATA_ENDIAN)
+      error->one(FLERR, "Binary data file has incompatible byte order");
+    if (header[0] != ncol)
+      error->one(FLERR, "Incorrect number of columns {} in binary {} section of data file, "
+                 "expected {}", header[0], section, ncol);
+    if ((nblock <= 0) || (nblock > nmax) || (nblock * ncol > MAXSMALLINT))
+      error->one(FLERR, "Invalid block size {} in binary {} section of data file", nblock, section);
+
+    if (nblock * ncol > maxcolbuf) {
+      maxcolbuf = nblock * ncol;
+      memory->destroy(colbuf);
+      memory->create(colbuf, maxcolbuf, "read_data:colbuf");
+    }
+    if (fread(colbuf, sizeof(double), nblock * ncol, fp) != (std::size_t) (nblock * ncol))
+      error->one(FLERR, "Unexpected end of data file in binary {} section", section);
+  }
+  MPI_Bcast(&nblock, 1, MPI_LMP_BIGINT, 0, world);
+
+  int nrow = nblock;
+  if (nblock * ncol > maxrowbuf) {
+    maxrowbuf = nblock * ncol;
+    memory->destroy(rowbuf);
+    memory->create(rowbuf, maxrowbuf, "read_data:rowbuf");
+  }
+
+  if (me == 0) {
+    for (int j = 0; j < ncol; j++)
+      for (int i = 0; i < nrow; i++) rowbuf[i * ncol + j] = colbuf[j * nrow + i];
+  }
+
+  if (!scatter) {
+    MPI_Bcast(rowbuf, nrow * ncol, MPI_DOUBLE, 0, world);
+    return nrow;
+  }
+
+  if (!scounts) {
+    memory->create(scounts, nprocs, "read_data:scounts");
+    memory->create(sdispls, nprocs, "read_data:sdispls");
+  }
+  int offset = 0;
+  for (int iproc = 0; iproc < nprocs; iproc++) {
+    int n = nrow / nprocs + ((iproc < nrow % nprocs) ? 1 : 0);
+    scounts[iproc] = n * ncol;
+    sdispls[iproc] = offset;
+    offset += n * ncol;
+  }
+  MPI_Scatterv(rowbuf, scounts, sdispls, MPI_DOUBLE, (me == 0) ? MPI_IN_PLACE : rowbuf,
+               scounts[me], MPI_DOUBLE, 0, world);
+  return scounts[me] / ncol;
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 reads past binary blocks with a total of N rows
+   data is read rather than skipped via fseek() so this also works with pipes
+------------------------------------------------------------------------- */
+
+void ReadData::skip_blocks(bigint n)
+{
+  if (me) return;
+
+  bigint nblock;
+  int header[2];
+  const bigint nbuf = CHUNK * MAXLINE;
+
+  while (n > 0) {
+    if ((fread(&nblock, sizeof(bigint), 1, fp) != 1) || (fread(header, sizeof(int), 2, fp) != 2))
+      error->one(FLERR, "Unexpected end of data file");
+    if ((nblock <= 0) || (nblock > n) || (header[1] != DATA_ENDIAN))
+      error->one(FLERR, "Invalid block in binary data file");
+    bigint nbytes = nblock * header[0] * sizeof(double);
+    while (nbytes > 0) {
+      std::size_t nskip = MIN(nbytes, nbuf);
+      if (fread(buffer, 1, nskip, fp) != nskip) error->one(FLERR, "Unexpected end of data file");
+      nbytes -= nskip;
+    }
+    n -= nblock;
+  }
+}
+
 /* ----------------------------------------------------------------------
    parse a line of coeffs into words, storing them in ncoeffarg,coeffarg
    trim anything from '#' onward
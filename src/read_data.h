@@ -32,9 +32,12 @@ class ReadData : public Command {
   static bool is_data_section(const std::string &);
 
  private:
-  int me, compressed;
+  int me, nprocs, compressed, binaryflag;
   char *line, *keyword, *buffer, *style;
   FILE *fp;
+  double *colbuf, *rowbuf;    // column and row buffers for binary data file blocks
+  bigint maxcolbuf, maxrowbuf;
+  int *scounts, *sdispls;
   char **coeffarg;
   int ncoeffarg, maxcoeffarg;
   std::string argoffset1, argoffset2;
@@ -72,7 +75,7 @@ class ReadData : public Command {
 
   // optional args
 
-  int addflag, offsetflag, shiftflag, coeffflag, settypeflag;
+  int addflag, offsetflag, shiftflag, coeffflag, settypeflag, parallelflag;
   int tlabelflag, blabelflag, alabelflag, dlabelflag, ilabelflag;
   tagint addvalue;
   int toffset, boffset, aoffset, doffset, ioffset;
@@ -94,6 +97,8 @@ class ReadData : public Command {
   void header(int);
   void parse_keyword(int);
   void skip_lines(bigint);
+  int read_block(int, bigint, const char *, int, bigint &);
+  void skip_blocks(bigint);
   void parse_coeffs(char *, const char *, int, int, int, int, int *);
   int style_match(const char *, const char *);
 
@@ -235,6 +235,12 @@ void ReadDump::setup_reader(int narg, char **arg)
 
   } else error->all(FLERR, utils::check_packages_for_style("reader", readerstyle, lmp));
 
+  if (indexflag) {
+    if ((strcmp(readerstyle,"native") != 0) && (strcmp(readerstyle,"quant") != 0))
+      error->all(FLERR,"Read_dump index option requires native or quant format");
+    for (int i = 0; i < nreader; i++) readers[i]->indexflag = 1;
+  }
+
   if (utils::strmatch(readerstyle, "^adios")) {
       // everyone is a reader with adios
       parallel = 1;
@@ -274,6 +280,7 @@ bigint ReadDump::seek(bigint nrequest, int exact)
         multiname.replace(multiname.find('%'),1,"0");
         readers[0]->open_file(multiname);
       } else readers[0]->open_file(files[ifile]);
+      readers[0]->seek_index(nrequest);
 
       while (true) {
         eofflag = readers[0]->read_time(ntimestep);
@@ -317,6 +324,7 @@ bigint ReadDump::seek(bigint nrequest, int exact)
       std::string multiname = files[currentfile];
       multiname.replace(multiname.find('%'),1,fmt::format("{}",firstfile+i));
       readers[i]->open_file(multiname);
+      readers[i]->seek_index(ntimestep);
 
       bigint step;
       while (true) {
@@ -365,6 +373,7 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
           multiname.replace(multiname.find('%'),1,"0");
           readers[0]->open_file(multiname);
         } else readers[0]->open_file(files[ifile]);
+        readers[0]->seek_index(ncurrent+1);
       }
 
       while (true) {
@@ -418,6 +427,7 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
       std::string multiname = files[currentfile];
       multiname.replace(multiname.find('%'),1,fmt::format("{}",firstfile+i));
       readers[i]->open_file(multiname);
+      readers[i]->seek_index(ntimestep);
 
       bigint step;
       while (true) {
@@ -1194,6 +1204,7 @@ int ReadDump::fields_and_keywords(int narg, char **arg)
   trimflag = 0;
   addflag = NOADD;
   for (int i = 0; i < nfield; i++) fieldlabel[i] = nullptr;
+  indexflag = 0;
   scaleflag = 0;
   wrapflag = 1;
 
@@ -1240,6 +1251,10 @@ int ReadDump::fields_and_keywords(int narg, char **arg)
       if (i == nfield) error->all(FLERR,"Illegal read_dump command");
       fieldlabel[i] = utils::strdup(arg[iarg+2]);
       iarg += 3;
+    } else if (strcmp(arg[iarg],"index") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "read_dump index", error);
+      indexflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"scaled") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "read_dump scaled", error);
       scaleflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
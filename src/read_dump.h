@@ -62,6 +62,7 @@ class ReadDump : public Command {
   int timestepflag;            // overwrite simulation timestep with dump file timestep
   int replaceflag, addflag;    // flags for processing dump snapshot atoms
   int trimflag, purgeflag;
+  int indexflag;        // 1 if readers use a frame index of dump files
   int scaleflag;        // user 0/1 if dump file coords are unscaled/scaled
   int wrapflag;         // user 0/1 if dump file coords are unwrapped/wrapped
   char *readerstyle;    // style of dump files to read
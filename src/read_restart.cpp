@@ -36,14 +36,23 @@
 #include "update.h"
 
 #include <cstring>
+#include <unordered_map>
+#include <vector>
 
 #include "lmprestart.h"
 
+#if defined(LAMMPS_ZLIB)
+#include <zlib.h>
+#endif
+
 using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-ReadRestart::ReadRestart(LAMMPS *lmp) : Command(lmp) {}
+ReadRestart::ReadRestart(LAMMPS *lmp) :
+    Command(lmp), delta_offset(0), delta_nchunk(0), delta_zlib(0)
+{
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -158,6 +167,11 @@ void ReadRestart::command(int narg, char **arg)
 
   file_layout();
 
+  // only delta files use the delta format revision
+
+  if ((revision == DELTA_FORMAT_REVISION) != !delta_base.empty())
+    error->all(FLERR,"Restart file format revision {} does not match delta information", revision);
+
   // close header file if in multiproc mode
 
   if (multiproc && me == 0) {
@@ -173,6 +187,25 @@ void ReadRestart::command(int narg, char **arg)
   double *buf = nullptr;
   int m,flag;
 
+  // single native file is read in parallel, if all procs can open it
+
+  int parallel = 0;
+  if (multiproc == 0 && delta_base.empty() && nprocs > 1) parallel = parallel_open(file);
+
+  // input of delta file and the base file it refers to
+
+  if (!delta_base.empty()) {
+    delta_atoms(file);
+  }
+
+  // input of single native file by all procs
+  // each proc reads a balanced subset of per-proc chunks directly from file
+  // and keeps all atoms in them, they are migrated to the correct procs below
+
+  else if (parallel) {
+    parallel_atoms();
+  }
+
   // input of single native file
   // nprocs_file = # of chunks in file
   // proc 0 reads a chunk and bcasts it to other procs
@@ -180,7 +213,7 @@ void ReadRestart::command(int narg, char **arg)
   // if remapflag set, remap the atom to box before checking sub-domain
   // check for atom in sub-domain differs for orthogonal vs triclinic box
 
-  if (multiproc == 0) {
+  else if (multiproc == 0) {
 
     int triclinic = domain->triclinic;
     imageint *iptr;
@@ -376,10 +409,10 @@ void ReadRestart::command(int narg, char **arg)
   delete[] file;
   memory->destroy(buf);
 
-  // for multiproc or MPI-IO files:
+  // for multiproc, delta, or parallel read files:
   // perform irregular comm to migrate atoms to correct procs
 
-  if (multiproc) {
+  if (multiproc || parallel || !delta_base.empty()) {
 
     // if remapflag set, remap all atoms I read back to box before migrating
 
@@ -573,7 +606,7 @@ void ReadRestart::header()
 
       // we have no forward compatibility, thus exit with error
 
-      if (revision > FORMAT_REVISION)
+      if (revision > DELTA_FORMAT_REVISION)
         error->all(FLERR,"Restart file format revision incompatible with current LAMMPS version");
 
       // warn when attempting to read older format revision
@@ -964,11 +997,210 @@ void ReadRestart::file_layout()
         error->all(FLERR,"Restart file is not a multi-proc file");
       if (multiproc && multiproc_file == 0)
         error->all(FLERR,"Restart file is a multi-proc file");
+    } else if (flag == DELTA_BASE) {
+      char *str = read_string();
+      delta_base = str;
+      delete[] str;
+    } else if (flag == DELTA_OFFSET) {
+      delta_offset = read_bigint();
+    } else if (flag == DELTA_NCHUNK) {
+      delta_nchunk = read_int();
+    } else if (flag == DELTA_ZLIB) {
+      delta_zlib = read_int();
+#if !defined(LAMMPS_ZLIB)
+      if (delta_zlib)
+        error->all(FLERR,"Restart delta file is zlib compressed, "
+                   "but LAMMPS was built without zlib support");
+#endif
     }
     flag = read_int();
   }
 }
 
+/* ----------------------------------------------------------------------
+   read per-atom data of a delta file and of the base file it refers to
+   look for base file next to delta file, if it does not exist as stored
+   proc 0 reads chunks and bcasts them, each proc keeps atoms with ID % nprocs = me
+   so every proc receives the per-atom data of both files once
+   chunks of delta file are uncompressed first, if they were zlib compressed
+   atom data is the base data with the values flagged in the mask XORed
+     bitwise with the stored values
+   atoms are migrated to the correct procs by the caller
+------------------------------------------------------------------------- */
+
+void ReadRestart::delta_atoms(const std::string &file)
+{
+  AtomVec *avec = atom->avec;
+  std::vector<double> chunk, base_buf, atombuf, delta;
+  std::unordered_map<tagint, bigint> base_index;
+
+  FILE *deltafp = fp;
+  fp = nullptr;
+  if (me == 0) {
+    fp = fopen(delta_base.c_str(),"rb");
+    if (fp == nullptr) {
+      auto altfile = platform::path_join(platform::path_dirname(file),
+                                         platform::path_basename(delta_base));
+      fp = fopen(altfile.c_str(),"rb");
+    }
+    if (fp == nullptr)
+      error->one(FLERR,"Cannot open restart base file {}: {}", delta_base, utils::getsyserror());
+    utils::logmesg(lmp,"  reading base file {}\n", delta_base);
+    platform::fseek(fp,delta_offset);
+  }
+
+  for (int iproc = 0; iproc < delta_nchunk; iproc++) {
+    if (read_int() != PERPROC)
+      error->all(FLERR,"Invalid flag in peratom section of restart base file");
+    int n = read_int();
+    chunk.resize(n);
+    read_double_vec(n,chunk.data());
+
+    for (int m = 0; m < n; m += static_cast<int> (chunk[m])) {
+      auto tag = (tagint) ubuf(chunk[m+4]).i;
+      if (tag % nprocs != me) continue;
+      base_index[tag] = base_buf.size();
+      base_buf.insert(base_buf.end(),&chunk[m],&chunk[m] + static_cast<int> (chunk[m]));
+    }
+  }
+
+  if (me == 0) fclose(fp);
+  fp = deltafp;
+
+  for (int iproc = 0; iproc < nprocs_file; iproc++) {
+    if (read_int() != PERPROC)
+      error->all(FLERR,"Invalid flag in peratom section of restart file");
+    int n = read_int();
+    chunk.resize(n);
+    read_double_vec(n,chunk.data());
+
+    // compressed chunk: # of uncompressed values, # of compressed bytes, bytes
+
+    if (delta_zlib) {
+#if defined(LAMMPS_ZLIB)
+      if (n < 2) error->one(FLERR,"Invalid compressed chunk in restart delta file");
+      n = (int) ubuf(chunk[0]).i;
+      delta.resize(n);
+      uLongf nbytes = (uLongf) n * sizeof(double);
+      if (n && ((uncompress((Bytef *) delta.data(),&nbytes,(const Bytef *) &chunk[2],
+                            (uLong) ubuf(chunk[1]).i) != Z_OK) ||
+                (nbytes != (uLongf) n * sizeof(double))))
+        error->one(FLERR,"Invalid compressed chunk in restart delta file");
+      chunk.swap(delta);
+#endif
+    }
+
+    for (int m = 0; m < n; m += static_cast<int> (chunk[m])) {
+      auto tag = (tagint) ubuf(chunk[m+1]).i;
+      if (tag % nprocs != me) continue;
+
+      auto nword = (int) ubuf(chunk[m+2]).i;
+      if (nword == 0) {
+        avec->unpack_restart(&chunk[m+3]);
+        continue;
+      }
+
+      auto it = base_index.find(tag);
+      if (it == base_index.end())
+        error->one(FLERR,"Atom {} in restart delta file is missing in base file", tag);
+      const double *base = &base_buf[it->second];
+      atombuf.assign(base,base + static_cast<int> (base[0]));
+
+      const double *mask = &chunk[m+3];
+      const double *value = mask + nword;
+      for (int i = 0; i < (int) atombuf.size(); i++)
+        if (((uint64_t) ubuf(mask[i/64]).i >> (i % 64)) & 1)
+          atombuf[i] = ubuf(ubuf(atombuf[i]).i ^ ubuf(*value++).i).d;
+      avec->unpack_restart(atombuf.data());
+    }
+  }
+
+  if (me == 0) {
+    fclose(fp);
+    fp = nullptr;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   open single restart file on all procs in addition to proc 0
+   return 1 if all procs could open it, else close it again and return 0
+------------------------------------------------------------------------- */
+
+int ReadRestart::parallel_open(const std::string &file)
+{
+  int flag = 0;
+  if (me != 0) {
+    fp = fopen(file.c_str(),"rb");
+    if (fp == nullptr) flag = 1;
+  }
+
+  int flagall;
+  MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,world);
+  if (flagall == 0) return 1;
+
+  if (me != 0 && fp) {
+    fclose(fp);
+    fp = nullptr;
+  }
+  if (me == 0)
+    error->warning(FLERR,"Restart file {} is not accessible from all procs, "
+                   "reading it on proc 0", file);
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   read per-atom data of single restart file in parallel
+   proc 0 skips through per-proc chunks to find their offsets and sizes
+   chunk I is read by proc P, if its data starts in the P-th part of all data
+   each proc reads its chunks directly from file and keeps all atoms in them
+------------------------------------------------------------------------- */
+
+void ReadRestart::parallel_atoms()
+{
+  std::vector<bigint> offset(nprocs_file);
+  std::vector<int> size(nprocs_file);
+
+  if (me == 0) {
+    int flag,n;
+    for (int iproc = 0; iproc < nprocs_file; iproc++) {
+      utils::sfread(FLERR,&flag,sizeof(int),1,fp,nullptr,error);
+      if (flag != PERPROC)
+        error->one(FLERR,"Invalid flag in peratom section of restart file");
+      utils::sfread(FLERR,&n,sizeof(int),1,fp,nullptr,error);
+      offset[iproc] = platform::ftell(fp);
+      size[iproc] = n;
+      if (platform::fseek(fp,offset[iproc] + (bigint) n*sizeof(double)))
+        error->one(FLERR,"Unexpected end of restart file");
+    }
+  }
+  MPI_Bcast(offset.data(),nprocs_file,MPI_LMP_BIGINT,0,world);
+  MPI_Bcast(size.data(),nprocs_file,MPI_INT,0,world);
+
+  bigint total = 0;
+  for (int iproc = 0; iproc < nprocs_file; iproc++) total += size[iproc];
+
+  AtomVec *avec = atom->avec;
+  std::vector<double> buf;
+  bigint start = 0;
+
+  for (int iproc = 0; iproc < nprocs_file; iproc++) {
+    int reader = static_cast<int> (start * nprocs / MAX(total,1));
+    start += size[iproc];
+    if (reader != me || size[iproc] == 0) continue;
+
+    buf.resize(size[iproc]);
+    if (platform::fseek(fp,offset[iproc]))
+      error->one(FLERR,"Unexpected end of restart file");
+    utils::sfread(FLERR,buf.data(),sizeof(double),size[iproc],fp,nullptr,error);
+
+    int m = 0;
+    while (m < size[iproc]) m += avec->unpack_restart(&buf[m]);
+  }
+
+  fclose(fp);
+  fp = nullptr;
+}
+
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
 // low-level fread methods
@@ -39,6 +39,11 @@ class ReadRestart : public Command {
   int nprocs_file;       // total # of procs that wrote restart file
   int revision;          // revision number of the restart file format
 
+  std::string delta_base;    // base file of a delta restart file, empty if none
+  bigint delta_offset;       // position of per-atom data in base file
+  int delta_nchunk;          // # of per-proc chunks in base file
+  int delta_zlib;            // 1 if per-proc chunks of delta file are zlib compressed
+
   std::string file_search(const std::string &);
   void header();
   void type_arrays();
@@ -49,6 +54,9 @@ class ReadRestart : public Command {
   void format_revision();
   void check_eof_magic();
   void file_layout();
+  void delta_atoms(const std::string &);
+  int parallel_open(const std::string &);
+  void parallel_atoms();
 
   int read_int();
   bigint read_bigint();
@@ -14,9 +14,35 @@
 #include "reader.h"
 
 #include "error.h"
+#include "tokenizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <sys/stat.h>
 
 using namespace LAMMPS_NS;
 
+static constexpr int MAXLINE = 256;
+
+/* ----------------------------------------------------------------------
+   return modification time of file in seconds, -1 if it cannot be determined
+------------------------------------------------------------------------- */
+
+static bigint file_mtime(const std::string &file)
+{
+#if defined(_WIN32)
+  struct _stat info;
+  memset(&info, 0, sizeof(info));
+  if (_stat(file.c_str(), &info) != 0) return -1;
+#else
+  struct stat info;
+  memset(&info, 0, sizeof(info));
+  if (stat(file.c_str(), &info) != 0) return -1;
+#endif
+  return (bigint) info.st_mtime;
+}
+
 // only proc 0 calls methods of this class, except for constructor/destructor
 
 /* ---------------------------------------------------------------------- */
@@ -26,6 +52,10 @@ Reader::Reader(LAMMPS *lmp) : Pointers(lmp)
   fp = nullptr;
   binary = false;
   compressed = false;
+  indexflag = 0;
+  has_index = false;
+  file_size = 0;
+  file_time = -1;
 }
 
 // avoid resource leak
@@ -59,6 +89,9 @@ void Reader::open_file(const std::string &file)
   }
 
   if (!fp) error->one(FLERR, "Cannot open file {}: {}", file, utils::getsyserror());
+
+  has_index = false;
+  if (indexflag && !compressed) build_index(file);
 }
 
 /* ----------------------------------------------------------------------
@@ -74,6 +107,7 @@ void Reader::close_file()
   else
     fclose(fp);
   fp = nullptr;
+  has_index = false;
 }
 
 /* ----------------------------------------------------------------------
@@ -84,3 +118,130 @@ void Reader::settings(int narg, char ** /*args*/)
 {
   if (narg > 0) error->all(FLERR, "Illegal read_dump command");
 }
+
+/* ----------------------------------------------------------------------
+   build index of timesteps and file positions of all frames in file
+   use index cached in file.index, if it matches the size and mtime of file
+   else scan file with read_time() and skip() and try to cache the index
+------------------------------------------------------------------------- */
+
+void Reader::build_index(const std::string &file)
+{
+  platform::fseek(fp, platform::END_OF_FILE);
+  file_size = platform::ftell(fp);
+  platform::fseek(fp, 0);
+  file_time = file_mtime(file);
+
+  const std::string indexfile = file + ".index";
+  if (read_index(indexfile)) {
+    has_index = true;
+    return;
+  }
+
+  frame_step.clear();
+  frame_offset.clear();
+  bigint ntimestep;
+  while (true) {
+    bigint pos = platform::ftell(fp);
+    if (read_time(ntimestep)) break;
+    frame_step.push_back(ntimestep);
+    frame_offset.push_back(pos);
+    skip();
+  }
+  clearerr(fp);
+  platform::fseek(fp, 0);
+  has_index = true;
+
+  write_index(indexfile);
+}
+
+/* ----------------------------------------------------------------------
+   read cached frame index, return false if it is missing or does not match
+------------------------------------------------------------------------- */
+
+bool Reader::read_index(const std::string &indexfile)
+{
+  FILE *ifp = fopen(indexfile.c_str(), "r");
+  if (!ifp) return false;
+
+  frame_step.clear();
+  frame_offset.clear();
+  char line[MAXLINE];
+  bool valid = false;
+
+  try {
+    if (fgets(line, MAXLINE, ifp)) {
+      ValueTokenizer header(line);
+      if ((header.next_string() == "#") && (header.next_string() == "LAMMPS")) {
+        header.skip(3);
+        const bigint nframes = header.next_bigint();
+        header.skip(3);
+        const bigint size = header.next_bigint();
+        header.skip(1);
+        const bigint mtime = header.next_bigint();
+        if ((size == file_size) && (mtime == file_time) && (file_time >= 0)) {
+          while (fgets(line, MAXLINE, ifp)) {
+            ValueTokenizer values(line);
+            frame_step.push_back(values.next_bigint());
+            frame_offset.push_back(values.next_bigint());
+          }
+          valid = ((bigint) frame_step.size() == nframes);
+
+          // frame positions must be increasing and inside the file
+
+          for (std::size_t i = 0; valid && (i < frame_offset.size()); ++i)
+            if ((frame_offset[i] >= file_size) || (i && (frame_offset[i] <= frame_offset[i - 1])))
+              valid = false;
+        }
+      }
+    }
+  } catch (std::exception &) {
+    valid = false;
+  }
+  fclose(ifp);
+  return valid;
+}
+
+/* ----------------------------------------------------------------------
+   write frame index to file, silently skip if file cannot be written
+------------------------------------------------------------------------- */
+
+void Reader::write_index(const std::string &indexfile)
+{
+  FILE *ifp = fopen(indexfile.c_str(), "w");
+  if (!ifp) return;
+
+  fmt::print(ifp, "# LAMMPS dump frame index: {} frames, file size {} mtime {}\n",
+             frame_step.size(), file_size, file_time);
+  for (std::size_t i = 0; i < frame_step.size(); ++i)
+    fmt::print(ifp, "{} {}\n", frame_step[i], frame_offset[i]);
+  fclose(ifp);
+}
+
+/* ----------------------------------------------------------------------
+   position file at first frame with timestep >= nrequest or at end of file
+   no-op if there is no frame index
+------------------------------------------------------------------------- */
+
+void Reader::seek_index(bigint nrequest)
+{
+  if (!has_index) return;
+
+  std::size_t i = 0;
+  while ((i < frame_step.size()) && (frame_step[i] < nrequest)) ++i;
+  platform::fseek(fp, (i < frame_step.size()) ? frame_offset[i] : file_size);
+}
+
+/* ----------------------------------------------------------------------
+   skip rest of current frame by positioning file at next frame
+   return false if there is no frame index, so caller must skip frame itself
+------------------------------------------------------------------------- */
+
+bool Reader::skip_index()
+{
+  if (!has_index) return false;
+
+  auto next = std::upper_bound(frame_offset.begin(), frame_offset.end(), platform::ftell(fp));
+  platform::fseek(fp, (next != frame_offset.end()) ? *next : file_size);
+  return true;
+}
@@ -18,6 +18,8 @@
 
 #include "pointers.h"
 
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class Reader : protected Pointers {
@@ -39,10 +41,25 @@ class Reader : protected Pointers {
   virtual void open_file(const std::string &);
   virtual void close_file();
 
+  void seek_index(bigint);
+
+  int indexflag;    // 1 if frame index of dump file is built and used
+
  protected:
   FILE *fp;           // pointer to opened file or pipe
   bool compressed;    // flag for dump file compression
   bool binary;        // flag for (native) binary files
+
+  bool has_index;                     // true if frame index for current file exists
+  bigint file_size;                   // size of current file in bytes
+  bigint file_time;                   // modification time of current file in seconds
+  std::vector<bigint> frame_step;     // timestep of each frame in current file
+  std::vector<bigint> frame_offset;   // file position of each frame in current file
+
+  void build_index(const std::string &);
+  bool read_index(const std::string &);
+  void write_index(const std::string &);
+  bool skip_index();
 };
 
 }    // namespace LAMMPS_NS
@@ -20,7 +20,6 @@
 
 #include <cstring>
 #include <exception>
-#include <utility>
 
 using namespace LAMMPS_NS;
 
@@ -109,6 +108,8 @@ int ReaderNative::read_time(bigint &ntimestep)
 
 void ReaderNative::skip()
 {
+  if (skip_index()) return;
+
   if (binary) {
     int triclinic;
     skip_buf(sizeof(bigint));
@@ -217,6 +218,9 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
 
     if (!fieldinfo) {
       skip_reading_magic_str();
+      read_buf(&nchunk, sizeof(int), 1);
+      ichunk = 0;
+      iatom_chunk = 0;
       return natoms;
     }
 
@@ -289,7 +293,25 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
     labelline = line + strlen("ITEM: ATOMS ");
   }
 
-  Tokenizer tokens(std::move(labelline));
+  if (!match_fields(labelline, nfield, fieldtype, fieldlabel, scaleflag, wrapflag, fieldflag,
+                    xflag, yflag, zflag))
+    return 1;
+
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   match Nfield fields to per-atom column labels in labelline
+   allocate and set fieldindex = which column each field maps to
+   set xyz flags and fieldflag as described for read_header()
+   return false if there are no column labels
+------------------------------------------------------------------------- */
+
+bool ReaderNative::match_fields(const std::string &labelline, int nfield, int *fieldtype,
+                                char **fieldlabel, int scaleflag, int wrapflag, int &fieldflag,
+                                int &xflag, int &yflag, int &zflag)
+{
+  Tokenizer tokens(labelline);
   std::map<std::string, int> labels;
   nwords = 0;
 
@@ -299,7 +321,7 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
 
 
   if (nwords == 0) {
-    return 1;
+    return false;
   }
 
   // match each field with a column of per-atom data
@@ -427,7 +449,7 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
   for (int i = 0; i < nfield; i++)
     if (fieldindex[i] < 0) fieldflag = -1;
 
-  return natoms;
+  return true;
 }
 
 /* ----------------------------------------------------------------------
@@ -40,7 +40,7 @@ class ReaderNative : public Reader {
                      int &, int &) override;
   void read_atoms(int, int, double **) override;
 
- private:
+ protected:
   int revision;
 
   std::string magic_string;
@@ -59,6 +59,8 @@ class ReaderNative : public Reader {
   int iatom_chunk;    // index of current atom in the current chunk
 
   int find_label(const std::string &label, const std::map<std::string, int> &labels);
+  bool match_fields(const std::string &, int, int *, char **, int, int, int &, int &, int &,
+                    int &);
   void read_lines(int);
 
   void read_buf(void *, size_t, size_t);
@@ -315,7 +315,7 @@ void Respa::init()
 
   // detect if fix omp is present and will clear force arrays
 
-  if (modify->get_fix_by_id("package_omp")) external_force_clear = 1;
+  external_force_clear = modify->get_fix_by_id("package_omp") ? 1 : 0;
 
   // set flags for arrays to clear in force_clear()
 
@@ -67,7 +67,7 @@ using namespace MathExtra;
 // cella, cellb, cellc, cellalpha, cellbeta, cellgamma
 // pxx, pyy, pzz, pxy, pxz, pyz
 // bonds, angles, dihedrals, impropers
-// fmax, fnorm, nbuild, ndanger
+// fmax, fnorm, nbuild, ndanger, memlive, mempeak
 
 // CUSTOMIZATION: add a new thermo style by adding a constant to the enumerator,
 // define a new string constant with the keywords and provide default formats.
@@ -390,20 +390,26 @@ void Thermo::compute(int flag)
     normflag = normvalue;
 
   // invoke Compute methods needed for thermo keywords
+  // global sums of computes that support deferred reduction are done first
+
+  reduce_computes();
 
   for (i = 0; i < ncompute; i++)
     if (compute_which[i] == SCALAR) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_SCALAR)) {
+        Timer::Instance timing(timer, computes[i]);
         computes[i]->compute_scalar();
         computes[i]->invoked_flag |= Compute::INVOKED_SCALAR;
       }
     } else if (compute_which[i] == VECTOR) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_VECTOR)) {
+        Timer::Instance timing(timer, computes[i]);
         computes[i]->compute_vector();
         computes[i]->invoked_flag |= Compute::INVOKED_VECTOR;
       }
     } else if (compute_which[i] == ARRAY) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_ARRAY)) {
+        Timer::Instance timing(timer, computes[i]);
         computes[i]->compute_array();
         computes[i]->invoked_flag |= Compute::INVOKED_ARRAY;
       }
@@ -455,6 +461,64 @@ void Thermo::compute(int flag)
   firststep = 1;
 }
 
+/* ----------------------------------------------------------------------
+   invoke computes that support deferred reduction of their global scalar
+     or vector with a single MPI_Allreduce() for all their partial sums
+   temperature computes are finished first, since pressure computes use them
+   other computes are invoked individually in compute()
+------------------------------------------------------------------------- */
+
+void Thermo::reduce_computes()
+{
+  std::vector<int> list, offset;
+  int nsum = 0;
+
+  for (int i = 0; i < ncompute; i++) {
+    int size = 0;
+    if (compute_which[i] == SCALAR) {
+      if (!(computes[i]->invoked_flag & Compute::INVOKED_SCALAR))
+        size = computes[i]->size_partial_scalar;
+    } else if (compute_which[i] == VECTOR) {
+      if (!(computes[i]->invoked_flag & Compute::INVOKED_VECTOR))
+        size = computes[i]->size_partial_vector;
+    }
+    if (size > 0) {
+      list.push_back(i);
+      offset.push_back(nsum);
+      nsum += size;
+    }
+  }
+  if (list.empty()) return;
+
+  std::vector<double> partial(nsum), sum(nsum);
+  const int n = list.size();
+  for (int k = 0; k < n; k++) {
+    Compute *compute = computes[list[k]];
+    Timer::Instance timing(timer, compute);
+    if (compute_which[list[k]] == SCALAR)
+      compute->partial_scalar(&partial[offset[k]]);
+    else
+      compute->partial_vector(&partial[offset[k]]);
+  }
+
+  MPI_Allreduce(partial.data(), sum.data(), nsum, MPI_DOUBLE, MPI_SUM, world);
+
+  for (int pass = 0; pass < 2; pass++) {
+    for (int k = 0; k < n; k++) {
+      Compute *compute = computes[list[k]];
+      if ((pass == 0) != (compute->tempflag != 0)) continue;
+      Timer::Instance timing(timer, compute);
+      if (compute_which[list[k]] == SCALAR) {
+        compute->finish_scalar(&sum[offset[k]]);
+        compute->invoked_flag |= Compute::INVOKED_SCALAR;
+      } else {
+        compute->finish_vector(&sum[offset[k]]);
+        compute->invoked_flag |= Compute::INVOKED_VECTOR;
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    check for lost atoms, return current number of atoms
    also could number of warnings across MPI ranks and update total
@@ -1033,6 +1097,10 @@ void Thermo::parse_fields(const std::string &str)
       addfield("Nbuild", &Thermo::compute_nbuild, BIGINT);
     } else if (word == "ndanger") {
       addfield("Ndanger", &Thermo::compute_ndanger, BIGINT);
+    } else if (word == "memlive") {
+      addfield("MemLive", &Thermo::compute_memlive, FLOAT);
+    } else if (word == "mempeak") {
+      addfield("MemPeak", &Thermo::compute_mempeak, FLOAT);
 
       // compute value = c_ID, fix value = f_ID, variable value = v_ID
       // count trailing [] and store int arguments
@@ -1185,6 +1253,7 @@ void Thermo::check_temp(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(temperature->invoked_flag & Compute::INVOKED_SCALAR)) {
+    Timer::Instance timing(timer, temperature);
     temperature->compute_scalar();
     temperature->invoked_flag |= Compute::INVOKED_SCALAR;
   }
@@ -1205,6 +1274,7 @@ void Thermo::check_pe(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(pe->invoked_flag & Compute::INVOKED_SCALAR)) {
+    Timer::Instance timing(timer, pe);
     pe->compute_scalar();
     pe->invoked_flag |= Compute::INVOKED_SCALAR;
   }
@@ -1222,6 +1292,7 @@ void Thermo::check_press_scalar(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(pressure->invoked_flag & Compute::INVOKED_SCALAR)) {
+    Timer::Instance timing(timer, pressure);
     pressure->compute_scalar();
     pressure->invoked_flag |= Compute::INVOKED_SCALAR;
   }
@@ -1239,6 +1310,7 @@ void Thermo::check_press_vector(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(pressure->invoked_flag & Compute::INVOKED_VECTOR)) {
+    Timer::Instance timing(timer, pressure);
     pressure->compute_vector();
     pressure->invoked_flag |= Compute::INVOKED_VECTOR;
 
@@ -1541,6 +1613,10 @@ int Thermo::evaluate_keyword(const std::string &word, double *answer)
   } else if (word == "ndanger") {
     compute_ndanger();
     dvalue = bivalue;
+  } else if (word == "memlive") {
+    compute_memlive();
+  } else if (word == "mempeak") {
+    compute_mempeak();
   }
 
   else
@@ -2438,3 +2514,26 @@ void Thermo::compute_ndanger()
 {
   bivalue = neighbor->ndanger;
 }
+
+/* ----------------------------------------------------------------------
+   memory allocated via the Memory class in Mbytes, max across MPI ranks
+   requires memory tracking, which is enabled with -memtrack
+------------------------------------------------------------------------- */
+
+void Thermo::compute_memlive()
+{
+  if (!memory->is_tracking())
+    error->all(FLERR, "Thermo keyword memlive requires the -memtrack command-line switch");
+  double mbytes = memory->get_live() / 1024.0 / 1024.0;
+  MPI_Allreduce(&mbytes, &dvalue, 1, MPI_DOUBLE, MPI_MAX, world);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Thermo::compute_mempeak()
+{
+  if (!memory->is_tracking())
+    error->all(FLERR, "Thermo keyword mempeak requires the -memtrack command-line switch");
+  double mbytes = memory->get_peak() / 1024.0 / 1024.0;
+  MPI_Allreduce(&mbytes, &dvalue, 1, MPI_DOUBLE, MPI_MAX, world);
+}
@@ -120,6 +120,7 @@ class Thermo : protected Pointers {
   void deallocate();
 
   void parse_fields(const std::string &);
+  void reduce_computes();
   int add_compute(const char *, int);
   int add_fix(const char *);
   int add_variable(const char *);
@@ -237,6 +238,8 @@ class Thermo : protected Pointers {
 
   void compute_nbuild();
   void compute_ndanger();
+  void compute_memlive();
+  void compute_mempeak();
 
 };
 
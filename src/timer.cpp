@@ -14,20 +14,57 @@
 #include "timer.h"
 
 #include "comm.h"
+#include "compute.h"
 #include "error.h"
+#include "fix.h"
 #include "fmt/chrono.h"
+#include "modify.h"
+#include "update.h"
 
+#include <cerrno>
 #include <cstring>
 #include <ctime>
+#include <set>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 using namespace LAMMPS_NS;
 
+// names of timer sections in trace output, same order as Timer::ttype
+
+static const char *section_names[] = {"Total",  "Pair",     "Bond",     "Kspace",
+                                      "Neigh",  "Comm",     "Modify",   "Output",
+                                      "Sync",   "All",      "Dephase",  "Dynamics",
+                                      "Quench", "NEB",      "Repcomm",  "Repout"};
+static_assert(sizeof(section_names) / sizeof(const char *) == Timer::NUM_TIMER,
+              "Inconsistent number of timer section names");
+
 /* ---------------------------------------------------------------------- */
 
 Timer::Timer(LAMMPS *_lmp) : Pointers(_lmp)
 {
   _level = NORMAL;
   _sync = OFF;
+  _instance = OFF;
+  _nested = 0.0;
+  _trace = OFF;
+  trace_first = 0;
+  trace_last = MAXBIGINT;
+  trace_max = 100000;
+  trace_count = 0;
+  trace_lost = 0;
+  trace_origin = 0.0;
+  _counters = OFF;
+  for (int i = 0; i < NUM_COUNTER; i++) {
+    counter_fd[i] = -1;
+    previous_counter[i] = 0.0;
+  }
+  for (const auto &name : section_names) trace_names.emplace_back(name);
   _timeout = -1;
   _s_timeout = -1;
   _checkfreq = 10;
@@ -37,11 +74,28 @@ Timer::Timer(LAMMPS *_lmp) : Pointers(_lmp)
 
 /* ---------------------------------------------------------------------- */
 
+Timer::~Timer()
+{
+  _close_counters();
+}
+
+/* ---------------------------------------------------------------------- */
+
 void Timer::init()
 {
   for (int i = 0; i < NUM_TIMER; i++) {
     cpu_array[i] = 0.0;
     wall_array[i] = 0.0;
+    for (int j = 0; j < NUM_COUNTER; j++) counter_array[i][j] = 0.0;
+  }
+  _nested = 0.0;
+
+  // only the global timer owns the per-instance times, the per-thread timers
+  // of the OPENMP package may be created while a fix is being replaced
+
+  if (modify && (this == timer)) {
+    for (auto &ifix : modify->get_fix_list()) ifix->walltime = 0.0;
+    for (auto &icompute : modify->get_compute_list()) icompute->walltime = 0.0;
   }
 }
 
@@ -50,9 +104,11 @@ void Timer::init()
 void Timer::_stamp(enum ttype which)
 {
   double current_cpu = 0.0, current_wall = 0.0;
+  double current_counter[NUM_COUNTER];
 
   if (_level > NORMAL) current_cpu = platform::cputime();
   current_wall = platform::walltime();
+  if (_counters) _read_counters(current_counter);
 
   if ((which > TOTAL) && (which < NUM_TIMER)) {
     const double delta_cpu = current_cpu - previous_cpu;
@@ -62,10 +118,17 @@ void Timer::_stamp(enum ttype which)
     wall_array[which] += delta_wall;
     cpu_array[ALL] += delta_cpu;
     wall_array[ALL] += delta_wall;
+
+    if (_trace) _trace_event(which, previous_wall, current_wall);
+    if (_counters)
+      for (int i = 0; i < NUM_COUNTER; i++)
+        counter_array[which][i] += current_counter[i] - previous_counter[i];
   }
 
   previous_cpu = current_cpu;
   previous_wall = current_wall;
+  if (_counters)
+    for (int i = 0; i < NUM_COUNTER; i++) previous_counter[i] = current_counter[i];
 
   if (which == RESET) {
     this->init();
@@ -80,8 +143,16 @@ void Timer::_stamp(enum ttype which)
 
     cpu_array[SYNC] += current_cpu - previous_cpu;
     wall_array[SYNC] += current_wall - previous_wall;
+    if (_trace && (which > TOTAL)) _trace_event(SYNC, previous_wall, current_wall);
     previous_cpu = current_cpu;
     previous_wall = current_wall;
+    if (_counters) {
+      _read_counters(current_counter);
+      for (int i = 0; i < NUM_COUNTER; i++) {
+        counter_array[SYNC][i] += current_counter[i] - previous_counter[i];
+        previous_counter[i] = current_counter[i];
+      }
+    }
   }
 }
 
@@ -102,6 +173,7 @@ void Timer::barrier_start()
   wall_array[TOTAL] = current_wall;
   previous_cpu = current_cpu;
   previous_wall = current_wall;
+  if (_counters) _read_counters(previous_counter);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -211,6 +283,7 @@ double Timer::get_timeout_remain()
 ------------------------------------------------------------------------- */
 static const char *timer_style[] = {"off", "loop", "normal", "full"};
 static const char *timer_mode[] = {"nosync", "(dummy)", "sync"};
+static const char *timer_instance[] = {"noinstance", "(dummy)", "instance"};
 
 void Timer::modify_params(int narg, char **arg)
 {
@@ -228,12 +301,63 @@ void Timer::modify_params(int narg, char **arg)
       _sync = OFF;
     } else if (strcmp(arg[iarg], timer_mode[NORMAL]) == 0) {
       _sync = NORMAL;
+    } else if (strcmp(arg[iarg], timer_instance[OFF]) == 0) {
+      _instance = OFF;
+    } else if (strcmp(arg[iarg], timer_instance[NORMAL]) == 0) {
+      _instance = NORMAL;
     } else if (strcmp(arg[iarg], "timeout") == 0) {
       ++iarg;
       if (iarg < narg) {
         _timeout = utils::timespec2seconds(arg[iarg]);
       } else
         error->all(FLERR, "Illegal timer command");
+    } else if (strcmp(arg[iarg], "trace") == 0) {
+      if (iarg + 1 >= narg) utils::missing_cmd_args(FLERR, "timer trace", error);
+      trace_file = arg[++iarg];
+      _trace = NORMAL;
+      trace_events.clear();
+      trace_count = 0;
+      trace_lost = 0;
+      MPI_Barrier(world);
+      trace_origin = platform::walltime();
+    } else if (strcmp(arg[iarg], "notrace") == 0) {
+      _trace = OFF;
+    } else if (strcmp(arg[iarg], "tracesteps") == 0) {
+      if (iarg + 2 >= narg) utils::missing_cmd_args(FLERR, "timer tracesteps", error);
+      trace_first = utils::bnumeric(FLERR, arg[iarg + 1], false, lmp);
+      trace_last = utils::bnumeric(FLERR, arg[iarg + 2], false, lmp);
+      if ((trace_first < 0) || (trace_last < trace_first))
+        error->all(FLERR, "Illegal timer tracesteps values {} {}", trace_first, trace_last);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "tracemax") == 0) {
+      if (iarg + 1 >= narg) utils::missing_cmd_args(FLERR, "timer tracemax", error);
+      trace_max = utils::bnumeric(FLERR, arg[++iarg], false, lmp);
+      if (trace_max <= 0) error->all(FLERR, "Illegal timer tracemax value {}", trace_max);
+      trace_events.clear();
+      trace_count = 0;
+      trace_lost = 0;
+    } else if (strcmp(arg[iarg], "counters") == 0) {
+
+      // use counters only if they can be opened on all MPI ranks
+
+      const std::string mesg = _open_counters();
+      int flag = mesg.empty() ? 0 : 1;
+      int allflag;
+      MPI_Allreduce(&flag, &allflag, 1, MPI_INT, MPI_SUM, world);
+      if (allflag) {
+        _close_counters();
+        _counters = OFF;
+        if (comm->me == 0)
+          error->warning(FLERR, "Hardware performance counters are not available on {} of {} "
+                         "MPI rank(s){}. Continuing without them", allflag, comm->nprocs,
+                         mesg.empty() ? "" : ": " + mesg);
+      } else {
+        _counters = NORMAL;
+        _read_counters(previous_counter);
+      }
+    } else if (strcmp(arg[iarg], "nocounters") == 0) {
+      _close_counters();
+      _counters = OFF;
     } else if (strcmp(arg[iarg], "every") == 0) {
       ++iarg;
       if (iarg < narg) {
@@ -256,7 +380,277 @@ void Timer::modify_params(int narg, char **arg)
       timeout = fmt::format("{:02d}:{:%M:%S}", tv.tm_yday * 24 + tv.tm_hour, tv);
     }
 
-    utils::logmesg(lmp, "New timer settings: style={}  mode={}  timeout={}\n", timer_style[_level],
-                   timer_mode[_sync], timeout);
+    utils::logmesg(lmp, "New timer settings: style={}  mode={}  timeout={}  {}\n",
+                   timer_style[_level], timer_mode[_sync], timeout, timer_instance[_instance]);
+    if (_trace)
+      utils::logmesg(lmp, "  trace file: {}  steps {} to {}  max events per proc: {}\n",
+                     trace_file, trace_first, trace_last, trace_max);
+    if (_counters)
+      utils::logmesg(lmp, "  hardware counters: cycles instructions cache-references "
+                     "cache-misses\n");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   open hardware performance counters of the calling thread with perf_event_open()
+   all counters form one group, so they are scheduled and read together
+   return empty string on success, otherwise the reason for the failure
+------------------------------------------------------------------------- */
+
+std::string Timer::_open_counters()
+{
+  _close_counters();
+
+#if defined(__linux__)
+  static constexpr uint64_t config[NUM_COUNTER] = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_REFERENCES,
+      PERF_COUNT_HW_CACHE_MISSES};
+
+  for (int i = 0; i < NUM_COUNTER; i++) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config[i];
+    attr.disabled = (i == 0) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    counter_fd[i] = syscall(SYS_perf_event_open, &attr, 0, -1, (i == 0) ? -1 : counter_fd[0], 0);
+    if (counter_fd[i] < 0) {
+      std::string mesg = utils::getsyserror();
+      if ((errno == EACCES) || (errno == EPERM))
+        mesg += " (check /proc/sys/kernel/perf_event_paranoid)";
+      else if ((errno == ENOENT) || (errno == ENODEV) || (errno == EOPNOTSUPP))
+        mesg += " (no hardware counter support by CPU or kernel)";
+      _close_counters();
+      return mesg;
+    }
+  }
+  ioctl(counter_fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(counter_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return "";
+#else
+  return "only supported on Linux";
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   read current values of all hardware performance counters
+   values are scaled up if the kernel had to multiplex the counters
+------------------------------------------------------------------------- */
+
+void Timer::_read_counters(double *counts)
+{
+  for (int i = 0; i < NUM_COUNTER; i++) counts[i] = 0.0;
+
+#if defined(__linux__)
+  // read format is: number of counters, time enabled, time running, values
+
+  uint64_t buf[3 + NUM_COUNTER];
+  if (counter_fd[0] < 0) return;
+  if (read(counter_fd[0], buf, sizeof(buf)) != (ssize_t) sizeof(buf)) return;
+  const double scale = (buf[2] > 0) ? (double) buf[1] / (double) buf[2] : 0.0;
+  for (int i = 0; i < NUM_COUNTER; i++) counts[i] = (double) buf[3 + i] * scale;
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Timer::_close_counters()
+{
+  for (int i = NUM_COUNTER - 1; i >= 0; i--) {
+#if defined(__linux__)
+    if (counter_fd[i] >= 0) close(counter_fd[i]);
+#endif
+    counter_fd[i] = -1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   add event to trace ring buffer, if current step is in trace window
+------------------------------------------------------------------------- */
+
+void Timer::_trace_event(int name, double start, double stop)
+{
+  if (!update) return;
+  const bigint step = update->ntimestep;
+  if ((step < trace_first) || (step > trace_last)) return;
+
+  if ((bigint) trace_events.size() < trace_max)
+    trace_events.push_back({start - trace_origin, stop - trace_origin, step, name, 0});
+  else
+    trace_events[trace_count % trace_max] = {start - trace_origin, stop - trace_origin, step, name, 0};
+  ++trace_count;
+}
+
+/* ----------------------------------------------------------------------
+   add copy of event to trace ring buffer
+------------------------------------------------------------------------- */
+
+void Timer::_trace_store(const TraceEvent &event)
+{
+  if ((bigint) trace_events.size() < trace_max)
+    trace_events.push_back(event);
+  else
+    trace_events[trace_count % trace_max] = event;
+  ++trace_count;
+}
+
+/* ----------------------------------------------------------------------
+   record trace events with the settings of the global timer
+   used for the per-thread timers of the OPENMP package
+------------------------------------------------------------------------- */
+
+void Timer::init_trace(const Timer *global)
+{
+  _trace = global->_trace;
+  trace_first = global->trace_first;
+  trace_last = global->trace_last;
+  trace_max = global->trace_max;
+  trace_origin = global->trace_origin;
+}
+
+/* ----------------------------------------------------------------------
+   move recorded trace events of a per-thread timer to this timer
+   they are written as thread tid+1 of this MPI rank, oldest events first
+------------------------------------------------------------------------- */
+
+void Timer::merge_trace(Timer *thr, int tid)
+{
+  const bigint nevents = thr->trace_events.size();
+  const bigint first = (thr->trace_count > thr->trace_max) ? thr->trace_count % thr->trace_max : 0;
+  for (bigint i = 0; i < nevents; ++i) {
+    TraceEvent event = thr->trace_events[(first + i) % nevents];
+    event.tid = tid + 1;
+    _trace_store(event);
+  }
+  trace_lost += thr->trace_count - nevents + thr->trace_lost;
+  thr->trace_events.clear();
+  thr->trace_count = 0;
+  thr->trace_lost = 0;
+}
+
+/* ----------------------------------------------------------------------
+   start timing the scope of an Instance, save nested time of enclosing scope
+------------------------------------------------------------------------- */
+
+void Timer::Instance::start()
+{
+  nested = timer->_nested;
+  timer->_nested = 0.0;
+  tstart = platform::walltime();
+}
+
+/* ----------------------------------------------------------------------
+   add time of scope without nested scopes to the fix or compute
+   and the whole time of the scope to the nested time of the enclosing scope
+------------------------------------------------------------------------- */
+
+void Timer::Instance::stop()
+{
+  const double tstop = platform::walltime();
+  const double elapsed = tstop - tstart;
+  *walltime += elapsed - timer->_nested;
+  timer->_nested = nested + elapsed;
+  if (timer->_trace) timer->_trace_instance(*trace_slot, id, style, tstart, tstop);
+}
+
+/* ----------------------------------------------------------------------
+   add event for a fix or compute to trace
+   slot is the index of its name in trace_names, cached in the fix or compute
+   names are only looked up on first use, later events use the cached slot
+------------------------------------------------------------------------- */
+
+void Timer::_trace_instance(int &slot, const char *id, const char *style, double start, double stop)
+{
+  if (slot < 0) {
+
+    // fixes and computes may have the same ID, so the style is included in the name
+
+    const std::string label = fmt::format("{} ({})", id, style);
+    auto found = trace_index.find(label);
+    if (found == trace_index.end()) {
+      slot = trace_names.size();
+      trace_names.push_back(label);
+      trace_index[label] = slot;
+    } else {
+      slot = found->second;
+    }
+  }
+  _trace_event(slot, start, stop);
+}
+
+/* ----------------------------------------------------------------------
+   write recorded trace events of all MPI ranks to trace file
+   uses Chrome trace event format, which can be viewed with
+     chrome://tracing or https://ui.perfetto.dev
+   one process per MPI rank, events are complete events with duration
+   thread 0 of each process has the events of the global timer, the other
+     threads those of the OpenMP threads
+   timer sections are in category "timer", fixes and computes in "instance"
+------------------------------------------------------------------------- */
+
+void Timer::write_trace()
+{
+  if (!_trace) return;
+
+  const int me = comm->me;
+  const int nprocs = comm->nprocs;
+
+  // format events of this MPI rank, oldest events first
+
+  std::string buf;
+  const bigint nevents = trace_events.size();
+  const bigint first = (trace_count > trace_max) ? trace_count % trace_max : 0;
+  std::set<int> tids;
+  for (bigint i = 0; i < nevents; ++i) {
+    const auto &event = trace_events[(first + i) % nevents];
+    buf += fmt::format(",\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"pid\":{},"
+                       "\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f},\"args\":{{\"step\":{}}}}}",
+                       trace_names[event.name], (event.name < NUM_TIMER) ? "timer" : "instance",
+                       me, event.tid, event.start * 1.0e6, (event.stop - event.start) * 1.0e6,
+                       event.step);
+    tids.insert(event.tid);
+  }
+  for (const auto &tid : tids)
+    buf += fmt::format(",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},"
+                       "\"args\":{{\"name\":\"{}\"}}}}", me, tid,
+                       tid ? fmt::format("OpenMP thread {}", tid - 1) : "main");
+
+  bigint ndropped = trace_count - nevents + trace_lost;
+  bigint alldropped;
+  MPI_Reduce(&ndropped, &alldropped, 1, MPI_LMP_BIGINT, MPI_SUM, 0, world);
+
+  // proc 0 receives and writes the events of each MPI rank in turn
+
+  if (me == 0) {
+    FILE *fp = fopen(trace_file.c_str(), "w");
+    if (!fp) error->one(FLERR, "Cannot open trace file {}: {}", trace_file, utils::getsyserror());
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", fp);
+    for (int iproc = 0; iproc < nprocs; ++iproc)
+      fmt::print(fp, "{}{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":{},"
+                 "\"args\":{{\"name\":\"MPI rank {}\"}}}}", iproc ? ",\n" : "", iproc, iproc);
+    fputs(buf.c_str(), fp);
+
+    for (int iproc = 1; iproc < nprocs; ++iproc) {
+      int nchar;
+      MPI_Recv(&nchar, 1, MPI_INT, iproc, 0, world, MPI_STATUS_IGNORE);
+      buf.resize(nchar);
+      MPI_Recv(&buf[0], nchar, MPI_CHAR, iproc, 0, world, MPI_STATUS_IGNORE);
+      fputs(buf.c_str(), fp);
+    }
+    fputs("\n]}\n", fp);
+    fclose(fp);
+
+    if (alldropped)
+      error->warning(FLERR, "Trace file {} is missing {} older events. Increase timer tracemax",
+                     trace_file, alldropped);
+  } else {
+    int nchar = buf.size();
+    MPI_Send(&nchar, 1, MPI_INT, 0, 0, world);
+    MPI_Send(buf.data(), nchar, MPI_CHAR, 0, 0, world);
   }
 }
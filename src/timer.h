@@ -16,6 +16,8 @@
 
 #include "pointers.h"
 
+#include <map>
+
 namespace LAMMPS_NS {
 
 class Timer : protected Pointers {
@@ -43,7 +45,10 @@ class Timer : protected Pointers {
   };
   enum tlevel { OFF = 0, LOOP, NORMAL, FULL };
 
+  enum tcounter { CYCLES = 0, INSTRUCTIONS, CACHEREFS, CACHEMISSES, NUM_COUNTER };
+
   Timer(class LAMMPS *);
+  ~Timer() override;
 
   void init();
 
@@ -64,6 +69,7 @@ class Timer : protected Pointers {
   bool has_full() const { return (_level >= FULL); }
   bool has_sync() const { return (_sync != OFF); }
   bool has_timeout() const { return (_timeout >= 0.0); }
+  bool has_instance() const { return (_instance != OFF) && (_level >= NORMAL); }
 
   // flag if wallclock time is expired
   bool is_timeout() const { return (_timeout == 0.0); }
@@ -76,6 +82,51 @@ class Timer : protected Pointers {
 
   void set_wall(enum ttype, double);
 
+  // optional per-fix and per-compute timing.  the wall time of the scope
+  // of an Instance object is added to the fix or compute, if enabled.
+  // the time of nested Instance scopes, e.g. of computes invoked by a
+  // fix, is only added to the innermost fix or compute.
+
+  class Instance {
+   public:
+    template <typename T>
+    Instance(Timer *t, T *instance) :
+        timer(t->has_instance() ? t : nullptr), walltime(&instance->walltime),
+        trace_slot(&instance->trace_slot), id(instance->id), style(instance->style)
+    {
+      if (timer) start();
+    }
+    ~Instance()
+    {
+      if (timer) stop();
+    }
+    Instance(const Instance &) = delete;
+    Instance &operator=(const Instance &) = delete;
+
+   private:
+    Timer *timer;       // nullptr if instance timing is disabled
+    double *walltime;   // accumulated wall time of the fix or compute
+    int *trace_slot;    // cached index of the fix or compute in trace_names
+    const char *id, *style;
+    double tstart;      // wall time at start of scope
+    double nested;      // nested time of the enclosing scope
+    void start();
+    void stop();
+  };
+
+  // optional trace of timer sections, written in Chrome trace event format
+  // per-thread timers of the OPENMP package record events of their thread,
+  // which are added to the events of the global timer before writing them
+
+  void write_trace();
+  void init_trace(const Timer *);
+  void merge_trace(Timer *, int);
+
+  // optional hardware performance counters per timer section, Linux only
+
+  bool has_counters() const { return _counters && (_level >= NORMAL); }
+  double get_counter(enum ttype which, int counter) const { return counter_array[which][counter]; }
+
   // initialize timeout timer
   void init_timeout();
 
@@ -112,14 +163,55 @@ class Timer : protected Pointers {
   double timeout_start;
   int _level;        // level of detail: off=0,loop=1,normal=2,full=3
   int _sync;         // if nonzero, synchronize tasks before setting the timer
+  int _instance;     // if nonzero, time individual fixes and computes
+  double _nested;    // time of nested Instance scopes in current Instance scope
+  int _trace;        // if nonzero, record trace events
+  int _counters;     // if nonzero, read hardware performance counters
   int _timeout;      // max allowed wall time in seconds. infinity if negative
   int _s_timeout;    // copy of timeout for restoring after a forced timeout
   int _checkfreq;    // frequency of timeout checking
   int _nextcheck;    // loop number of next timeout check
 
+  // trace event storage. events are kept in a ring buffer of at most
+  // trace_max events, so only the most recent events are written.
+  // tid is 0 for events of the global timer and 1 + thread ID for
+  // events merged from per-thread timers.
+
+  struct TraceEvent {
+    double start, stop;
+    bigint step;
+    int name;
+    int tid;
+  };
+  std::string trace_file;                 // name of trace file
+  std::vector<TraceEvent> trace_events;    // ring buffer of events
+  std::vector<std::string> trace_names;    // names of events, timer sections first
+  std::map<std::string, int> trace_index;  // index of fix and compute names in trace_names
+  bigint trace_first, trace_last;         // window of timesteps to record
+  bigint trace_max;                       // max number of events per MPI rank
+  bigint trace_count;                     // number of events recorded
+  bigint trace_lost;                      // number of events dropped by per-thread timers
+  double trace_origin;                    // wall time at start of trace
+
+  // hardware performance counters, opened as one group with cycles as leader
+
+  int counter_fd[NUM_COUNTER];                   // perf event file descriptors, -1 if not open
+  double counter_array[NUM_TIMER][NUM_COUNTER];  // accumulated counts per timer section
+  double previous_counter[NUM_COUNTER];          // counts at previous stamp
+
   // update one specific timer array
   void _stamp(enum ttype);
 
+  // add event to trace
+  void _trace_event(int, double, double);
+  void _trace_store(const TraceEvent &);
+  void _trace_instance(int &, const char *, const char *, double, double);
+
+  // open, read, and close hardware performance counters
+  std::string _open_counters();
+  void _read_counters(double *);
+  void _close_counters();
+
   // check for timeout
   bool _check_timeout();
 };
@@ -34,6 +34,7 @@
 #include "random_mars.h"
 #include "region.h"
 #include "thermo.h"
+#include "timer.h"
 #include "tokenizer.h"
 #include "universe.h"
 #include "update.h"
@@ -1531,6 +1532,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_SCALAR)) {
+              Timer::Instance timing(timer, compute);
               compute->compute_scalar();
               compute->invoked_flag |= Compute::INVOKED_SCALAR;
             }
@@ -1548,6 +1550,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
+              Timer::Instance timing(timer, compute);
               compute->compute_vector();
               compute->invoked_flag |= Compute::INVOKED_VECTOR;
             }
@@ -1573,6 +1576,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
+              Timer::Instance timing(timer, compute);
               compute->compute_array();
               compute->invoked_flag |= Compute::INVOKED_ARRAY;
             }
@@ -1598,6 +1602,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
+              Timer::Instance timing(timer, compute);
               compute->compute_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
@@ -1619,6 +1624,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
+              Timer::Instance timing(timer, compute);
               compute->compute_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
@@ -1649,6 +1655,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
+              Timer::Instance timing(timer, compute);
               compute->compute_vector();
               compute->invoked_flag |= Compute::INVOKED_VECTOR;
             }
@@ -1678,6 +1685,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
             if (index1 > compute->size_array_cols)
               print_var_error(FLERR,"Variable formula compute array is accessed out-of-range",ivar,0);
             if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
+              Timer::Instance timing(timer, compute);
               compute->compute_array();
               compute->invoked_flag |= Compute::INVOKED_ARRAY;
             }
@@ -1715,6 +1723,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
+              Timer::Instance timing(timer, compute);
               compute->compute_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
@@ -1739,6 +1748,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
+              Timer::Instance timing(timer, compute);
               compute->compute_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
@@ -4386,6 +4396,7 @@ int Variable::special_function(const std::string &word, char *contents, Tree **t
           print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                           "initialization by a run",ivar);
         if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
+          Timer::Instance timing(timer, compute);
           compute->compute_vector();
           compute->invoked_flag |= Compute::INVOKED_VECTOR;
         }
@@ -4398,6 +4409,7 @@ int Variable::special_function(const std::string &word, char *contents, Tree **t
           print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                           "initialization by a run",ivar);
         if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
+          Timer::Instance timing(timer, compute);
           compute->compute_array();
           compute->invoked_flag |= Compute::INVOKED_ARRAY;
         }
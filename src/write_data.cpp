@@ -40,6 +40,9 @@ using namespace LAMMPS_NS;
 enum{II,IJ};
 enum{ELLIPSOID,LINE,TRIANGLE,BODY};   // also in AtomVecHybrid
 
+static constexpr int DATA_ENDIAN = 0x0001;    // also in ReadData
+static constexpr int MAXBLOCK = 8192;         // max rows in one binary block
+
 /* ---------------------------------------------------------------------- */
 
 WriteData::WriteData(LAMMPS *lmp) : Command(lmp)
@@ -74,6 +77,7 @@ void WriteData::command(int narg, char **arg)
   fixflag = 1;
   triclinic_general = 0;
   lmapflag = 1;
+  binaryflag = 0;
 
   // store current (default) setting since we may change it
 
@@ -104,6 +108,10 @@ void WriteData::command(int narg, char **arg)
     } else if (strcmp(arg[iarg],"nolabelmap") == 0) {
       lmapflag = 0;
       iarg++;
+    } else if (strcmp(arg[iarg],"binary") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "write_data binary", error);
+      binaryflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"types") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "write_data types", error);
       if (strcmp(arg[iarg+1],"numeric") == 0) atom->types_style = Atom::NUMERIC;
@@ -207,7 +215,7 @@ void WriteData::write(const std::string &file)
   // open data file
 
   if (me == 0) {
-    fp = fopen(file.c_str(),"w");
+    fp = fopen(file.c_str(),binaryflag ? "wb" : "w");
     if (fp == nullptr)
       error->one(FLERR,"Cannot open data file {}: {}", file, utils::getsyserror());
   }
@@ -278,8 +286,8 @@ void WriteData::write(const std::string &file)
 
 void WriteData::header()
 {
-  fmt::print(fp,"LAMMPS data file via write_data, version {}, timestep = {}, units = {}\n\n",
-             lmp->version, update->ntimestep, update->unit_style);
+  fmt::print(fp,"LAMMPS {}data file via write_data, version {}, timestep = {}, units = {}\n\n",
+             binaryflag ? "binary " : "", lmp->version, update->ntimestep, update->unit_style);
 
   fmt::print(fp,"{} atoms\n{} atom types\n",atom->natoms,atom->ntypes);
 
@@ -434,7 +442,8 @@ void WriteData::atoms()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_data(fp,recvrow,buf);
+      if (binaryflag) write_block(recvrow,ncol,buf);
+      else atom->avec->write_data(fp,recvrow,buf);
     }
 
   } else {
@@ -487,7 +496,8 @@ void WriteData::velocities()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_vel(fp,recvrow,buf);
+      if (binaryflag) write_block(recvrow,ncol,buf);
+      else atom->avec->write_vel(fp,recvrow,buf);
     }
 
   } else {
@@ -498,6 +508,37 @@ void WriteData::velocities()
   memory->destroy(buf);
 }
 
+/* ----------------------------------------------------------------------
+   proc 0 writes N rows of packed per-atom values in binary format
+   rows are split into blocks of at most MAXBLOCK rows
+   each block is a header (bigint nrows, int ncol, int endian flag)
+     followed by the ncol columns of nrows values each, one after the other
+   integer values are stored as 64-bit integers via ubuf, as in restart files
+------------------------------------------------------------------------- */
+
+void WriteData::write_block(int n, int ncol, double **buf)
+{
+  if (n == 0) return;
+
+  double *column;
+  memory->create(column,MIN(n,MAXBLOCK),"write_data:column");
+  int endian = DATA_ENDIAN;
+
+  for (int ifirst = 0; ifirst < n; ifirst += MAXBLOCK) {
+    int nrow = MIN(n-ifirst,MAXBLOCK);
+    bigint nrow_big = nrow;
+    fwrite(&nrow_big,sizeof(bigint),1,fp);
+    fwrite(&ncol,sizeof(int),1,fp);
+    fwrite(&endian,sizeof(int),1,fp);
+    for (int j = 0; j < ncol; j++) {
+      for (int i = 0; i < nrow; i++) column[i] = buf[ifirst+i][j];
+      fwrite(column,sizeof(double),nrow,fp);
+    }
+  }
+
+  memory->destroy(column);
+}
+
 /* ----------------------------------------------------------------------
    write out Bonds section of data file
 ------------------------------------------------------------------------- */
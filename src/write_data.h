@@ -37,6 +37,7 @@ class WriteData : public Command {
   int fixflag;
   int triclinic_general;
   int lmapflag;
+  int binaryflag;
   FILE *fp;
   bigint nbonds_local, nbonds;
   bigint nangles_local, nangles;
@@ -48,6 +49,7 @@ class WriteData : public Command {
   void force_fields();
   void atoms();
   void velocities();
+  void write_block(int, int, double **);
   void bonds();
   void angles();
   void dihedrals();
@@ -39,6 +39,10 @@
 
 #include "lmprestart.h"
 
+#if defined(LAMMPS_ZLIB)
+#include <zlib.h>
+#endif
+
 using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
@@ -50,6 +54,10 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
   multiproc = 0;
   noinit = 0;
   fp = nullptr;
+  delta_every = 0;
+  ndelta = -1;
+  base_offset = 0;
+  base_nchunk = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -80,6 +88,8 @@ void WriteRestart::command(int narg, char **arg)
   // also called by Output class for periodic restart files
 
   multiproc_options(multiproc,narg-1,&arg[1]);
+  if (delta_every)
+    error->all(FLERR,"Write_restart delta keyword is only supported by the restart command");
 
   // init entire system since comm->exchange is done
   // comm::init needs neighbor::init needs pair::init needs kspace::init, etc
@@ -176,6 +186,17 @@ void WriteRestart::multiproc_options(int multiproc_caller, int narg, char **arg)
       else filewriter = 0;
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"delta") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "restart delta", error);
+      delta_every = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (delta_every < 0) error->all(FLERR,"Invalid restart delta value {}", delta_every);
+      if (delta_every && multiproc)
+        error->all(FLERR,"Cannot use restart delta with % in restart file name");
+      if (delta_every && atom->tag_enable == 0)
+        error->all(FLERR,"Cannot use restart delta without atom IDs");
+      ndelta = -1;
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"noinit") == 0) {
       noinit = 1;
       iarg++;
@@ -219,12 +240,19 @@ void WriteRestart::write(const std::string &file)
       error->one(FLERR, "Cannot open restart file {}: {}", base, utils::getsyserror());
   }
 
+  // with delta files, write a new base file every delta_every+1 restart files
+  // a delta file stores only per-atom values that changed since the base file
+
+  int deltaflag = 0;
+  if (delta_every && ndelta >= 0 && ndelta < delta_every) deltaflag = 1;
+
   // proc 0 writes magic string, endian flag, numeric version
+  // delta files have their own revision, so older versions reject them
 
   if (me == 0) {
     magic_string();
     endian();
-    version_numeric();
+    version_numeric(deltaflag ? DELTA_FORMAT_REVISION : FORMAT_REVISION);
   }
 
   // proc 0 writes header, groups, pertype info, force field info
@@ -254,10 +282,25 @@ void WriteRestart::write(const std::string &file)
   memory->create(buf,max_size,"write_restart:buf");
   memset(buf,0,max_size*sizeof(double));
 
+  if (me == 0 && deltaflag) {
+    write_string(DELTA_BASE,base_file);
+    write_bigint(DELTA_OFFSET,base_offset);
+    write_int(DELTA_NCHUNK,base_nchunk);
+#if defined(LAMMPS_ZLIB)
+    write_int(DELTA_ZLIB,1);
+#endif
+  }
+
   // all procs write file layout info which may include per-proc sizes
 
   file_layout(send_size);
 
+  if (delta_every && !deltaflag) {
+    base_file = file;
+    base_nchunk = nclusterprocs;
+    if (me == 0) base_offset = platform::ftell(fp);
+  }
+
   // header info is complete
   // if multiproc output:
   //   close header file, open multiname file on each writing proc,
@@ -338,6 +381,26 @@ void WriteRestart::write(const std::string &file)
     }
   }
 
+  // store per-atom data of base file or replace it with changes since base file
+
+  if (delta_every) {
+    if (deltaflag) {
+      std::vector<double> dbuf;
+      send_size = delta_atoms(send_size,buf,dbuf);
+      MPI_Allreduce(&send_size,&max_size,1,MPI_INT,MPI_MAX,world);
+      memory->destroy(buf);
+      memory->create(buf,max_size,"write_restart:buf");
+      if (send_size) memcpy(buf,dbuf.data(),send_size*sizeof(double));
+      ndelta++;
+    } else {
+      base_buf.assign(buf,buf+send_size);
+      base_index.clear();
+      for (int m = 0; m < send_size; m += static_cast<int> (buf[m]))
+        base_index[(tagint) ubuf(buf[m+4]).i] = m;
+      ndelta = 0;
+    }
+  }
+
   // output of one or more native files
   // filewriter = 1 = this proc writes to file
   // ping each proc in my cluster, receive its data, write data to file
@@ -385,6 +448,74 @@ void WriteRestart::write(const std::string &file)
       fix->write_restart_file(file.c_str());
 }
 
+/* ----------------------------------------------------------------------
+   encode n values of per-atom data in buf as changes relative to base file
+   one record per atom: size, atom ID, # of mask words, mask words, values
+   mask bit I is set if value I of the atom differs from the base file
+   stored value = bitwise XOR of new and base value, so that the leading
+     sign, exponent, and mantissa bits they share are zero
+   0 mask words = atom not in my base data or its size changed, all values follow
+   with zlib, records are compressed and stored after the # of uncompressed
+     values and the # of compressed bytes
+   return size of encoded data in dbuf
+------------------------------------------------------------------------- */
+
+int WriteRestart::delta_atoms(int n, double *buf, std::vector<double> &dbuf)
+{
+  dbuf.clear();
+
+  for (int m = 0; m < n; m += static_cast<int> (buf[m])) {
+    const int size = static_cast<int> (buf[m]);
+    const tagint tag = (tagint) ubuf(buf[m+4]).i;
+    const std::size_t start = dbuf.size();
+
+    dbuf.push_back(0.0);
+    dbuf.push_back(buf[m+4]);
+
+    auto it = base_index.find(tag);
+    const double *base = (it == base_index.end()) ? nullptr : &base_buf[it->second];
+
+    if (base == nullptr || static_cast<int> (base[0]) != size) {
+      dbuf.push_back(ubuf(0).d);
+      dbuf.insert(dbuf.end(),&buf[m],&buf[m+size]);
+    } else {
+
+      // compare bit patterns, so values are restored exactly
+
+      const int nword = (size + 63) / 64;
+      dbuf.push_back(ubuf(nword).d);
+      const std::size_t maskstart = dbuf.size();
+      dbuf.resize(maskstart + nword, ubuf(0).d);
+      for (int i = 0; i < size; i++) {
+        if (memcmp(&buf[m+i],&base[i],sizeof(double)) != 0) {
+          auto word = (uint64_t) ubuf(dbuf[maskstart + i/64]).i;
+          word |= (uint64_t) 1 << (i % 64);
+          dbuf[maskstart + i/64] = ubuf((int64_t) word).d;
+          dbuf.push_back(ubuf(ubuf(buf[m+i]).i ^ ubuf(base[i]).i).d);
+        }
+      }
+    }
+    dbuf[start] = static_cast<double> (dbuf.size() - start);
+  }
+
+  if (dbuf.size() > (std::size_t) MAXSMALLINT)
+    error->one(FLERR,"Too much per-proc info for restart delta file");
+
+#if defined(LAMMPS_ZLIB)
+  uLongf nbytes = compressBound(dbuf.size() * sizeof(double));
+  std::vector<double> zbuf(2 + (nbytes + sizeof(double) - 1) / sizeof(double), 0.0);
+  if (compress2((Bytef *) &zbuf[2],&nbytes,(const Bytef *) dbuf.data(),
+                dbuf.size() * sizeof(double),Z_DEFAULT_COMPRESSION) != Z_OK)
+    error->one(FLERR,"Compression of restart delta data failed");
+  zbuf[0] = ubuf((int64_t) dbuf.size()).d;
+  zbuf[1] = ubuf((int64_t) nbytes).d;
+  zbuf.resize(2 + (nbytes + sizeof(double) - 1) / sizeof(double));
+  dbuf.swap(zbuf);
+#endif
+
+  return static_cast<int> (dbuf.size());
+}
+
 /* ----------------------------------------------------------------------
    proc 0 writes out problem description
 ------------------------------------------------------------------------- */
@@ -585,9 +716,8 @@ void WriteRestart::endian()
 
 /* ---------------------------------------------------------------------- */
 
-void WriteRestart::version_numeric()
+void WriteRestart::version_numeric(int vn)
 {
-  int vn = FORMAT_REVISION;
   fwrite(&vn,sizeof(int),1,fp);
 }
 
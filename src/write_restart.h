@@ -22,6 +22,9 @@ CommandStyle(write_restart,WriteRestart);
 
 #include "command.h"
 
+#include <unordered_map>
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class WriteRestart : public Command {
@@ -31,6 +34,8 @@ class WriteRestart : public Command {
   void multiproc_options(int, int, char **);
   void write(const std::string &);
 
+  int delta_every;    // # of delta files after each base file, 0 = none
+
  private:
   int me, nprocs;
   FILE *fp;
@@ -44,14 +49,22 @@ class WriteRestart : public Command {
   int fileproc;         // ID of proc in my cluster who writes to file
   int icluster;         // which cluster I am in
 
+  int ndelta;                                     // # of delta files since base file, -1 = none
+  std::string base_file;                          // name of current base file
+  bigint base_offset;                             // position of per-atom data in base file
+  int base_nchunk;                                // # of per-proc chunks in base file
+  std::vector<double> base_buf;                   // my per-atom data in base file
+  std::unordered_map<tagint, int> base_index;     // offset in base_buf for each atom ID
+
   void header();
   void type_arrays();
   void force_fields();
   void file_layout(int);
+  int delta_atoms(int, double *, std::vector<double> &);
 
   void magic_string();
   void endian();
-  void version_numeric();
+  void version_numeric(int);
 
   void write_int(int, int);
   void write_bigint(int, bigint);
@@ -165,6 +165,57 @@ TEST_F(LibraryProperties, thermo)
     EXPECT_DOUBLE_EQ(dval, 31.700964689115658);
 };
 
+TEST_F(LibraryProperties, instance_time)
+{
+    ::testing::internal::CaptureStdout();
+    lammps_command(lmp, "lattice sc 1.0");
+    lammps_command(lmp, "region box block 0 4 0 4 0 4");
+    lammps_command(lmp, "create_box 1 box");
+    lammps_command(lmp, "create_atoms 1 box");
+    lammps_command(lmp, "mass 1 1.0");
+    lammps_command(lmp, "pair_style zero 2.0");
+    lammps_command(lmp, "pair_coeff * *");
+    lammps_command(lmp, "fix 1 all nve");
+    lammps_command(lmp, "compute 1 all temp");
+    lammps_command(lmp, "thermo_style custom step c_1");
+    lammps_command(lmp, "run 10 post no");
+    std::string output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+
+    // timing of fixes and computes is off by default
+
+    EXPECT_DOUBLE_EQ(lammps_get_instance_time(lmp, "fix", "1"), 0.0);
+    EXPECT_DOUBLE_EQ(lammps_get_instance_time(lmp, "compute", "1"), 0.0);
+    EXPECT_DOUBLE_EQ(lammps_get_instance_time(lmp, "fix", "xxx"), -1.0);
+    EXPECT_DOUBLE_EQ(lammps_get_instance_time(lmp, "compute", "xxx"), -1.0);
+    EXPECT_DOUBLE_EQ(lammps_get_instance_time(lmp, "dump", "1"), -1.0);
+
+    ::testing::internal::CaptureStdout();
+    lammps_command(lmp, "timer instance");
+    lammps_command(lmp, "run 100");
+    output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+    EXPECT_THAT(output, HasSubstr("Fix and compute timing breakdown:"));
+    EXPECT_THAT(output, HasSubstr("fix 1 (nve)"));
+    EXPECT_THAT(output, HasSubstr("compute 1 (temp)"));
+    EXPECT_GT(lammps_get_instance_time(lmp, "fix", "1"), 0.0);
+    EXPECT_GT(lammps_get_instance_time(lmp, "compute", "1"), 0.0);
+
+    // the time of a compute invoked by fix ave/time is not counted for the fix
+
+    ::testing::internal::CaptureStdout();
+    lammps_command(lmp, "compute 2 all rdf 10");
+    lammps_command(lmp, "fix 2 all ave/time 1 1 1 c_2[2] mode vector");
+    lammps_command(lmp, "run 100 post no");
+    output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+    double time_fix     = lammps_get_instance_time(lmp, "fix", "2");
+    double time_compute = lammps_get_instance_time(lmp, "compute", "2");
+    EXPECT_GT(time_fix, 0.0);
+    EXPECT_GT(time_compute, 0.0);
+    EXPECT_LT(time_fix, time_compute);
+};
+
 TEST_F(LibraryProperties, box)
 {
     if (!lammps_has_style(lmp, "atom", "full")) GTEST_SKIP();
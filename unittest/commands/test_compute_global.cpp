@@ -295,6 +295,53 @@ TEST_F(ComputeGlobalTest, Reduction)
     EXPECT_DOUBLE_EQ(rep[3], max[0]);
 }
 
+TEST_F(ComputeGlobalTest, DeferredReduction)
+{
+    if (lammps_get_natoms(lmp) == 0.0) GTEST_SKIP();
+
+    // computes used by thermo output are reduced together with a single MPI_Allreduce(),
+    // the same computes invoked through variables are reduced individually
+
+    BEGIN_HIDE_OUTPUT();
+    command("pair_style lj/cut 10.0");
+    command("pair_coeff * * 0.01 3.0");
+    command("bond_style harmonic");
+    command("bond_coeff * 100.0 1.5");
+
+    command("compute kea all ke/atom");
+    for (const auto &suffix : {"1", "2"}) {
+        command(fmt::format("compute t{} allwater temp", suffix));
+        command(fmt::format("compute p{} all pressure t{}", suffix, suffix));
+        command(fmt::format("compute pe{} all pe", suffix));
+        command(fmt::format("compute ke{} allwater ke", suffix));
+        command(fmt::format("compute sum{} all reduce sum c_kea", suffix));
+        command(fmt::format("compute abs{} all reduce sumabs vx vy vz", suffix));
+    }
+    command("variable t equal c_t2");
+    command("variable p equal c_p2");
+    command("variable pxy equal c_p2[4]");
+    command("variable pe equal c_pe2");
+    command("variable ke equal c_ke2");
+    command("variable sum equal c_sum2");
+    command("variable absy equal c_abs2[2]");
+    command("thermo_style custom step c_p1 c_t1 c_p1[4] c_pe1 c_ke1 c_sum1 c_abs1[*] v_t v_p "
+            "v_pxy v_pe v_ke v_sum v_absy");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+
+    auto abs1 = get_vector("abs1");
+    auto abs2 = get_vector("abs2");
+    EXPECT_DOUBLE_EQ(get_scalar("t1"), get_scalar("t2"));
+    EXPECT_DOUBLE_EQ(get_scalar("p1"), get_scalar("p2"));
+    EXPECT_DOUBLE_EQ(get_vector("p1")[3], get_vector("p2")[3]);
+    EXPECT_DOUBLE_EQ(get_scalar("pe1"), get_scalar("pe2"));
+    EXPECT_DOUBLE_EQ(get_scalar("ke1"), get_scalar("ke2"));
+    EXPECT_DOUBLE_EQ(get_scalar("sum1"), get_scalar("sum2"));
+    EXPECT_DOUBLE_EQ(abs1[1], abs2[1]);
+    EXPECT_GT(abs1[0], 0.0);
+    EXPECT_GT(abs1[2], 0.0);
+}
+
 TEST_F(ComputeGlobalTest, Counts)
 {
     if (lammps_get_natoms(lmp) == 0.0) GTEST_SKIP();
@@ -9,6 +9,7 @@
 #include "lammps.h"
 #include "neighbor.h"
 #include "timer.h"
+#include "utils.h"
 #include <string>
 
 #include "gmock/gmock.h"
@@ -250,4 +251,45 @@ TEST_F(MPILoadBalanceTest, rcb_min_size)
     ASSERT_GT(dz, lmp->neighbor->skin);
 }
 
+TEST_F(MPILoadBalanceTest, imbalance_map)
+{
+    // place all atoms into one octant, so that one rank owns all of them
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("lattice fcc 0.8");
+    command("region octant block 1 9 1 9 1 9 units box");
+    command("create_atoms 1 region octant");
+    command("velocity all create 1.0 4928459");
+    command("fix 1 all nve");
+    command("fix map all imbalance/map 5 test_imbalance.map");
+    command("run 50 post no");
+    std::string output;
+    if (!verbose) output = ::testing::internal::GetCapturedStdout();
+
+    if (lmp->comm->me == 0) {
+        if (!verbose) {
+            ASSERT_THAT(output, HasSubstr("Load imbalance map (fix map) for steps 0 to 50"));
+            ASSERT_THAT(output, HasSubstr("dominant cause is the atom count"));
+            ASSERT_THAT(output, HasSubstr("Recommended load balancing settings:"));
+        }
+
+        FILE *fp = fopen("test_imbalance.map", "r");
+        ASSERT_NE(fp, nullptr);
+        char line[1024];
+        int nranks = 0, nempty = 0;
+        while (fgets(line, sizeof(line), fp)) {
+            if (line[0] == '#') continue;
+            auto words = utils::split_words(line);
+            ASSERT_EQ(words.size(), 21);
+            ASSERT_EQ(std::stoi(words[0]), nranks);
+            if (std::stod(words[18]) == 0.0) ++nempty;
+            ++nranks;
+        }
+        fclose(fp);
+        ASSERT_EQ(nranks, lmp->comm->nprocs);
+        ASSERT_EQ(nempty, lmp->comm->nprocs - 1);
+        platform::unlink("test_imbalance.map");
+    }
+}
+
 } // namespace LAMMPS_NS
@@ -0,0 +1,199 @@
+// unit tests for reading restart files on a different number of MPI ranks
+
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "input.h"
+#include "lammps.h"
+#include "platform.h"
+#include "utils.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+namespace LAMMPS_NS {
+
+class MPIRestartTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    const std::string restart_file = "mpi_restart_test.restart";
+    LAMMPS *lmp;
+
+    // per-atom state of all atoms indexed by atom ID, identical on all ranks
+    std::vector<double> ref_x, ref_v;
+    std::vector<int> ref_type, ref_image;
+
+    void SetUp() override
+    {
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+        InitSystem();
+        // write_restart remaps atoms back into the periodic box, so the
+        // reference state must be collected after writing the file
+        command("write_restart " + restart_file);
+        gather_state(ref_x, ref_v, ref_type, ref_image);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // system with an uneven distribution of atoms across the ranks,
+    // so that some per-proc chunks in the restart file are empty
+
+    virtual void InitSystem()
+    {
+        command("units           lj");
+        command("atom_style      atomic");
+        command("atom_modify     map array");
+        command("lattice         fcc 0.8442");
+        command("region          box block 0 6 0 6 0 6");
+        command("create_box      2 box");
+        command("create_atoms    1 box");
+        command("region          half block 0 3 INF INF INF INF");
+        command("delete_atoms    region half");
+        command("set             type 1 type/fraction 2 0.3 4564");
+        command("mass            * 1.0");
+        command("velocity        all create 3.0 87287 loop geom");
+        command("pair_style      lj/cut 2.5");
+        command("pair_coeff      * * 1.0 1.0 2.5");
+        command("fix             1 all nve");
+        command("run             20 post no");
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        MPI_Barrier(MPI_COMM_WORLD);
+        int me;
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        if (me == 0) platform::unlink(restart_file);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // collect per-atom state of all atoms by atom ID on all ranks of lmp->world
+
+    void gather_state(std::vector<double> &x, std::vector<double> &v, std::vector<int> &type,
+                      std::vector<int> &image)
+    {
+        const int natoms = lmp->atom->natoms;
+        const int nlocal = lmp->atom->nlocal;
+        std::vector<double> x_one(3 * natoms, 0.0), v_one(3 * natoms, 0.0);
+        std::vector<int> type_one(natoms, 0), image_one(natoms, 0);
+
+        for (int i = 0; i < nlocal; ++i) {
+            const int idx = lmp->atom->tag[i] - 1;
+            for (int k = 0; k < 3; ++k) {
+                x_one[3 * idx + k] = lmp->atom->x[i][k];
+                v_one[3 * idx + k] = lmp->atom->v[i][k];
+            }
+            type_one[idx]  = lmp->atom->type[i];
+            image_one[idx] = lmp->atom->image[i];
+        }
+
+        x.resize(3 * natoms);
+        v.resize(3 * natoms);
+        type.resize(natoms);
+        image.resize(natoms);
+        MPI_Allreduce(x_one.data(), x.data(), 3 * natoms, MPI_DOUBLE, MPI_SUM, lmp->world);
+        MPI_Allreduce(v_one.data(), v.data(), 3 * natoms, MPI_DOUBLE, MPI_SUM, lmp->world);
+        MPI_Allreduce(type_one.data(), type.data(), natoms, MPI_INT, MPI_SUM, lmp->world);
+        MPI_Allreduce(image_one.data(), image.data(), natoms, MPI_INT, MPI_SUM, lmp->world);
+    }
+
+    // read the restart file on the first nread ranks and compare the per-atom state
+
+    void read_and_compare(int nread)
+    {
+        delete lmp;
+        lmp = nullptr;
+
+        int me;
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        MPI_Comm comm;
+        MPI_Comm_split(MPI_COMM_WORLD, (me < nread) ? 0 : MPI_UNDEFINED, me, &comm);
+        if (comm == MPI_COMM_NULL) return;
+
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, comm);
+        command("read_restart " + restart_file);
+        auto output = ::testing::internal::GetCapturedStdout();
+        if (verbose) std::cout << output;
+        ASSERT_THAT(output, Not(HasSubstr("is not accessible from all procs")));
+        ASSERT_EQ(lmp->comm->nprocs, nread);
+        ASSERT_EQ(lmp->atom->natoms, (bigint)ref_type.size());
+
+        // every atom must be owned by exactly one rank and be inside its sub-domain
+
+        bigint nlocal = lmp->atom->nlocal;
+        bigint nall;
+        MPI_Allreduce(&nlocal, &nall, 1, MPI_LMP_BIGINT, MPI_SUM, comm);
+        ASSERT_EQ(nall, lmp->atom->natoms);
+
+        int outside = 0;
+        for (int i = 0; i < lmp->atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                if ((lmp->atom->x[i][k] < lmp->domain->sublo[k]) ||
+                    (lmp->atom->x[i][k] >= lmp->domain->subhi[k]))
+                    ++outside;
+        ASSERT_EQ(outside, 0);
+
+        std::vector<double> x, v;
+        std::vector<int> type, image;
+        gather_state(x, v, type, image);
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            EXPECT_DOUBLE_EQ(x[i], ref_x[i]);
+            EXPECT_DOUBLE_EQ(v[i], ref_v[i]);
+        }
+        for (std::size_t i = 0; i < type.size(); ++i) {
+            EXPECT_EQ(type[i], ref_type[i]);
+            EXPECT_EQ(image[i], ref_image[i]);
+        }
+
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        MPI_Comm_free(&comm);
+    }
+};
+
+TEST_F(MPIRestartTest, read_on_fewer_procs)
+{
+    int nprocs;
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    if (nprocs < 3) GTEST_SKIP();
+
+    read_and_compare(nprocs - 1);
+}
+
+TEST_F(MPIRestartTest, read_on_two_procs)
+{
+    int nprocs;
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    if (nprocs < 3) GTEST_SKIP();
+
+    read_and_compare(2);
+}
+
+TEST_F(MPIRestartTest, read_on_one_proc)
+{
+    int nprocs;
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    if (nprocs < 2) GTEST_SKIP();
+
+    read_and_compare(1);
+}
+} // namespace LAMMPS_NS
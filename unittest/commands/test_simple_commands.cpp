@@ -18,7 +18,9 @@
 #include "force.h"
 #include "info.h"
 #include "input.h"
+#include "memory.h"
 #include "output.h"
+#include "timer.h"
 #include "update.h"
 #include "utils.h"
 #include "variable.h"
@@ -38,8 +40,13 @@
 bool verbose = false;
 
 namespace LAMMPS_NS {
+using ::testing::Contains;
 using ::testing::ContainsRegex;
+using ::testing::EndsWith;
 using ::testing::ExitedWithCode;
+using ::testing::HasSubstr;
+using ::testing::Not;
+using ::testing::StartsWith;
 using ::testing::StrEq;
 
 class SimpleCommandsTest : public LAMMPSTest {};
@@ -257,6 +264,257 @@ TEST_F(SimpleCommandsTest, ResetTimestep)
     TEST_FAILURE(".*ERROR: Expected integer .*", command("reset_timestep xxx"););
 }
 
+TEST_F(SimpleCommandsTest, TimerTrace)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("timer instance trace simple_command_test.json tracesteps 2 4");
+    command("region box block 0 2 0 2 0 2 units box");
+    command("create_box 1 box");
+    command("create_atoms 1 single 1.0 1.0 1.0 units box");
+    command("mass 1 1.0");
+    command("pair_style zero 1.0");
+    command("pair_coeff * *");
+    command("fix 1 all nve");
+    command("run 10 post no");
+    END_HIDE_OUTPUT();
+
+    auto lines = read_lines("simple_command_test.json");
+    ASSERT_GT(lines.size(), 3);
+    ASSERT_THAT(lines.front(), StrEq("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    ASSERT_THAT(lines.back(), StrEq("]}"));
+    int npair = 0, nfix = 0;
+    for (const auto &line : lines) {
+        if (utils::strmatch(line, "\"name\":\"Pair\",\"cat\":\"timer\"")) ++npair;
+        if (utils::strmatch(line, "\"name\":\"1 \\(nve\\)\",\"cat\":\"instance\"")) ++nfix;
+        if (utils::strmatch(line, "\"ph\":\"X\"")) {
+            ASSERT_THAT(line, ContainsRegex("\"step\":[234]}"));
+        }
+    }
+    ASSERT_EQ(npair, 3);
+    ASSERT_EQ(nfix, 6);
+    ASSERT_THAT(lines, Contains(HasSubstr("\"tid\":0,\"args\":{\"name\":\"main\"}")));
+    remove("simple_command_test.json");
+
+    TEST_FAILURE(".*ERROR: Illegal timer tracesteps values.*", command("timer tracesteps 4 2"););
+    TEST_FAILURE(".*ERROR: Illegal timer tracemax value.*", command("timer tracemax 0"););
+}
+
+TEST_F(SimpleCommandsTest, TimerTraceOMP)
+{
+    if (!info->has_style("pair", "lj/cut/omp")) GTEST_SKIP();
+
+    BEGIN_HIDE_OUTPUT();
+    command("package omp 2");
+    command("timer trace simple_command_omp.json tracesteps 2 4");
+    command("region box block 0 4 0 4 0 4 units box");
+    command("create_box 1 box");
+    command("create_atoms 1 random 20 4928459 NULL overlap 0.8");
+    command("mass 1 1.0");
+    command("pair_style lj/cut/omp 1.0");
+    command("pair_coeff * * 0.1 0.8");
+    command("fix 1 all nve");
+    command("run 10 post no");
+    END_HIDE_OUTPUT();
+
+    // each OpenMP thread has its own track with Pair events
+
+    auto lines = read_lines("simple_command_omp.json");
+    int npair[3] = {0, 0, 0};
+    for (const auto &line : lines) {
+        for (int tid = 0; tid < 3; ++tid)
+            if (utils::strmatch(line, fmt::format("\"name\":\"Pair\",.*\"tid\":{},", tid)))
+                ++npair[tid];
+    }
+    ASSERT_EQ(npair[0], 3);
+    ASSERT_EQ(npair[1], 3);
+    ASSERT_EQ(npair[2], 3);
+    ASSERT_THAT(lines, Contains(HasSubstr("\"tid\":2,\"args\":{\"name\":\"OpenMP thread 1\"}")));
+    remove("simple_command_omp.json");
+}
+
+TEST_F(SimpleCommandsTest, FixTelemetry)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("region box block 0 4 0 4 0 4 units box");
+    command("create_box 1 box");
+    command("create_atoms 1 random 20 4273 NULL overlap 0.8 units box");
+    command("mass 1 1.0");
+    command("pair_style zero 1.0");
+    command("pair_coeff * *");
+    command("velocity all create 1.0 4928459");
+    command("fix 1 all nve");
+    lmp->memory->set_tracking(true);
+    command("fix 2 all telemetry 5 simple_command_test.json maxsize 0.0001 backups 2");
+    command("run 20 post no");
+    command("unfix 2");
+    END_HIDE_OUTPUT();
+
+    // each record is larger than maxsize, so a new file is started after every record
+    // and only the last two of four records are kept in the backup files
+
+    std::vector<std::string> lines;
+    for (const auto &name : {"simple_command_test.json.2", "simple_command_test.json.1",
+                             "simple_command_test.json"}) {
+        auto more = read_lines(name);
+        lines.insert(lines.end(), more.begin(), more.end());
+        remove(name);
+    }
+    ASSERT_EQ(lines.size(), 2);
+    int step = 15;
+    for (const auto &line : lines) {
+        ASSERT_THAT(line, StartsWith(fmt::format("{{\"step\":{},", step)));
+        ASSERT_THAT(line, HasSubstr("\"steps\":5,"));
+        ASSERT_THAT(line, HasSubstr("\"atoms\":20,"));
+        ASSERT_THAT(line, ContainsRegex("\"timer_avg\":\\{\"pair\":[-+.0-9e]+,"));
+        ASSERT_THAT(line, ContainsRegex("\"neigh\":\\{\"builds\":[0-9]+,"));
+        ASSERT_THAT(line, ContainsRegex("\"migrated\":[0-9]+,"));
+        ASSERT_THAT(line, ContainsRegex("\"memory\":\\{\"live_sum\":[.0-9e+]+,"));
+        ASSERT_THAT(line, EndsWith("}}"));
+        step += 5;
+    }
+
+    TEST_FAILURE(".*ERROR: Illegal fix telemetry nevery value: 0.*",
+                 command("fix 2 all telemetry 0 telemetry.json"););
+    TEST_FAILURE(".*ERROR: Unknown fix telemetry mode: xxx.*",
+                 command("fix 2 all telemetry 10 telemetry.json mode xxx"););
+    TEST_FAILURE(".*ERROR: Unknown fix telemetry keyword: xxx.*",
+                 command("fix 2 all telemetry 10 telemetry.json xxx 1"););
+    TEST_FAILURE(".*ERROR: Fix telemetry maxsize requires mode file.*",
+                 command("fix 2 all telemetry 10 telemetry.json mode socket maxsize 1"););
+
+#if !defined(_WIN32)
+    // without a reader, records for a named pipe are dropped and the run is not blocked
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 2 all telemetry 5 simple_command_test.fifo mode pipe");
+    command("run 10 post no");
+    command("unfix 2");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->update->ntimestep, 30);
+    remove("simple_command_test.fifo");
+#endif
+}
+
+TEST_F(SimpleCommandsTest, TimerCounters)
+{
+    // hardware counters are often unavailable, e.g. in containers or virtual machines
+
+    BEGIN_CAPTURE_OUTPUT();
+    command("timer counters");
+    auto text = END_CAPTURE_OUTPUT();
+    if (lmp->timer->has_counters()) {
+        ASSERT_THAT(text, HasSubstr("hardware counters: cycles instructions"));
+    } else {
+        ASSERT_THAT(text, HasSubstr("Hardware performance counters are not available"));
+    }
+
+    BEGIN_HIDE_OUTPUT();
+    command("region box block 0 2 0 2 0 2 units box");
+    command("create_box 1 box");
+    command("create_atoms 1 single 1.0 1.0 1.0 units box");
+    command("mass 1 1.0");
+    command("pair_style zero 1.0");
+    command("pair_coeff * *");
+    command("fix 1 all nve");
+    END_HIDE_OUTPUT();
+
+    BEGIN_CAPTURE_OUTPUT();
+    command("run 10");
+    text = END_CAPTURE_OUTPUT();
+    if (lmp->timer->has_counters()) {
+        ASSERT_THAT(text, HasSubstr("Hardware counter breakdown:"));
+        ASSERT_GT(lmp->timer->get_counter(Timer::PAIR, Timer::CYCLES), 0.0);
+    } else {
+        ASSERT_THAT(text, Not(HasSubstr("Hardware counter breakdown:")));
+    }
+
+    BEGIN_HIDE_OUTPUT();
+    command("timer nocounters");
+    END_HIDE_OUTPUT();
+    ASSERT_FALSE(lmp->timer->has_counters());
+}
+
+TEST_F(SimpleCommandsTest, Autotune)
+{
+    TEST_FAILURE(".*ERROR: Autotune command before simulation box is defined.*",
+                 command("autotune 10 newton on off"););
+
+    BEGIN_HIDE_OUTPUT();
+    command("units lj");
+    command("atom_modify map array");
+    command("lattice fcc 0.8442");
+    command("region box block 0 4 0 4 0 4");
+    command("create_box 1 box");
+    command("create_atoms 1 box");
+    command("mass 1 1.0");
+    command("velocity all create 1.44 87287 loop geom");
+    command("pair_style lj/cut 2.5");
+    command("pair_coeff 1 1 1.0 1.0 2.5");
+    command("neigh_modify every 2 delay 0 check no");
+    command("fix 1 all nvt temp 1.44 1.44 0.5");
+    command("run 0 post no");
+    command("variable xone equal x[1]");
+    command("variable vone equal vx[1]");
+    command("fix 2 all print 5 \"$(step)\" file autotune_test.print");
+    command("fix 3 all ave/time 5 1 5 v_xone file autotune_test.ave");
+    END_HIDE_OUTPUT();
+
+    const double xone = lmp->input->variable->compute_equal("v_xone");
+    const double vone = lmp->input->variable->compute_equal("v_vone");
+
+    // trial runs must not change the state of the system
+
+    BEGIN_CAPTURE_OUTPUT();
+    command("autotune 10 newton off on binsize 0.0 1.0 sort 0 50 apply no");
+    auto text = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(text, ContainsRegex("Autotune: [5-7] trials of 10 steps"));
+    ASSERT_THAT(text, HasSubstr("initial settings"));
+    ASSERT_THAT(text, HasSubstr("atom_modify sort 50 0"));
+    ASSERT_THAT(text, Not(HasSubstr("have been applied")));
+    ASSERT_THAT(text, HasSubstr("fastest"));
+    ASSERT_EQ(lmp->update->ntimestep, 0);
+    ASSERT_EQ(lmp->force->newton_pair, 1);
+    ASSERT_DOUBLE_EQ(lmp->input->variable->compute_equal("v_xone"), xone);
+    ASSERT_DOUBLE_EQ(lmp->input->variable->compute_equal("v_vone"), vone);
+
+    // fixes must not write to their files during trial runs
+
+    for (const auto &line : read_lines("autotune_test.print"))
+        ASSERT_THAT(line, StartsWith("#"));
+    for (const auto &line : read_lines("autotune_test.ave"))
+        ASSERT_THAT(line, StartsWith("#"));
+
+    BEGIN_CAPTURE_OUTPUT();
+    command("autotune 10 newton off");
+    text = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(text, HasSubstr("Autotune: 3 trials of 10 steps"));
+    ASSERT_THAT(text, ContainsRegex("(have been applied|initial settings are the fastest)"));
+    ASSERT_EQ(lmp->update->ntimestep, 0);
+    ASSERT_DOUBLE_EQ(lmp->input->variable->compute_equal("v_xone"), xone);
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 10 post no");
+    command("unfix 2");
+    command("unfix 3");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->update->ntimestep, 10);
+    ASSERT_EQ(read_lines("autotune_test.print").size(), 4);
+    remove("autotune_test.print");
+    remove("autotune_test.ave");
+
+    TEST_FAILURE(".*ERROR: Illegal autotune command: missing argument.*", command("autotune 10"););
+    TEST_FAILURE(".*ERROR: Illegal autotune number of steps: 0.*",
+                 command("autotune 0 newton on"););
+    TEST_FAILURE(".*ERROR: Unknown autotune keyword: xxx.*", command("autotune 10 xxx 1"););
+    TEST_FAILURE(".*ERROR: Autotune keyword newton requires at least one value.*",
+                 command("autotune 10 newton"););
+    TEST_FAILURE(".*ERROR: Autotune keyword sort used twice.*",
+                 command("autotune 10 sort 0 sort 10"););
+    TEST_FAILURE(".*ERROR: Illegal autotune binsize value: -1.*",
+                 command("autotune 10 binsize -1"););
+    TEST_FAILURE(".*ERROR: Unsupported autotune suffix: xxx.*", command("autotune 10 suffix xxx"););
+}
+
 TEST_F(SimpleCommandsTest, Suffix)
 {
     ASSERT_EQ(lmp->suffix_enable, 0);
@@ -3,6 +3,7 @@
 #include "comm.h"
 #include "info.h"
 #include "lammps.h"
+#include "memory.h"
 #include <cstdio>  // for stdin, stdout
 #include <cstdlib> // for setenv
 #include <mpi.h>
@@ -99,6 +100,58 @@ TEST_F(LAMMPS_plain, InitMembers)
     }
 }
 
+TEST_F(LAMMPS_plain, MemoryTracking)
+{
+    auto *memory = lmp->memory;
+    EXPECT_FALSE(memory->is_tracking());
+    EXPECT_EQ(memory->get_live(), 0);
+    memory->set_tracking(true);
+    EXPECT_TRUE(memory->is_tracking());
+
+    const bigint live = memory->get_live();
+    const bigint peak = memory->get_peak();
+    EXPECT_GE(peak, live);
+
+    double *data = nullptr;
+    int **idx = nullptr;
+    memory->create(data, 1000, "test:data");
+    memory->create(idx, 10, 10, "test:idx");
+    EXPECT_EQ(memory->get_live(), live + 1000 * sizeof(double) + 100 * sizeof(int) +
+                                      10 * sizeof(int *));
+    memory->grow(data, 2000, "test:data");
+    const bigint grown = live + 2000 * sizeof(double) + 100 * sizeof(int) + 10 * sizeof(int *);
+    EXPECT_EQ(memory->get_live(), grown);
+    EXPECT_GE(memory->get_peak(), grown);
+
+    bool found_tag = false;
+    for (const auto &u : memory->get_usage(false)) {
+        if (u.name == "test:data") {
+            found_tag = true;
+            EXPECT_EQ(u.live, 2000 * sizeof(double));
+            EXPECT_EQ(u.peak, 2000 * sizeof(double));
+        }
+    }
+    EXPECT_TRUE(found_tag);
+
+    bool found_subsystem = false;
+    for (const auto &u : memory->get_usage(true)) {
+        if (u.name == "test") {
+            found_subsystem = true;
+            EXPECT_EQ(u.live, grown - live);
+        }
+    }
+    EXPECT_TRUE(found_subsystem);
+
+    memory->destroy(data);
+    memory->destroy(idx);
+    EXPECT_EQ(memory->get_live(), live);
+    EXPECT_GE(memory->get_peak(), grown);
+
+    // blocks not allocated through the Memory class are ignored
+    memory->sfree(malloc(100));
+    EXPECT_EQ(memory->get_live(), live);
+}
+
 TEST_F(LAMMPS_plain, TestStyles)
 {
     // skip tests if base class is not available
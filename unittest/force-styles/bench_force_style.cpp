@@ -0,0 +1,444 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// microbenchmarks for the force kernels of the styles in the YAML test files
+// and for neighbor list builds, communication, and packing of per-atom data
+
+#include "test_config.h"
+#include "test_config_reader.h"
+
+#include "angle.h"
+#include "atom.h"
+#include "atom_vec.h"
+#include "bond.h"
+#include "comm.h"
+#include "dihedral.h"
+#include "domain.h"
+#include "exceptions.h"
+#include "force.h"
+#include "improper.h"
+#include "info.h"
+#include "input.h"
+#include "kspace.h"
+#include "lammps.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+#include "pair.h"
+#include "platform.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mpi.h>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace LAMMPS_NS;
+
+// location for 'in.*' and 'data.*' files required by tests
+#define STRINGIFY(val) XSTR(val)
+#define XSTR(val) #val
+static std::string INPUT_FOLDER = STRINGIFY(TEST_INPUT_FOLDER);
+
+static constexpr int BUFEXTRA = 1024;
+
+namespace {
+struct BenchResult {
+    std::string name;    // name of the kernel
+    bigint calls;        // number of kernel calls per sample
+    double best;         // fastest wall time per call in seconds
+    double avg;          // average wall time per call in seconds
+    bigint items;        // number of interactions, pairs, or atoms per call across all MPI ranks
+    std::string unit;    // kind of items
+};
+
+struct BenchOptions {
+    bigint natoms   = 8000;
+    double scale    = 1.0;
+    int nsample     = 5;
+    double min_time = 0.05;
+    std::string only;
+    bool verbose = false;
+};
+} // namespace
+
+// time a kernel. the number of calls per sample is doubled until one sample
+// takes at least min_time seconds, then nsample samples are taken.
+// the time of a sample is the time of the slowest MPI rank.
+
+template <typename F>
+static BenchResult measure(const std::string &name, bigint items, const std::string &unit,
+                           const BenchOptions &opts, F kernel)
+{
+    BenchResult result{name, 1, 0.0, 0.0, items, unit};
+
+    auto sample = [&](bigint calls) {
+        MPI_Barrier(MPI_COMM_WORLD);
+        double start = platform::walltime();
+        for (bigint i = 0; i < calls; ++i)
+            kernel();
+        double local = platform::walltime() - start;
+        double time;
+        MPI_Allreduce(&local, &time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        return time;
+    };
+
+    // warm up caches and let the kernel allocate its buffers
+    kernel();
+
+    while ((sample(result.calls) < opts.min_time) && (result.calls < MAXSMALLINT / 2))
+        result.calls *= 2;
+
+    double sum  = 0.0;
+    result.best = 1.0e300;
+    for (int i = 0; i < opts.nsample; ++i) {
+        double time = sample(result.calls) / result.calls;
+        result.best = std::min(result.best, time);
+        sum += time;
+    }
+    result.avg = sum / opts.nsample;
+    return result;
+}
+
+// sum of a per-rank count across all MPI ranks
+
+static bigint sum_all(bigint local)
+{
+    bigint all = 0;
+    MPI_Allreduce(&local, &all, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+    return all;
+}
+
+// number of pairs in a neighbor list
+
+static bigint count_neighbors(NeighList *list)
+{
+    if (!list || !list->numneigh) return 0;
+    bigint npairs = 0;
+    for (int ii = 0; ii < list->inum; ++ii)
+        npairs += list->numneigh[list->ilist[ii]];
+    return sum_all(npairs);
+}
+
+// set up the system of the test file, replicated to at least the requested number of atoms
+
+static LAMMPS *init_lammps(LAMMPS::argv &args, const TestConfig &cfg, const BenchOptions &opts)
+{
+    LAMMPS *lmp = new LAMMPS(args, MPI_COMM_WORLD);
+
+    // check if prerequisite styles are available
+    Info *info = new Info(lmp);
+    int nfail  = 0;
+    for (auto &prerequisite : cfg.prerequisites) {
+        std::string style = prerequisite.second;
+        if ((prerequisite.first == "pair") && lmp->suffix_enable) {
+            style += "/";
+            style += lmp->suffix;
+        }
+        if (!info->has_style(prerequisite.first, style)) ++nfail;
+    }
+    delete info;
+    if (nfail > 0) {
+        delete lmp;
+        return nullptr;
+    }
+
+    // utility lambda to improve readability
+    auto command = [&](const std::string &line) {
+        lmp->input->one(line);
+    };
+
+    command("variable input_dir index " + INPUT_FOLDER);
+    for (auto &pre_command : cfg.pre_commands)
+        command(pre_command);
+    lmp->input->file(platform::path_join(INPUT_FOLDER, cfg.input_file).c_str());
+
+    if (cfg.pair_style != "zero") command("pair_style " + cfg.pair_style);
+    for (auto &pair_coeff : cfg.pair_coeff)
+        command("pair_coeff " + pair_coeff);
+    if (cfg.bond_style != "zero") command("bond_style " + cfg.bond_style);
+    for (auto &bond_coeff : cfg.bond_coeff)
+        command("bond_coeff " + bond_coeff);
+    if (cfg.angle_style != "zero") command("angle_style " + cfg.angle_style);
+    for (auto &angle_coeff : cfg.angle_coeff)
+        command("angle_coeff " + angle_coeff);
+    if (cfg.dihedral_style != "zero") command("dihedral_style " + cfg.dihedral_style);
+    for (auto &dihedral_coeff : cfg.dihedral_coeff)
+        command("dihedral_coeff " + dihedral_coeff);
+    if (cfg.improper_style != "zero") command("improper_style " + cfg.improper_style);
+    for (auto &improper_coeff : cfg.improper_coeff)
+        command("improper_coeff " + improper_coeff);
+    for (auto &post_command : cfg.post_commands)
+        command(post_command);
+
+    // grow the system to the requested size and change its density
+
+    const int dimension = lmp->domain->dimension;
+    const double ratio  = (double)opts.natoms / (double)lmp->atom->natoms;
+    const int nrep      = std::max(1, (int)std::ceil(std::pow(ratio, 1.0 / dimension)));
+    if (nrep > 1) command(fmt::format("replicate {0} {0} {1}", nrep, (dimension == 2) ? 1 : nrep));
+    if (opts.scale != 1.0) {
+        if (dimension == 2)
+            command(fmt::format("change_box all x scale {0} y scale {0} remap", opts.scale));
+        else
+            command(fmt::format("change_box all x scale {0} y scale {0} z scale {0} remap",
+                                opts.scale));
+    }
+    command("run 0 post no");
+    return lmp;
+}
+
+static std::vector<BenchResult> run_benchmarks(LAMMPS *lmp, const BenchOptions &opts)
+{
+    std::vector<BenchResult> results;
+    Atom *atom       = lmp->atom;
+    Force *force     = lmp->force;
+    Neighbor *neigh  = lmp->neighbor;
+    Comm *comm       = lmp->comm;
+    const int nlocal = atom->nlocal;
+    const bigint natoms = atom->natoms;
+
+    auto selected = [&](const std::string &name) {
+        return opts.only.empty() || (name.find(opts.only) != std::string::npos);
+    };
+
+    // force kernels are called without energy and virial tally, as on most MD steps
+
+    Pair *pair = force->pair;
+    if (pair && pair->compute_flag && !utils::strmatch(force->pair_style, "^zero")) {
+        const std::string name = std::string("pair ") + force->pair_style;
+        bigint npairs          = count_neighbors(pair->list);
+        if (selected(name))
+            results.push_back(measure(name, npairs ? npairs : natoms, npairs ? "pair" : "atom",
+                                      opts, [&] { pair->compute(0, 0); }));
+    }
+
+    Bond *bond = force->bond;
+    std::string name = std::string("bond ") + (force->bond_style ? force->bond_style : "");
+    if (bond && !utils::strmatch(force->bond_style, "^zero") && selected(name))
+        results.push_back(measure(name, sum_all(neigh->nbondlist), "bond", opts,
+                                  [&] { bond->compute(0, 0); }));
+
+    Angle *angle = force->angle;
+    name = std::string("angle ") + (force->angle_style ? force->angle_style : "");
+    if (angle && !utils::strmatch(force->angle_style, "^zero") && selected(name))
+        results.push_back(measure(name, sum_all(neigh->nanglelist), "angle", opts,
+                                  [&] { angle->compute(0, 0); }));
+
+    Dihedral *dihedral = force->dihedral;
+    name = std::string("dihedral ") + (force->dihedral_style ? force->dihedral_style : "");
+    if (dihedral && !utils::strmatch(force->dihedral_style, "^zero") && selected(name))
+        results.push_back(measure(name, sum_all(neigh->ndihedrallist), "dihedral", opts,
+                                  [&] { dihedral->compute(0, 0); }));
+
+    Improper *improper = force->improper;
+    name = std::string("improper ") + (force->improper_style ? force->improper_style : "");
+    if (improper && !utils::strmatch(force->improper_style, "^zero") && selected(name))
+        results.push_back(measure(name, sum_all(neigh->nimproperlist), "improper", opts,
+                                  [&] { improper->compute(0, 0); }));
+
+    KSpace *kspace = force->kspace;
+    name = std::string("kspace ") + (force->kspace_style ? force->kspace_style : "");
+    if (kspace && kspace->compute_flag && selected(name))
+        results.push_back(measure(name, natoms, "atom", opts, [&] { kspace->compute(0, 0); }));
+
+    // neighbor lists without topology, i.e. binning and all NPair builds
+
+    bigint npairs = pair ? count_neighbors(pair->list) : 0;
+    name          = "neighbor build";
+    if (selected(name))
+        results.push_back(measure(name, npairs ? npairs : natoms, npairs ? "pair" : "atom", opts,
+                                  [&] { neigh->build(0); }));
+
+    // communication of ghost atoms
+
+    const bigint nghost = sum_all(atom->nghost);
+    name                = "comm forward";
+    if (selected(name))
+        results.push_back(measure(name, nghost, "ghost", opts, [&] { comm->forward_comm(); }));
+    name = "comm reverse";
+    if (selected(name))
+        results.push_back(measure(name, nghost, "ghost", opts, [&] { comm->reverse_comm(); }));
+
+    // packing and unpacking of per-atom data by the atom style. unpacking is done
+    // in place for forward and border communication, which leaves the data unchanged.
+
+    AtomVec *avec = atom->avec;
+    std::vector<int> list(nlocal);
+    std::iota(list.begin(), list.end(), 0);
+    std::vector<double> buf((size_t)nlocal * std::max(avec->size_forward, avec->size_border) +
+                            BUFEXTRA);
+    int pbc[6] = {0, 0, 0, 0, 0, 0};
+    const std::string prefix = std::string("atomvec ") + atom->atom_style;
+
+    name = prefix + " pack/unpack comm";
+    if (selected(name))
+        results.push_back(measure(name, natoms, "atom", opts, [&] {
+            avec->pack_comm(nlocal, list.data(), buf.data(), 0, pbc);
+            avec->unpack_comm(nlocal, 0, buf.data());
+        }));
+
+    name = prefix + " pack/unpack border";
+    if (selected(name))
+        results.push_back(measure(name, natoms, "atom", opts, [&] {
+            avec->pack_border(nlocal, list.data(), buf.data(), 0, pbc);
+            avec->unpack_border(nlocal, 0, buf.data());
+        }));
+
+    // exchanged atoms are unpacked into the ghost atom slots and then
+    // dropped again, so this must be the last benchmark
+
+    name = prefix + " pack/unpack exchange";
+    if (selected(name)) {
+        std::vector<double> exbuf;
+        results.push_back(measure(name, natoms, "atom", opts, [&] {
+            std::size_t m = 0;
+            for (int i = 0; i < nlocal; ++i) {
+                if (exbuf.size() < m + avec->maxexchange + BUFEXTRA)
+                    exbuf.resize(2 * (m + avec->maxexchange + BUFEXTRA));
+                m += avec->pack_exchange(i, exbuf.data() + m);
+            }
+            m = 0;
+            for (int i = 0; i < nlocal; ++i)
+                m += avec->unpack_exchange(exbuf.data() + m);
+            atom->nlocal = nlocal;
+        }));
+    }
+    return results;
+}
+
+static void usage(std::ostream &out, const char *name)
+{
+    out << "usage: " << name << " <testfile.yaml> [OPTIONS] [-- LAMMPS flags]\n\n"
+        << "Available options:\n"
+        << "  -a <natoms>         replicate system to at least this many atoms (default: 8000)\n"
+        << "  -s <factor>         scale box length by factor to change the density\n"
+        << "  -n <samples>        number of timing samples (default: 5)\n"
+        << "  -t <seconds>        minimum time per sample (default: 0.05)\n"
+        << "  -k <text>           only run kernels with names containing text\n"
+        << "  -d <folder>         set folder where to find input files\n"
+        << "  -v                  show LAMMPS output\n"
+        << "  -h                  print this message\n"
+        << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    int me;
+    MPI_Comm_rank(MPI_COMM_WORLD, &me);
+
+    if (argc < 2) {
+        if (me == 0) usage(std::cerr, argv[0]);
+        MPI_Finalize();
+        return 1;
+    }
+
+    TestConfig config;
+    auto reader = TestConfigReader(config);
+    if (reader.parse_file(argv[1])) {
+        if (me == 0) std::cerr << "Error parsing yaml file: " << argv[1] << std::endl;
+        MPI_Finalize();
+        return 2;
+    }
+    config.basename = reader.get_basename();
+
+    BenchOptions opts;
+    LAMMPS::argv args = {"BenchForceStyle", "-log", "none", "-echo", "none", "-nocite"};
+    int iarg          = 2;
+    while (iarg < argc) {
+        if (strcmp(argv[iarg], "--") == 0) {
+            for (++iarg; iarg < argc; ++iarg)
+                args.push_back(argv[iarg]);
+        } else if ((strcmp(argv[iarg], "-v") == 0) || (strcmp(argv[iarg], "-h") == 0)) {
+            if (argv[iarg][1] == 'h') {
+                if (me == 0) usage(std::cout, argv[0]);
+                MPI_Finalize();
+                return 0;
+            }
+            opts.verbose = true;
+            ++iarg;
+        } else if ((argv[iarg][0] == '-') && (strchr("asntkd", argv[iarg][1]) != nullptr) &&
+                   (argv[iarg][2] == '\0') && (iarg + 1 < argc)) {
+            const char *value = argv[iarg + 1];
+            switch (argv[iarg][1]) {
+                case 'a':
+                    opts.natoms = std::atoll(value);
+                    break;
+                case 's':
+                    opts.scale = std::atof(value);
+                    break;
+                case 'n':
+                    opts.nsample = std::max(1, std::atoi(value));
+                    break;
+                case 't':
+                    opts.min_time = std::atof(value);
+                    break;
+                case 'k':
+                    opts.only = value;
+                    break;
+                case 'd':
+                    INPUT_FOLDER = value;
+                    break;
+            }
+            iarg += 2;
+        } else {
+            if (me == 0) {
+                std::cerr << "unknown option: " << argv[iarg] << "\n\n";
+                usage(std::cerr, argv[0]);
+            }
+            MPI_Finalize();
+            return 1;
+        }
+    }
+    if (!opts.verbose) {
+        args.push_back("-screen");
+        args.push_back("none");
+    }
+
+    int rv = 0;
+    try {
+        LAMMPS *lmp = init_lammps(args, config, opts);
+        if (!lmp) {
+            if (me == 0)
+                fmt::print("Skipping {}: prerequisite styles are not available\n",
+                           config.basename);
+        } else {
+            auto results = run_benchmarks(lmp, opts);
+            if (me == 0) {
+                fmt::print("Microbenchmarks for {}: {} atoms on {} MPI task(s), {} samples\n",
+                           config.basename, lmp->atom->natoms, lmp->comm->nprocs, opts.nsample);
+                fmt::print("{:<40} {:>8} {:>12} {:>12} {:>12} {:>12}  {}\n", "Kernel", "Calls",
+                           "Best(us)", "Avg(us)", "Items", "ns/item", "Item");
+                for (const auto &r : results) {
+                    // cost per item is the CPU time across all MPI ranks
+                    const double cost =
+                        r.items ? 1.0e9 * r.best * lmp->comm->nprocs / (double)r.items : 0.0;
+                    fmt::print("{:<40} {:>8} {:>12.3f} {:>12.3f} {:>12} {:>12.4g}  {}\n", r.name,
+                               r.calls, 1.0e6 * r.best, 1.0e6 * r.avg, r.items, cost, r.unit);
+                }
+            }
+            delete lmp;
+        }
+    } catch (LAMMPSException &e) {
+        if (me == 0) std::cerr << "LAMMPS Error: " << e.what() << std::endl;
+        rv = 3;
+    }
+    MPI_Finalize();
+    return rv;
+}
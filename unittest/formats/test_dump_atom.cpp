@@ -16,6 +16,7 @@
 #include "../testing/utils.h"
 #include "fmt/format.h"
 #include "output.h"
+#include "platform.h"
 #include "thermo.h"
 #include "utils.h"
 #include "gmock/gmock.h"
@@ -521,6 +522,101 @@ TEST_F(DumpAtomTest, run2)
     delete_file(dump_file);
 }
 
+TEST_F(DumpAtomTest, async_run2)
+{
+    auto dump_file = dump_filename("async_run2");
+    auto ref_file  = dump_filename("sync_run2");
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id0 all atom 1 {}", ref_file));
+    command(fmt::format("dump id all atom 1 {}", dump_file));
+    command("dump_modify id async yes");
+    command("run 2 post no");
+    END_HIDE_OUTPUT();
+    close_dump();
+
+    ASSERT_FILE_EXISTS(dump_file);
+    ASSERT_EQ(count_lines(dump_file), 123);
+    auto lines = read_lines(dump_file);
+    auto ref   = read_lines(ref_file);
+    ASSERT_EQ(lines.size(), ref.size());
+    for (std::size_t i = 0; i < lines.size(); ++i)
+        ASSERT_THAT(lines[i], Eq(ref[i]));
+    delete_file(dump_file);
+    delete_file(ref_file);
+}
+
+TEST_F(DumpAtomTest, async_multi_file_run1)
+{
+    auto dump_file = dump_filename("async_run1_*");
+    generate_dump(dump_file, "async yes buffer no", 1);
+    close_dump();
+
+    auto run1_0 = dump_filename("async_run1_0");
+    auto run1_1 = dump_filename("async_run1_1");
+    ASSERT_FILE_EXISTS(run1_0);
+    ASSERT_FILE_EXISTS(run1_1);
+    ASSERT_EQ(count_lines(run1_0), 41);
+    ASSERT_EQ(count_lines(run1_1), 41);
+    delete_file(run1_0);
+    delete_file(run1_1);
+}
+
+TEST_F(DumpAtomTest, async_run_end)
+{
+    // the last snapshot must be complete when the run ends, before the dump is deleted
+    auto dump_file = dump_filename("async_end_*");
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id all atom 1 {}", dump_file));
+    command("dump_modify id async yes");
+    command("run 1 post no");
+    END_HIDE_OUTPUT();
+
+    auto end_1 = dump_filename("async_end_1");
+    ASSERT_FILE_EXISTS(end_1);
+    ASSERT_EQ(count_lines(end_1), 41);
+    close_dump();
+    delete_file(dump_filename("async_end_0"));
+    delete_file(end_1);
+}
+
+TEST_F(DumpAtomTest, mpiio_run1)
+{
+    if (platform::mpi_vendor() == "MPI STUBS") GTEST_SKIP();
+    auto dump_file = dump_filename("mpiio_run1");
+    generate_dump(dump_file, "mpiio yes", 1);
+
+    ASSERT_FILE_EXISTS(dump_file);
+    auto lines = read_lines(dump_file);
+    ASSERT_EQ(lines.size(), 82);
+    ASSERT_THAT(lines[0], Eq("ITEM: TIMESTEP"));
+    ASSERT_THAT(lines[41], Eq("ITEM: TIMESTEP"));
+    ASSERT_EQ(utils::split_words(lines[9]).size(), 5);
+    ASSERT_EQ(utils::split_words(lines[81]).size(), 5);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpAtomTest, mpiio_binary_run1)
+{
+    if (!BINARY2TXT_EXECUTABLE) GTEST_SKIP();
+    if (platform::mpi_vendor() == "MPI STUBS") GTEST_SKIP();
+
+    auto text_file   = text_dump_filename("mpiio_run1");
+    auto binary_file = binary_dump_filename("mpiio_run1");
+
+    generate_text_and_binary_dump(text_file, binary_file, "mpiio yes", 1);
+
+    ASSERT_FILE_EXISTS(text_file);
+    ASSERT_FILE_EXISTS(binary_file);
+
+    auto converted_file = convert_binary_to_text(binary_file);
+
+    ASSERT_FILE_EXISTS(converted_file);
+    ASSERT_FILE_EQUAL(text_file, converted_file);
+    delete_file(text_file);
+    delete_file(binary_file);
+    delete_file(converted_file);
+}
+
 TEST_F(DumpAtomTest, rerun)
 {
     auto dump_file = dump_filename("rerun");
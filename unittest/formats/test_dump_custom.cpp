@@ -17,11 +17,13 @@
 #include "fmt/format.h"
 #include "output.h"
 #include "thermo.h"
+#include "update.h"
 #include "utils.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 using ::testing::Eq;
+using ::testing::StartsWith;
 
 char *BINARY2TXT_EXECUTABLE = nullptr;
 bool verbose                = false;
@@ -384,6 +386,151 @@ TEST_F(DumpCustomTest, rerun_bin)
     ASSERT_NEAR(pe_2, pe_rerun, 1.0e-14);
     delete_file(dump_file);
 }
+
+TEST_F(DumpCustomTest, rerun_index)
+{
+    auto dump_file = dump_filename("rerun_index");
+    auto bin_file  = binary_dump_filename("rerun_index");
+    auto fields    = "id type x y z";
+
+    HIDE_OUTPUT([&] {
+        command("fix 1 all nve");
+        command(fmt::format("dump bin all custom 1 {} {}", bin_file, fields));
+    });
+    generate_dump(dump_file, fields, "format float %20.15g", 1);
+    continue_dump(1);
+    close_dump();
+    HIDE_OUTPUT([&] {
+        command("undump bin");
+    });
+    double pe_2, pe_rerun;
+    lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+
+    for (const auto &file : {dump_file, bin_file}) {
+
+        // first pass builds and caches the index, second pass reads it from cache
+
+        for (int i = 0; i < 2; ++i) {
+            HIDE_OUTPUT([&] {
+                command(fmt::format("rerun {} first 2 last 2 post no dump x y z index yes", file));
+            });
+            ASSERT_FILE_EXISTS(file + ".index");
+            lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+            ASSERT_NEAR(pe_2, pe_rerun, 1.0e-14);
+        }
+
+        // read all frames with index
+
+        HIDE_OUTPUT([&] {
+            command(fmt::format("rerun {} post no dump x y z index yes", file));
+        });
+        lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+        ASSERT_NEAR(pe_2, pe_rerun, 1.0e-14);
+        ASSERT_EQ(lmp->update->ntimestep, 2);
+
+        // a cached index with a different mtime must be ignored and rebuilt
+
+        auto lines = read_lines(file + ".index");
+        ASSERT_EQ(lines.size(), 4);
+        auto words = utils::split_words(lines[0]);
+        ASSERT_EQ(words.size(), 12);
+        FILE *fp = fopen((file + ".index").c_str(), "w");
+        fmt::print(fp, "{} mtime {}\n", utils::join_words({words.begin(), words.end() - 2}, " "),
+                   std::stoll(words[11]) - 10);
+        for (int i = 1; i < 4; ++i)
+            fmt::print(fp, "{} {}\n", i + 100, utils::split_words(lines[i])[1]);
+        fclose(fp);
+        HIDE_OUTPUT([&] {
+            command(fmt::format("rerun {} first 2 last 2 post no dump x y z index yes", file));
+        });
+        lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+        ASSERT_NEAR(pe_2, pe_rerun, 1.0e-14);
+        ASSERT_EQ(lmp->update->ntimestep, 2);
+        lines = read_lines(file + ".index");
+        ASSERT_THAT(lines[3], StartsWith("2 "));
+
+        delete_file(file);
+        delete_file(file + ".index");
+    }
+}
+
+TEST_F(DumpCustomTest, rerun_quant)
+{
+    if (!info->has_style("dump", "custom/quant")) GTEST_SKIP();
+
+    auto dump_file  = dump_filename("rerun_quant");
+    auto quant_file = std::string("dump_custom_rerun_quant.quant");
+    auto fields     = "id type x y z";
+
+    HIDE_OUTPUT([&] {
+        command("fix 1 all nve");
+        command(fmt::format("dump quant all custom/quant 1 {} {}", quant_file, fields));
+        command("dump_modify quant tolerance 1.0e-6");
+    });
+    generate_dump(dump_file, fields, "format float %20.15g", 1);
+    continue_dump(1);
+    close_dump();
+    HIDE_OUTPUT([&] {
+        command("undump quant");
+    });
+    double pe_2, pe_rerun;
+    lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+
+    ASSERT_FILE_EXISTS(quant_file);
+
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 2 last 2 post no dump x y z format quant", quant_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe_2, pe_rerun, 1.0e-3 * fabs(pe_2));
+    ASSERT_EQ(lmp->update->ntimestep, 2);
+
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} post no dump x y z index yes format quant", quant_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe_2, pe_rerun, 1.0e-3 * fabs(pe_2));
+    ASSERT_EQ(lmp->update->ntimestep, 2);
+    delete_file(dump_file);
+    delete_file(quant_file);
+    delete_file(quant_file + ".index");
+}
+
+TEST_F(DumpCustomTest, no_header_quant)
+{
+    if (!info->has_style("dump", "custom/quant")) GTEST_SKIP();
+
+    auto dump_file  = dump_filename("no_header_quant");
+    auto quant_file = std::string("dump_custom_no_header_quant.quant");
+    auto fields     = "id type x y z";
+
+    // snapshots keep their header, so the file can still be read back
+
+    HIDE_OUTPUT([&] {
+        command("fix 1 all nve");
+        command(fmt::format("dump quant all custom/quant 1 {} {}", quant_file, fields));
+        command("dump_modify quant header no tolerance 1.0e-6");
+    });
+    generate_dump(dump_file, fields, "format float %20.15g", 1);
+    continue_dump(1);
+    close_dump();
+    HIDE_OUTPUT([&] {
+        command("undump quant");
+    });
+    double pe_2, pe_rerun;
+    lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+
+    ASSERT_FILE_EXISTS(quant_file);
+
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 2 last 2 post no dump x y z format quant", quant_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe_2, pe_rerun, 1.0e-3 * fabs(pe_2));
+    ASSERT_EQ(lmp->update->ntimestep, 2);
+    delete_file(dump_file);
+    delete_file(quant_file);
+}
 } // namespace LAMMPS_NS
 int main(int argc, char **argv)
 {
@@ -14,6 +14,7 @@
 #include "../testing/core.h"
 #include "../testing/utils.h"
 #include "atom.h"
+#include "comm.h"
 #include "domain.h"
 #include "error.h"
 #include "info.h"
@@ -23,12 +24,16 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <mpi.h>
 #include <string>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
+using testing::HasSubstr;
+using testing::Not;
 using testing::StrEq;
 
 using utils::read_lines_from_file;
@@ -390,6 +395,80 @@ TEST_F(FileOperationsTest, write_restart)
     delete_file("triclinic.restart");
 }
 
+TEST_F(FileOperationsTest, restart_delta)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("echo none");
+    command("atom_modify map array");
+    command("region box block -2 2 -2 2 -2 2");
+    command("create_box 1 box");
+    command("create_atoms 1 single 0.5 0.0 0.0");
+    command("create_atoms 1 single 0.0 0.5 -1.5");
+    command("create_atoms 1 single 1.0 1.0 1.0");
+    command("mass 1 1.0");
+    command("pair_style zero 1.0");
+    command("pair_coeff * *");
+    command("velocity all create 1.0 4928459 dist gaussian");
+    command("group move id 2");
+    command("fix 1 move nve");
+    command("restart 1 delta*.restart delta 2");
+    command("run 3 post no");
+    command("restart 0");
+    END_HIDE_OUTPUT();
+    ASSERT_FILE_EXISTS("delta1.restart");
+    ASSERT_FILE_EXISTS("delta2.restart");
+    ASSERT_FILE_EXISTS("delta3.restart");
+
+    double x[3][3], v[3][3];
+    for (int i = 0; i < 3; ++i) {
+        int idx = lmp->atom->map(i + 1);
+        for (int j = 0; j < 3; ++j) {
+            x[i][j] = lmp->atom->x[idx][j];
+            v[i][j] = lmp->atom->v[idx][j];
+        }
+    }
+
+    // full restart files keep the regular format revision
+
+    BEGIN_CAPTURE_OUTPUT();
+    command("clear");
+    command("read_restart delta1.restart");
+    auto text = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(text, Not(HasSubstr("Old restart file format revision")));
+
+    // values must be restored exactly from base and delta file
+
+    BEGIN_CAPTURE_OUTPUT();
+    command("clear");
+    command("atom_modify map array");
+    command("read_restart delta3.restart");
+    text = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(text, Not(HasSubstr("Old restart file format revision")));
+    ASSERT_EQ(lmp->atom->natoms, 3);
+    ASSERT_EQ(lmp->update->ntimestep, 3);
+    for (int i = 0; i < 3; ++i) {
+        int idx = lmp->atom->map(i + 1);
+        ASSERT_GE(idx, 0);
+        for (int j = 0; j < 3; ++j) {
+            EXPECT_EQ(lmp->atom->x[idx][j], x[i][j]);
+            EXPECT_EQ(lmp->atom->v[idx][j], v[i][j]);
+        }
+    }
+
+    TEST_FAILURE(".*ERROR: Write_restart delta keyword is only supported by the restart command.*",
+                 command("write_restart test.restart delta 2"););
+    TEST_FAILURE(".*ERROR: Invalid restart delta value -1.*",
+                 command("restart 1 test.restart delta -1"););
+    TEST_FAILURE(".*ERROR: Cannot use restart delta with % in restart file name.*",
+                 command("restart 1 test-%.restart delta 1"););
+    TEST_FAILURE(".*ERROR: Restart file name must contain '\\*' with restart delta.*",
+                 command("restart 1 test.restart delta 1"););
+
+    delete_file("delta1.restart");
+    delete_file("delta2.restart");
+    delete_file("delta3.restart");
+}
+
 TEST_F(FileOperationsTest, write_data)
 {
     BEGIN_HIDE_OUTPUT();
@@ -489,6 +568,199 @@ TEST_F(FileOperationsTest, write_data)
     delete_file("triclinic.data");
 }
 
+TEST_F(FileOperationsTest, write_data_binary)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("echo none");
+    command("atom_modify map array");
+    command("region box block -2 2 -2 2 -2 2");
+    command("create_box 2 box");
+    command("create_atoms 1 single 0.5 0.0 0.0");
+    command("create_atoms 2 single 0.0 0.5 -1.5");
+    command("create_atoms 1 single 1.0 1.0 1.0");
+    command("pair_style zero 1.0");
+    command("pair_coeff * *");
+    command("mass * 1.0");
+    command("velocity all create 1.0 4928459 dist gaussian");
+    command("set atom 3 image 1 -1 2");
+    command("write_data binary.data binary yes");
+    END_HIDE_OUTPUT();
+    ASSERT_FILE_EXISTS("binary.data");
+
+    double x[3][3], v[3][3];
+    imageint image[3];
+    int type[3];
+    for (int i = 0; i < 3; ++i) {
+        int idx = lmp->atom->map(i + 1);
+        for (int j = 0; j < 3; ++j) {
+            x[i][j] = lmp->atom->x[idx][j];
+            v[i][j] = lmp->atom->v[idx][j];
+        }
+        image[i] = lmp->atom->image[idx];
+        type[i]  = lmp->atom->type[idx];
+    }
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("atom_modify map array");
+    command("pair_style zero 1.0");
+    command("read_data binary.data extra/atom/types 2");
+    command("read_data binary.data add append offset 2 0 0 0 0");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 6);
+    ASSERT_EQ(lmp->atom->ntypes, 4);
+
+    // values must be restored exactly, second copy has offset types and IDs
+
+    for (int i = 0; i < 6; ++i) {
+        int idx = lmp->atom->map(i + 1);
+        ASSERT_GE(idx, 0);
+        for (int j = 0; j < 3; ++j) {
+            EXPECT_EQ(lmp->atom->x[idx][j], x[i % 3][j]);
+            EXPECT_EQ(lmp->atom->v[idx][j], v[i % 3][j]);
+        }
+        EXPECT_EQ(lmp->atom->image[idx], image[i % 3]);
+        EXPECT_EQ(lmp->atom->type[idx], type[i % 3] + ((i < 3) ? 0 : 2));
+    }
+
+    // binary and text output of the same system must be identical
+
+    BEGIN_HIDE_OUTPUT();
+    command("write_data text.data");
+    command("write_data binary.data binary yes");
+    command("clear");
+    command("pair_style zero 1.0");
+    command("read_data binary.data");
+    command("write_data text2.data");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 6);
+    auto text1 = read_lines("text.data");
+    auto text2 = read_lines("text2.data");
+    ASSERT_EQ(text1.size(), text2.size());
+    for (std::size_t i = 1; i < text1.size(); ++i)
+        EXPECT_THAT(text1[i], StrEq(text2[i]));
+
+    TEST_FAILURE(".*ERROR: Illegal write_data binary command: missing argument.*",
+                 command("write_data test.data binary"););
+
+    delete_file("binary.data");
+    delete_file("text.data");
+    delete_file("text2.data");
+}
+
+TEST_F(FileOperationsTest, read_data_parallel)
+{
+    // use enough atoms so that the Atoms and Velocities sections span several chunks
+
+    constexpr int NATOMS = 2500;
+
+    BEGIN_HIDE_OUTPUT();
+    command("echo none");
+    command("atom_modify map array");
+    command("region box block -5 5 -5 5 -5 5");
+    command("create_box 2 box");
+    command("create_atoms 1 random 1500 8364 NULL");
+    command("create_atoms 2 random 1000 2953 NULL");
+    command("pair_style zero 1.0");
+    command("pair_coeff * *");
+    command("mass * 1.0");
+    command("velocity all create 1.0 4928459 dist gaussian");
+    command("set atom 3 image 1 -1 2");
+    command("set atom 1000*1200 image -3 0 1");
+    command("set atom 2400 image 0 5 -4");
+    command("write_data parallel.data");
+    command("write_data parallel_bin.data binary yes");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, NATOMS);
+
+    // data read with the serial path is the reference.
+    // the owner of an atom only depends on its position, so in a parallel
+    // run each proc compares the atoms it owns after both reads.
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("atom_modify map array");
+    command("pair_style zero 1.0");
+    command("read_data parallel.data");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, NATOMS);
+
+    const int nlocal = lmp->atom->nlocal;
+    std::vector<double> x(3 * (NATOMS + 1)), v(3 * (NATOMS + 1));
+    std::vector<imageint> image(NATOMS + 1);
+    std::vector<int> type(NATOMS + 1, 0);
+    for (int i = 0; i < nlocal; ++i) {
+        tagint tag = lmp->atom->tag[i];
+        for (int j = 0; j < 3; ++j) {
+            x[3 * tag + j] = lmp->atom->x[i][j];
+            v[3 * tag + j] = lmp->atom->v[i][j];
+        }
+        image[tag] = lmp->atom->image[i];
+        type[tag]  = lmp->atom->type[i];
+    }
+    if (lmp->atom->map(3) >= 0) {
+        EXPECT_EQ(image[3], ((imageint)(IMGMAX + 2) << IMG2BITS) |
+                      ((imageint)(IMGMAX - 1) << IMGBITS) | (IMGMAX + 1));
+    }
+    if (lmp->atom->map(2400) >= 0) {
+        EXPECT_EQ(image[2400], ((imageint)(IMGMAX - 4) << IMG2BITS) |
+                      ((imageint)(IMGMAX + 5) << IMGBITS) | IMGMAX);
+    }
+
+    // the parallel path must reproduce all per-atom data exactly
+
+    for (const auto &file : {"parallel.data", "parallel_bin.data"}) {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        command("atom_modify map array");
+        command("pair_style zero 1.0");
+        command(std::string("read_data ") + file + " parallel yes");
+        END_HIDE_OUTPUT();
+        ASSERT_EQ(lmp->atom->natoms, NATOMS);
+        ASSERT_EQ(lmp->atom->nlocal, nlocal);
+
+        for (int i = 0; i < nlocal; ++i) {
+            tagint tag = lmp->atom->tag[i];
+            ASSERT_NE(type[tag], 0);
+            for (int j = 0; j < 3; ++j) {
+                EXPECT_EQ(lmp->atom->x[i][j], x[3 * tag + j]);
+                EXPECT_EQ(lmp->atom->v[i][j], v[3 * tag + j]);
+            }
+            EXPECT_EQ(lmp->atom->image[i], image[tag]);
+            EXPECT_EQ(lmp->atom->type[i], type[tag]);
+        }
+    }
+
+    // data files written after reading with either path must contain the same lines
+
+    BEGIN_HIDE_OUTPUT();
+    command("write_data parallel2.data");
+    command("clear");
+    command("pair_style zero 1.0");
+    command("read_data parallel.data parallel no");
+    command("write_data parallel1.data");
+    END_HIDE_OUTPUT();
+    if (lmp->comm->me == 0) {
+        auto text1 = read_lines("parallel1.data");
+        auto text2 = read_lines("parallel2.data");
+        ASSERT_EQ(text1.size(), text2.size());
+        std::sort(text1.begin() + 1, text1.end());
+        std::sort(text2.begin() + 1, text2.end());
+        for (std::size_t i = 1; i < text1.size(); ++i)
+            EXPECT_THAT(text1[i], StrEq(text2[i]));
+    }
+
+    TEST_FAILURE(".*ERROR: Illegal read_data parallel command: missing argument.*",
+                 command("read_data parallel.data parallel"););
+    TEST_FAILURE(".*ERROR: Cannot use read_data parallel yes together with the add keyword.*",
+                 command("read_data parallel.data add append parallel yes"););
+
+    delete_file("parallel.data");
+    delete_file("parallel_bin.data");
+    delete_file("parallel1.data");
+    delete_file("parallel2.data");
+}
+
 #define GETIDX(i) lmp->atom->map(i)
 TEST_F(FileOperationsTest, read_data_fix)
 {